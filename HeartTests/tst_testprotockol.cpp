@@ -13,6 +13,25 @@
 #include <bigdatatest.h>
 #include <upgradedatabasetest.h>
 #include <multiversiontest.h>
+#include <hostaddresstest.h>
+#include <dnsresolvertest.h>
+#include <sslresumptiontest.h>
+#include <packagemanagertest.h>
+#include <packedrowstest.h>
+#include <dbprofiletest.h>
+#include <asyncdbtest.h>
+#include <commandhashtest.h>
+#include <bulkinserttest.h>
+#include <dirtyfieldstest.h>
+#include <idallocatortest.h>
+#include <residenttabletest.h>
+#include <keyvaluestoretest.h>
+#include <sqlstatisticstest.h>
+#include <universaldatatest.h>
+#include <asyncrenderlooptest.h>
+#include <sqlscripttest.h>
+#include <admissioncontrollertest.h>
+#include <confirmtimeoutstest.h>
 
 #define TestCase(name, testClass) \
     void name() { \
@@ -36,6 +55,25 @@ private slots:
 
     TestCase(upgradeDataBaseTest, UpgradeDataBaseTest)
     TestCase(multiVersionTest, MultiVersionTest)
+    TestCase(hostAddressTest, HostAddressTest)
+    TestCase(dnsResolverTest, DnsResolverTest)
+    TestCase(sslResumptionTest, SslResumptionTest)
+    TestCase(packageManagerTest, PackageManagerTest)
+    TestCase(packedRowsTest, PackedRowsTest)
+    TestCase(dbProfileTest, DbProfileTest)
+    TestCase(asyncDbTest, AsyncDbTest)
+    TestCase(commandHashTest, CommandHashTest)
+    TestCase(bulkInsertTest, BulkInsertTest)
+    TestCase(dirtyFieldsTest, DirtyFieldsTest)
+    TestCase(idAllocatorTest, IdAllocatorTest)
+    TestCase(residentTableTest, ResidentTableTest)
+    TestCase(keyValueStoreTest, KeyValueStoreTest)
+    TestCase(sqlStatisticsTest, SqlStatisticsTest)
+    TestCase(universalDataTest, UniversalDataTest)
+    TestCase(asyncRenderLoopTest, AsyncRenderLoopTest)
+    TestCase(sqlScriptTest, SqlScriptTest)
+    TestCase(admissionControllerTest, AdmissionControllerTest)
+    TestCase(confirmTimeoutsTest, ConfirmTimeoutsTest)
 
 
     // END TEST CASES
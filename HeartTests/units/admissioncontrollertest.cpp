@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "admissioncontrollertest.h"
+
+#include <admissioncontroller.h>
+#include <hostaddress.h>
+
+using Decision = QH::AdmissionDecision;
+
+AdmissionControllerTest::AdmissionControllerTest() {
+
+}
+
+AdmissionControllerTest::~AdmissionControllerTest() {
+
+}
+
+void AdmissionControllerTest::test() {
+    QH::AdmissionController controller;
+    controller.setGlobalRate(0, 0);
+    controller.setIpRate(2, 3);
+    controller.setMaxBacklog(2);
+
+    const QHostAddress peer("10.0.0.1");
+    const QHostAddress other("10.0.0.2");
+    const qint64 start = 1000000;
+
+    // the burst is accepted at once.
+    for (int i = 0; i < 3; ++i) {
+        QVERIFY(controller.admit(peer, 0, start) == Decision::Accept);
+    }
+    QVERIFY(controller.admit(peer, 0, start) == Decision::RateLimited);
+
+    // each ip address has own bucket.
+    QVERIFY(controller.admit(other, 0, start) == Decision::Accept);
+
+    // 2 tokens per second.
+    QVERIFY(controller.admit(peer, 0, start + 1000) == Decision::Accept);
+    QVERIFY(controller.admit(peer, 0, start + 1000) == Decision::Accept);
+    QVERIFY(controller.admit(peer, 0, start + 1000) == Decision::RateLimited);
+
+    // the local host is not limited by the ip bucket.
+    for (int i = 0; i < 10; ++i) {
+        QVERIFY(controller.admit(QHostAddress(QHostAddress::LocalHost), 0, start) == Decision::Accept);
+    }
+
+    // the global bucket limits all addresses.
+    controller.setGlobalRate(1, 1);
+    QVERIFY(controller.admit(QHostAddress("10.0.0.3"), 0, start + 5000) == Decision::Accept);
+    QVERIFY(controller.admit(QHostAddress("10.0.0.4"), 0, start + 5000) == Decision::RateLimited);
+    QVERIFY(controller.admit(QHostAddress("10.0.0.4"), 0, start + 6000) == Decision::Accept);
+
+    // too many not confirmed connections.
+    QVERIFY(controller.admit(other, 2, start + 10000) == Decision::Overloaded);
+
+    // bans work by ip address.
+    const QHostAddress banned("10.0.0.5");
+    controller.banIp(QH::HostAddress(banned, 1234));
+    QVERIFY(controller.isBannedIp(banned));
+    QVERIFY(controller.admit(banned, 0, start + 20000) == Decision::Banned);
+
+    controller.unBanIp(banned);
+    QVERIFY(!controller.isBannedIp(banned));
+    QVERIFY(controller.admit(banned, 0, start + 20000) == Decision::Accept);
+
+    QVERIFY(controller.rejectedCount() == 5);
+
+    // the ip token is not taken if the connection is rejected by the global bucket.
+    QH::AdmissionController limited;
+    limited.setIpRate(0.001, 1);
+    limited.setGlobalRate(1, 1);
+
+    QVERIFY(limited.admit(peer, 0, start) == Decision::Accept);
+    QVERIFY(limited.admit(other, 0, start) == Decision::RateLimited);
+    QVERIFY(limited.admit(other, 0, start + 1000) == Decision::Accept);
+
+    // the least recently used ip bucket is removed when the limit of the buckets is reached.
+    QH::AdmissionController lru;
+    lru.setGlobalRate(0, 0);
+    lru.setIpRate(0.001, 1);
+
+    QVERIFY(lru.admit(peer, 0, start) == Decision::Accept);
+    QVERIFY(lru.admit(peer, 0, start) == Decision::RateLimited);
+
+    for (int i = 0; i < ADMISSION_IP_BUCKETS_LIMIT; ++i) {
+        QVERIFY(lru.admit(QHostAddress(static_cast<quint32>(0x0B000000 + i)), 0, start) == Decision::Accept);
+    }
+
+    QVERIFY(lru.admit(peer, 0, start) == Decision::Accept);
+}
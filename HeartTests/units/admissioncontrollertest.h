@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef ADMISSIONCONTROLLERTEST_H
+#define ADMISSIONCONTROLLERTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The AdmissionControllerTest class test the token buckets, bans and backlog limit of the AdmissionController with fixed time.
+ */
+class AdmissionControllerTest: public Test, protected TestUtils
+{
+public:
+    AdmissionControllerTest();
+    ~AdmissionControllerTest();
+    void test();
+};
+
+#endif // ADMISSIONCONTROLLERTEST_H
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "asyncdbtest.h"
+
+#include <asyncsqldbwriter.h>
+#include <config.h>
+#include <dbobjectsrequest.h>
+#include <futures.h>
+#include <qaglobalutils.h>
+#include <sqldb.h>
+#include <QEventLoop>
+#include <QSqlRecord>
+
+using Predicate = QH::PKG::DBPredicate;
+
+class AsyncItem: public QH::PKG::DBObject {
+    QH_PACKAGE("AsyncItem")
+
+public:
+    AsyncItem(int id = 0, int value = 0): _id(id), _value(value) {}
+
+    QH::PKG::DBObject *createDBObject() const override {
+        return create<AsyncItem>();
+    }
+
+    bool fromSqlRecord(const QSqlRecord &q) override {
+        _id = q.value("id").toInt();
+        _value = q.value("value").toInt();
+        return true;
+    }
+
+    QString table() const override {
+        return "AsyncItems";
+    }
+
+    QString primaryKey() const override {
+        return "id";
+    }
+
+    QVariant primaryValue() const override {
+        return _id;
+    }
+
+    QH::PKG::DBVariantMap variantMap() const override {
+        return {{"id",      {_id,       QH::PKG::MemberType::PrimaryKey}},
+                {"value",   {_value,    QH::PKG::MemberType::InsertUpdate}}};
+    }
+
+    int value() const {
+        return _value;
+    }
+
+    void setValue(int value) {
+        setField(_value, value, "value");
+    }
+
+private:
+    int _id = 0;
+    int _value = 0;
+};
+
+// returns objects of the DBObjectsRequest that returned by the getAllObjectsAsync method.
+static QList<QSharedPointer<AsyncItem>> items(const QList<QSharedPointer<QH::PKG::DBObject>>& result) {
+    if (result.size() != 1) {
+        return {};
+    }
+
+    auto request = result.first().dynamicCast<QH::PKG::DBObjectsRequest<AsyncItem>>();
+    if (!request) {
+        return {};
+    }
+
+    return request->data();
+}
+
+AsyncDbTest::AsyncDbTest() {
+
+}
+
+AsyncDbTest::~AsyncDbTest() {
+
+}
+
+void AsyncDbTest::test() {
+    {
+        QH::AsyncSqlDBWriter writer;
+        QVERIFY(initTestDb(writer, "AsyncDbTest"));
+
+        auto create = writer.doQueryAsync("CREATE TABLE IF NOT EXISTS AsyncData (id INTEGER PRIMARY KEY, value INT)");
+        create.waitForFinished();
+        QVERIFY(!create.isCanceled());
+
+        // run several queries concurrently and resume when all of them finished.
+        QList<QFuture<void>> inserts;
+        for (int i = 0; i < 3; ++i) {
+            inserts.push_back(writer.doQueryAsync("INSERT INTO AsyncData (value) VALUES (:value)", {{":value", i}}));
+        }
+
+        QEventLoop loop;
+        bool allFinished = false;
+        QH::Futures::whenAll(inserts, &loop, [&allFinished, &loop]() {
+            allFinished = true;
+            loop.quit();
+        });
+
+        QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+        loop.exec();
+        QVERIFY(allFinished);
+
+        auto count = writer.doQueryAsync("SELECT COUNT(*) FROM AsyncData");
+        count.waitForFinished();
+        QVERIFY(!count.isCanceled());
+        QVERIFY(count.result().size() == 1);
+        QVERIFY(count.result().first().value(0).toInt() == 3);
+
+        // broken query cancels the future.
+        auto broken = writer.doQueryAsync("SELECT * FROM NotExistsTable");
+        broken.waitForFinished();
+        QVERIFY(broken.isCanceled());
+    }
+
+    removeTestDb("AsyncDbTest");
+
+    testSqlDB();
+}
+
+void AsyncDbTest::testSqlDB() {
+    {
+        QH::AsyncSqlDBWriter writer;
+        QVERIFY(initTestDb(writer, "AsyncSqlDBTest"));
+        QVERIFY(writer.doQuery("CREATE TABLE IF NOT EXISTS AsyncItems (id INTEGER PRIMARY KEY, value INT)", {}, true));
+
+        auto db = new QH::SqlDB();
+        db->setWriter(&writer);
+
+        QVERIFY(db->insertObjectAsync(QSharedPointer<AsyncItem>::create(1, 10)).result());
+        QVERIFY(db->insertObjectAsync(QSharedPointer<AsyncItem>::create(2, 20)).result());
+
+        auto all = QSharedPointer<QH::PKG::DBObjectsRequest<AsyncItem>>::create("AsyncItems", Predicate());
+
+        // select from the database on the writer thread.
+        QVERIFY(items(db->getAllObjectsAsync(all).result()).size() == 2);
+
+        auto single = db->getObjectAsync(QSharedPointer<AsyncItem>::create(1)).result().dynamicCast<AsyncItem>();
+        QVERIFY(single && single->value() == 10);
+
+        // resident table answers without the writer thread, so the future is ready immediately.
+        QVERIFY(db->setResident(QSharedPointer<AsyncItem>::create()));
+
+        auto resident = db->getAllObjectsAsync(all);
+        QVERIFY(resident.isFinished());
+        QVERIFY(items(resident.result()).size() == 2);
+
+        // async changes are applied to the database and to the resident table.
+        auto changed = QSharedPointer<AsyncItem>::create(1, 10);
+        changed->setValue(11);
+        QVERIFY(db->updateObjectAsync(changed).result());
+        QVERIFY(db->deleteObjectAsync(QSharedPointer<AsyncItem>::create(2)).result());
+        QVERIFY(db->replaceObjectAsync(QSharedPointer<AsyncItem>::create(3, 30)).result());
+
+        const auto result = items(db->getAllObjectsAsync(all).result());
+        QVERIFY(result.size() == 2);
+        for (const auto& item: result) {
+            QVERIFY(item->value() == 11 || item->value() == 30);
+        }
+
+        auto values = db->doQueryAsync("SELECT value FROM AsyncItems ORDER BY id").result();
+        QVERIFY(values.size() == 2);
+        QVERIFY(values[0].value(0).toInt() == 11);
+        QVERIFY(values[1].value(0).toInt() == 30);
+
+        db->softDelete();
+    }
+
+    removeTestDb("AsyncSqlDBTest");
+}
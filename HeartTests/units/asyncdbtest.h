@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef ASYNCDBTEST_H
+#define ASYNCDBTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The AsyncDbTest class test the non blocking (future based) api of the database writer and the database cache.
+ */
+class AsyncDbTest: public Test, protected TestUtils
+{
+public:
+    AsyncDbTest();
+    ~AsyncDbTest();
+    void test();
+
+private:
+    void testSqlDB();
+};
+
+#endif // ASYNCDBTEST_H
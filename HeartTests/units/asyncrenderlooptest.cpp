@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "asyncrenderlooptest.h"
+
+#include <asyncrenderloop.h>
+#include <QThread>
+#include <atomic>
+
+class CountingRenderLoop: public QH::AsyncRenderLoop {
+public:
+    CountingRenderLoop(bool idle = false): QH::AsyncRenderLoop(new QThread()), _idle(idle) {}
+
+    int iterations() const {
+        return _iterations;
+    }
+
+protected:
+    void renderIteration(int) override {
+        _iterations++;
+
+        if (_idle) {
+            reportNoWork();
+        }
+    }
+
+private:
+    std::atomic_int _iterations{0};
+    bool _idle = false;
+};
+
+AsyncRenderLoopTest::AsyncRenderLoopTest() {
+
+}
+
+AsyncRenderLoopTest::~AsyncRenderLoopTest() {
+
+}
+
+void AsyncRenderLoopTest::test() {
+    testFixedRate();
+    testAdaptive();
+}
+
+void AsyncRenderLoopTest::testFixedRate() {
+    CountingRenderLoop loop;
+    loop.setMode(QH::AsyncRenderLoop::Mode::FixedRate);
+    loop.setInterval(10000);
+
+    QElapsedTimer timer;
+    timer.start();
+    loop.run();
+    QVERIFY(loop.isRun());
+
+    QTest::qWait(1000);
+    loop.stop();
+    const qint64 elapsed = timer.elapsed();
+
+    QVERIFY(!loop.isRun());
+
+    // 100 iterations per second, the loop should not run faster then the interval and should not fall far behind it.
+    const int expected = static_cast<int>(elapsed / 10);
+    QVERIFY(loop.iterations() <= expected + 1);
+    QVERIFY(loop.iterations() >= expected / 2);
+    QVERIFY(loop.statistics().iterations == static_cast<quint64>(loop.iterations()));
+}
+
+void AsyncRenderLoopTest::testAdaptive() {
+    CountingRenderLoop loop(true);
+    loop.setMode(QH::AsyncRenderLoop::Mode::Adaptive);
+    loop.setIdleTimeout(10000);
+    loop.run();
+    QVERIFY(loop.isRun());
+
+    // the idle loop parks until the idle timeout.
+    QTRY_VERIFY_WITH_TIMEOUT(loop.iterations() > 0, 1000);
+    QTest::qWait(100);
+    const int parked = loop.iterations();
+    QTest::qWait(200);
+    QVERIFY(loop.iterations() <= parked + 1);
+
+    // the wake ups are sent without pauses, so some of them are received while the loop works on the iteration
+    // before parking. Each of them should invoke at least one iteration, because the idle timeout is longer then the test.
+    for (int i = 0; i < 100; ++i) {
+        const int iterations = loop.iterations();
+        loop.wakeUp();
+        QTRY_VERIFY_WITH_TIMEOUT(loop.iterations() > iterations, 1000);
+    }
+
+    loop.stop();
+    QVERIFY(!loop.isRun());
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef ASYNCRENDERLOOPTEST_H
+#define ASYNCRENDERLOOPTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The AsyncRenderLoopTest class test the FixedRate mode of the AsyncRenderLoop.
+ */
+class AsyncRenderLoopTest: public Test, protected TestUtils
+{
+public:
+    AsyncRenderLoopTest();
+    ~AsyncRenderLoopTest();
+    void test();
+
+private:
+    void testFixedRate();
+    void testAdaptive();
+};
+
+#endif // ASYNCRENDERLOOPTEST_H
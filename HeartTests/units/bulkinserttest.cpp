@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "bulkinserttest.h"
+
+#include <asyncsqldbwriter.h>
+#include <config.h>
+#include <dbobject.h>
+#include <getmaxintegerid.h>
+#include <qaglobalutils.h>
+#include <QElapsedTimer>
+#include <QSqlQuery>
+#include <QSqlRecord>
+
+#define BULK_TEST_ROWS 10000
+
+class BulkItem: public QH::PKG::DBObject {
+    QH_PACKAGE("BulkItem")
+
+public:
+    BulkItem(int value = 0): _value(value) {}
+
+    QH::PKG::DBObject *createDBObject() const override {
+        return create<BulkItem>();
+    }
+
+    bool fromSqlRecord(const QSqlRecord &q) override {
+        _id = q.value("id").toInt();
+        _value = q.value("value").toInt();
+        return true;
+    }
+
+    QString table() const override {
+        return "BulkItems";
+    }
+
+    QString primaryKey() const override {
+        return "id";
+    }
+
+    QVariant primaryValue() const override {
+        return _id;
+    }
+
+    QH::PKG::DBVariantMap variantMap() const override {
+        return {{"id",      {_id,       QH::PKG::MemberType::PrimaryKeyAutoIncrement}},
+                {"value",   {_value,    QH::PKG::MemberType::InsertUpdate}}};
+    }
+
+    bool isCached() const override {
+        return false;
+    }
+
+    void setValue(int value) {
+        setField(_value, value, "value");
+    }
+
+private:
+    int _id = 0;
+    int _value = 0;
+};
+
+BulkInsertTest::BulkInsertTest() {
+
+}
+
+BulkInsertTest::~BulkInsertTest() {
+
+}
+
+void BulkInsertTest::test() {
+    {
+        QH::AsyncSqlDBWriter writer;
+        QVERIFY(initTestDb(writer, "BulkInsertTest"));
+
+        QVERIFY(writer.doQuery("CREATE TABLE IF NOT EXISTS BulkItems (id INTEGER PRIMARY KEY AUTOINCREMENT, value INT)", {}, true));
+
+        QList<QSharedPointer<QH::PKG::DBObject>> items;
+        for (int i = 0; i < BULK_TEST_ROWS; ++i) {
+            items.push_back(QSharedPointer<BulkItem>::create(i));
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        QVERIFY(writer.insertObjects(items, true));
+        QuasarAppUtils::Params::log(QString("Bulk insert of %0 rows finished in %1 msec").
+                                    arg(BULK_TEST_ROWS).arg(timer.elapsed()),
+                                    QuasarAppUtils::Info);
+
+        QSqlQuery query;
+        QVERIFY(writer.doQuery("SELECT COUNT(*), SUM(value) FROM BulkItems", {}, true, &query));
+        QVERIFY(query.next());
+        QVERIFY(query.value(0).toInt() == BULK_TEST_ROWS);
+        QVERIFY(query.value(1).toLongLong() == qint64(BULK_TEST_ROWS) * (BULK_TEST_ROWS - 1) / 2);
+
+        // ids of the new rows returned in the order of objects.
+        auto ids = QSharedPointer<QList<unsigned int>>::create();
+        QVERIFY(writer.insertObjects({QSharedPointer<BulkItem>::create(-1),
+                                      QSharedPointer<BulkItem>::create(-2)}, true, ids));
+        QVERIFY(ids->size() == 2);
+        QVERIFY(ids->at(0) == BULK_TEST_ROWS + 1);
+        QVERIFY(ids->at(1) == BULK_TEST_ROWS + 2);
+
+        // the changed fields are cleared after saving.
+        auto changed = QSharedPointer<BulkItem>::create();
+        changed->setValue(-3);
+        QVERIFY(changed->dirtyFields() == QSet<QString>{"value"});
+        QVERIFY(writer.insertObjects({changed}, true));
+        QVERIFY(changed->dirtyFields().isEmpty());
+
+        changed->setValue(-4);
+        QVERIFY(writer.doQuery("DELETE FROM BulkItems WHERE value = -3", {}, true));
+
+        // objects of the different types are rejected, no one row is inserted and changed fields stay dirty.
+        QVERIFY(!writer.insertObjects({changed,
+                                       QSharedPointer<QH::PKG::GetMaxIntegerId>::create("BulkItems", "id")}, true));
+        QVERIFY(changed->dirtyFields() == QSet<QString>{"value"});
+        QVERIFY(writer.doQuery("SELECT COUNT(*) FROM BulkItems", {}, true, &query));
+        QVERIFY(query.next());
+        QVERIFY(query.value(0).toInt() == BULK_TEST_ROWS + 2);
+    }
+
+    removeTestDb("BulkInsertTest");
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef BULKINSERTTEST_H
+#define BULKINSERTTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The BulkInsertTest class test the multi-row insert of the database objects.
+ */
+class BulkInsertTest: public Test, protected TestUtils
+{
+public:
+    BulkInsertTest();
+    ~BulkInsertTest();
+    void test();
+};
+
+#endif // BULKINSERTTEST_H
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "commandhashtest.h"
+
+#include <datapack.h>
+#include <ping.h>
+#include <universaldata.h>
+
+class CommandItem: public QH::PKG::UniversalData {
+    QH_PACKAGE("CommandItem")
+};
+
+class DynamicCommandItem: public QH::PKG::UniversalData {
+    QH_PACKAGE_DYNAMIC(QString("Command") + "Item")
+};
+
+static_assert(QH::PKG::uniqueCommands<CommandItem, QH::PKG::Ping, QH::PKG::DataPack<CommandItem>>(),
+              "Commands of the test packages should be unique");
+static_assert(!QH::PKG::uniqueCommands<CommandItem, QH::PKG::Ping, CommandItem>(),
+              "The same commands should be detected");
+
+// the old implementation of the QH_PACKAGE macross.
+static unsigned short runtimeHash(const QString& command) {
+    QByteArray ba = command.toLocal8Bit();
+    return qa_common::hash16(ba.data(), ba.size());
+}
+
+CommandHashTest::CommandHashTest() {
+
+}
+
+CommandHashTest::~CommandHashTest() {
+
+}
+
+void CommandHashTest::test() {
+    constexpr unsigned short itemCommand = CommandItem::command();
+
+    QVERIFY(itemCommand == runtimeHash("CommandItem"));
+    QVERIFY(DynamicCommandItem::command() == itemCommand);
+    QVERIFY(QH::PKG::Ping::command() == runtimeHash("Ping"));
+    QVERIFY(QH::PKG::DataPack<CommandItem>::command() == runtimeHash("CommandItemPack"));
+
+    const QStringList samples = {"", "a", "BigDataPart", "123456789", "Very long command of the package with spaces"};
+    for (const auto& sample: samples) {
+        const QByteArray bytes = sample.toLatin1();
+        QVERIFY(QH::PKG::commandHash(bytes.data(), bytes.size()) == runtimeHash(sample));
+    }
+}
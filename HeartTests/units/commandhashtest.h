@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef COMMANDHASHTEST_H
+#define COMMANDHASHTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The CommandHashTest class test that compile time commands of the packages are same as the runtime commands of the previous versions.
+ */
+class CommandHashTest: public Test, protected TestUtils
+{
+public:
+    CommandHashTest();
+    ~CommandHashTest();
+    void test();
+};
+
+#endif // COMMANDHASHTEST_H
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "confirmtimeoutstest.h"
+
+#include <confirmtimeouts.h>
+#include <hostaddress.h>
+#include <QDateTime>
+
+ConfirmTimeoutsTest::ConfirmTimeoutsTest() {
+
+}
+
+ConfirmTimeoutsTest::~ConfirmTimeoutsTest() {
+
+}
+
+void ConfirmTimeoutsTest::test() {
+    QH::ConfirmTimeouts timeouts;
+
+    QList<QH::HostAddressKey> expired;
+    QObject::connect(&timeouts, &QH::ConfirmTimeouts::sigTimeout, [&expired](const QH::HostAddressKey& key) {
+        expired.push_back(key);
+    });
+
+    const QH::HostAddressKey first{QH::HostAddress(QHostAddress("10.0.0.1"), 1000)};
+    const QH::HostAddressKey second{QH::HostAddress(QHostAddress("10.0.0.1"), 1001)};
+    const QH::HostAddressKey third{QH::HostAddress(QHostAddress("10.0.0.2"), 1000)};
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    timeouts.add(first, 1000);
+    timeouts.add(second, 100000);
+    timeouts.add(third, 2000);
+    QVERIFY(timeouts.size() == 3);
+
+    QVERIFY(timeouts.expire(now - 1000) == 0);
+    QVERIFY(expired.isEmpty());
+
+    // the second add moves the deadline.
+    timeouts.add(third, 100000);
+    QVERIFY(timeouts.size() == 3);
+
+    QVERIFY(timeouts.expire(now + 10000) == 1);
+    QVERIFY(expired == QList<QH::HostAddressKey>{first});
+
+    // removed connections are not expired.
+    timeouts.remove(second);
+    QVERIFY(timeouts.size() == 1);
+
+    QVERIFY(timeouts.expire(now + 200000) == 1);
+    QVERIFY(expired == (QList<QH::HostAddressKey>{first, third}));
+    QVERIFY(timeouts.size() == 0);
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef CONFIRMTIMEOUTSTEST_H
+#define CONFIRMTIMEOUTSTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The ConfirmTimeoutsTest class test the deadlines queue of the ConfirmTimeouts with fixed time.
+ */
+class ConfirmTimeoutsTest: public Test, protected TestUtils
+{
+public:
+    ConfirmTimeoutsTest();
+    ~ConfirmTimeoutsTest();
+    void test();
+};
+
+#endif // CONFIRMTIMEOUTSTEST_H
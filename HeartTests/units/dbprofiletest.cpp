@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "dbprofiletest.h"
+
+#include <asyncsqldbwriter.h>
+#include <config.h>
+#include <QSqlQuery>
+
+DbProfileTest::DbProfileTest() {
+
+}
+
+DbProfileTest::~DbProfileTest() {
+
+}
+
+void DbProfileTest::test() {
+    // sqlite returns synchronous mode as number: 0 - OFF, 1 - NORMAL, 2 - FULL
+    testProfile("durable", "2", "delete");
+    testProfile("balanced", "1", "wal");
+    testProfile("throughput", "0", "wal");
+
+    QVERIFY(QH::SqlDBWriter::performanceProfile("unknown").isEmpty());
+}
+
+void DbProfileTest::testProfile(const QString &profile, const QString &synchronous, const QString &journal) {
+    const QString name = "DbProfileTest_" + profile;
+
+    {
+        QH::AsyncSqlDBWriter writer;
+        QVERIFY(initTestDb(writer, name, QVariantMap{
+            {QH_DB_PROFILE, profile},
+            {QH_DB_PRAGMAS, QVariantMap{{"cache_size", -2000}}}
+        }));
+
+        QSqlQuery query;
+        QVERIFY(writer.doQuery("PRAGMA synchronous", {}, true, &query));
+        QVERIFY(query.next());
+        QVERIFY(query.value(0).toString() == synchronous);
+
+        QVERIFY(writer.doQuery("PRAGMA journal_mode", {}, true, &query));
+        QVERIFY(query.next());
+        QVERIFY(query.value(0).toString().toLower() == journal);
+
+        // custom pragmas are applied after the profile.
+        QVERIFY(writer.doQuery("PRAGMA cache_size", {}, true, &query));
+        QVERIFY(query.next());
+        QVERIFY(query.value(0).toInt() == -2000);
+    }
+
+    removeTestDb(name);
+}
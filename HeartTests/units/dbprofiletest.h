@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef DBPROFILETEST_H
+#define DBPROFILETEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The DbProfileTest class test pragmas of the performance profiles of the sqlite database.
+ */
+class DbProfileTest: public Test, protected TestUtils
+{
+public:
+    DbProfileTest();
+    ~DbProfileTest();
+    void test();
+
+private:
+    void testProfile(const QString& profile, const QString& synchronous, const QString& journal);
+};
+
+#endif // DBPROFILETEST_H
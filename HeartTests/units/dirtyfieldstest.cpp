@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "dirtyfieldstest.h"
+
+#include <asyncsqldbwriter.h>
+#include <config.h>
+#include <dbobject.h>
+#include <isqldb.h>
+#include <QSqlQuery>
+#include <QSqlRecord>
+
+class DirtyItem: public QH::PKG::DBObject {
+    QH_PACKAGE("DirtyItem")
+
+public:
+    DirtyItem(int id = 0): _id(id) {}
+
+    QH::PKG::DBObject *createDBObject() const override {
+        return create<DirtyItem>(_id);
+    }
+
+    bool fromSqlRecord(const QSqlRecord &q) override {
+        _id = q.value("id").toInt();
+        setScore(q.value("score").toInt());
+        setName(q.value("name").toString());
+        return true;
+    }
+
+    QString table() const override {
+        return "DirtyItems";
+    }
+
+    QString primaryKey() const override {
+        return "id";
+    }
+
+    QVariant primaryValue() const override {
+        return _id;
+    }
+
+    QH::PKG::DBVariantMap variantMap() const override {
+        return {{"id",      {_id,       QH::PKG::MemberType::PrimaryKey}},
+                {"score",   {_score,    QH::PKG::MemberType::InsertUpdate}},
+                {"name",    {_name,     QH::PKG::MemberType::InsertUpdate}}};
+    }
+
+    bool isCached() const override {
+        return false;
+    }
+
+    void setScore(int score) {
+        setField(_score, score, "score");
+    }
+
+    void setName(const QString& name) {
+        setField(_name, name, "name");
+    }
+
+private:
+    int _id = 0;
+    int _score = 0;
+    QString _name;
+};
+
+// the database without cache, that only saves the queue of changes.
+class QueueDB: public QH::ISqlDB {
+public:
+    using QH::ISqlDB::pushToQueue;
+    using QH::ISqlDB::globalUpdateDataBasePrivate;
+
+protected:
+    void deleteFromCache(const QSharedPointer<QH::PKG::DBObject> &) override {}
+    bool insertToCache(const QSharedPointer<QH::PKG::DBObject> &) override {return false;}
+    bool updateCache(const QSharedPointer<QH::PKG::DBObject> &) override {return false;}
+    QList<QSharedPointer<QH::PKG::DBObject>> getFromCache(const QH::PKG::DBObject *) override {return {};}
+};
+
+DirtyFieldsTest::DirtyFieldsTest() {
+
+}
+
+DirtyFieldsTest::~DirtyFieldsTest() {
+
+}
+
+void DirtyFieldsTest::test() {
+    {
+        QH::AsyncSqlDBWriter writer;
+        QVERIFY(initTestDb(writer, "DirtyFieldsTest"));
+
+        QVERIFY(writer.doQuery("CREATE TABLE IF NOT EXISTS DirtyItems (id INTEGER PRIMARY KEY, score INT, name TEXT)", {}, true));
+
+        auto item = QSharedPointer<DirtyItem>::create(1);
+        item->setScore(1);
+        item->setName("first");
+        QVERIFY(writer.insertObject(item, true));
+        QVERIFY(item->dirtyFields().isEmpty());
+
+        auto selected = writer.getObject(DirtyItem{1});
+        QVERIFY(selected);
+        QVERIFY(selected->dirtyFields().isEmpty());
+
+        // the name changed by other client, so the update of the score only should not overwrite it.
+        QVERIFY(writer.doQuery("UPDATE DirtyItems SET name='second' WHERE id=1", {}, true));
+
+        selected->setScore(2);
+        QVERIFY(selected->dirtyFields() == QSet<QString>{"score"});
+        QVERIFY(writer.updateObject(selected, true));
+        QVERIFY(selected->dirtyFields().isEmpty());
+
+        QSqlQuery query;
+        QVERIFY(writer.doQuery("SELECT score, name FROM DirtyItems WHERE id=1", {}, true, &query));
+        QVERIFY(query.next());
+        QVERIFY(query.value(0).toInt() == 2);
+        QVERIFY(query.value(1).toString() == "second");
+
+        // upsert updates the existing row in place, so rowid is not changed and only changed fields are written.
+        QVERIFY(writer.doQuery("SELECT rowid FROM DirtyItems WHERE id=1", {}, true, &query));
+        QVERIFY(query.next());
+        const auto rowId = query.value(0);
+
+        QVERIFY(writer.doQuery("UPDATE DirtyItems SET name='upserted' WHERE id=1", {}, true));
+        selected->setScore(5);
+        QVERIFY(writer.upsertObject(selected, true));
+
+        QVERIFY(writer.doQuery("SELECT rowid, score, name FROM DirtyItems WHERE id=1", {}, true, &query));
+        QVERIFY(query.next());
+        QVERIFY(query.value(0) == rowId);
+        QVERIFY(query.value(1).toInt() == 5);
+        QVERIFY(query.value(2).toString() == "upserted");
+
+        // upsert of the new object inserts it.
+        auto newItem = QSharedPointer<DirtyItem>::create(2);
+        newItem->setScore(10);
+        QVERIFY(writer.upsertObject(newItem, true));
+        QVERIFY(writer.doQuery("SELECT COUNT(*) FROM DirtyItems", {}, true, &query));
+        QVERIFY(query.next());
+        QVERIFY(query.value(0).toInt() == 2);
+
+        // folding of the changes
+        DirtyItem old(1);
+        old.setName("third");
+        selected->setScore(3);
+        selected->mergeDirtyFields(old);
+        QVERIFY(selected->dirtyFields() == (QSet<QString>{"score", "name"}));
+
+        // fields changed after preparing of the query stay dirty.
+        QSet<QString> taken;
+        QVERIFY(selected->prepareAndTakeDirtyFields([]() {
+            return QH::PKG::PrepareResult::Success;
+        }, &taken) == QH::PKG::PrepareResult::Success);
+        QVERIFY(taken == (QSet<QString>{"score", "name"}));
+        QVERIFY(selected->dirtyFields().isEmpty());
+
+        selected->setScore(4);
+        QVERIFY(selected->dirtyFields() == QSet<QString>{"score"});
+
+        // failed query returns taken fields.
+        selected->restoreDirtyFields(taken);
+        QVERIFY(selected->dirtyFields() == (QSet<QString>{"score", "name"}));
+
+        testQueue(writer);
+    }
+
+    removeTestDb("DirtyFieldsTest");
+}
+
+void DirtyFieldsTest::testQueue(QH::AsyncSqlDBWriter &writer) {
+    QVERIFY(writer.doQuery("INSERT INTO DirtyItems (id, score, name) VALUES (3, 1, 'old'), (4, 1, 'old')", {}, true));
+
+    auto db = new QueueDB();
+    db->setWriter(&writer);
+
+    // insert after delete replaces the row with all fields.
+    db->pushToQueue(QSharedPointer<DirtyItem>::create(3), QH::CacheAction::Delete);
+    auto inserted = QSharedPointer<DirtyItem>::create(3);
+    inserted->setScore(30);
+    db->pushToQueue(inserted, QH::CacheAction::Insert);
+
+    // update after delete do not restore the row.
+    db->pushToQueue(QSharedPointer<DirtyItem>::create(4), QH::CacheAction::Delete);
+    auto updated = QSharedPointer<DirtyItem>::create(4);
+    updated->setScore(40);
+    db->pushToQueue(updated, QH::CacheAction::Update);
+
+    db->globalUpdateDataBasePrivate(QDateTime::currentMSecsSinceEpoch());
+
+    QSqlQuery query;
+    QVERIFY(writer.doQuery("SELECT score, name FROM DirtyItems WHERE id=3", {}, true, &query));
+    QVERIFY(query.next());
+    QVERIFY(query.value(0).toInt() == 30);
+    QVERIFY(query.value(1).toString().isEmpty());
+
+    QVERIFY(writer.doQuery("SELECT COUNT(*) FROM DirtyItems WHERE id=4", {}, true, &query));
+    QVERIFY(query.next());
+    QVERIFY(query.value(0).toInt() == 0);
+
+    db->softDelete();
+}
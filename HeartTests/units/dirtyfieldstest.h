@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef DIRTYFIELDSTEST_H
+#define DIRTYFIELDSTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+namespace QH {
+class AsyncSqlDBWriter;
+}
+
+/**
+ * @brief The DirtyFieldsTest class test the update of the changed fields only.
+ */
+class DirtyFieldsTest: public Test, protected TestUtils
+{
+public:
+    DirtyFieldsTest();
+    ~DirtyFieldsTest();
+    void test();
+
+private:
+    void testQueue(QH::AsyncSqlDBWriter& writer);
+};
+
+#endif // DIRTYFIELDSTEST_H
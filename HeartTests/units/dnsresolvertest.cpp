@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "dnsresolvertest.h"
+
+#include <dnsresolver.h>
+
+DnsResolverTest::DnsResolverTest() {
+
+}
+
+DnsResolverTest::~DnsResolverTest() {
+
+}
+
+void DnsResolverTest::test() {
+    QH::DnsResolver resolver;
+
+    int lookups = 0;
+    resolver.setLookupFunction([&lookups](const QString& name, const QH::DnsResolver::LookupResult& result) {
+        lookups++;
+
+        QHostInfo info;
+        info.setHostName(name);
+
+        if (name == "heart.test") {
+            info.setAddresses({QHostAddress("10.0.0.1"),
+                               QHostAddress("10.0.0.2"),
+                               QHostAddress("2001:db8::1")});
+        } else {
+            info.setError(QHostInfo::HostNotFound);
+        }
+
+        result(info);
+    });
+
+    QList<QHostAddress> firstAddresses;
+    for (int i = 0; i < 3; ++i) {
+        resolver.resolve("heart.test", [&firstAddresses](const QHostInfo& info) {
+            QVERIFY(info.error() == QHostInfo::NoError);
+            QVERIFY(info.addresses().size() == 3);
+            firstAddresses.push_back(info.addresses().first());
+        });
+    }
+
+    // one lookup for all requests and the round-robin over all addresses starting with ipv6.
+    QVERIFY(lookups == 1);
+    QVERIFY(firstAddresses.size() == 3);
+    QVERIFY(firstAddresses[0] == QHostAddress("2001:db8::1"));
+    QVERIFY(QSet<QString>({firstAddresses[0].toString(),
+                           firstAddresses[1].toString(),
+                           firstAddresses[2].toString()}).size() == 3);
+
+    // negative cache
+    bool failed = false;
+    resolver.resolve("unknown.test", [&failed](const QHostInfo& info) {
+        failed = info.error() != QHostInfo::NoError;
+    });
+    resolver.resolve("unknown.test", [](const QHostInfo&) {});
+    QVERIFY(failed);
+    QVERIFY(lookups == 2);
+
+    // ttl
+    resolver.setTtl(0);
+    resolver.clear();
+    resolver.resolve("heart.test", [](const QHostInfo&) {});
+    resolver.resolve("heart.test", [](const QHostInfo&) {});
+    QVERIFY(lookups == 4);
+
+    // the least recently used record is removed when the cache is full.
+    resolver.setTtl(DNS_CACHE_TTL);
+    resolver.clear();
+    resolver.setCacheLimit(2);
+    resolver.resolve("a.test", [](const QHostInfo&) {});
+    resolver.resolve("b.test", [](const QHostInfo&) {});
+    resolver.resolve("a.test", [](const QHostInfo&) {});
+    resolver.resolve("c.test", [](const QHostInfo&) {});
+    QVERIFY(resolver.cacheSize() == 2);
+    QVERIFY(lookups == 7);
+
+    resolver.resolve("a.test", [](const QHostInfo&) {});
+    QVERIFY(lookups == 7);
+    resolver.resolve("b.test", [](const QHostInfo&) {});
+    QVERIFY(lookups == 8);
+    QVERIFY(resolver.cacheSize() == 2);
+
+    // disabled reverse lookups
+    resolver.setReverseLookupEnabled(false);
+    bool invoked = false;
+    resolver.reverseLookup(QHostAddress("10.0.0.1"), [&invoked](const QHostInfo& info) {
+        invoked = info.hostName().isEmpty();
+    });
+    QVERIFY(invoked);
+    QVERIFY(lookups == 8);
+}
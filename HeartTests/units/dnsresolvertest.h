@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef DNSRESOLVERTEST_H
+#define DNSRESOLVERTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The DnsResolverTest class test the cache of the DnsResolver with local stand-in lookup function.
+ */
+class DnsResolverTest: public Test, protected TestUtils
+{
+public:
+    DnsResolverTest();
+    ~DnsResolverTest();
+    void test();
+};
+
+#endif // DNSRESOLVERTEST_H
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "hostaddresstest.h"
+
+#include <hostaddress.h>
+#include <hostaddresskey.h>
+#include <QElapsedTimer>
+
+#define PEERS_COUNT 10000
+#define BENCHMARK_ROUNDS 10
+
+HostAddressTest::HostAddressTest() {
+
+}
+
+HostAddressTest::~HostAddressTest() {
+
+}
+
+void HostAddressTest::test() {
+    testKey();
+    benchmarkConnectionsMap();
+}
+
+void HostAddressTest::testKey() {
+    QH::HostAddress ipv4("192.168.0.1", 1234);
+    QH::HostAddress ipv4OtherPort("192.168.0.1", 1235);
+    QH::HostAddress ipv6("2001:db8::1", 1234);
+    QH::HostAddress local(QHostAddress::LocalHost, 1234);
+
+    QVERIFY(QH::HostAddressKey{ipv4} == QH::HostAddressKey{QH::HostAddress("192.168.0.1", 1234)});
+    QVERIFY(QH::HostAddressKey{ipv4} != QH::HostAddressKey{ipv4OtherPort});
+    QVERIFY(QH::HostAddressKey{ipv4} != QH::HostAddressKey{ipv6});
+    QVERIFY(qHash(ipv4) != qHash(ipv4OtherPort));
+    QVERIFY(qHash(local) == qHash(QH::HostAddress(QHostAddress::LocalHost, 1234)));
+
+    // ipv4 addresses are stored as ipv4 mapped ipv6 addresses.
+    QVERIFY(QH::HostAddressKey{ipv4}.high() == 0);
+    QVERIFY((QH::HostAddressKey{ipv4}.low() >> 32) == 0xffff);
+
+    QVERIFY(QH::HostAddressKey{ipv4}.toHostAddress() == ipv4);
+    QVERIFY(QH::HostAddressKey{ipv6}.toHostAddress() == ipv6);
+    QVERIFY(QH::HostAddressKey{local}.toHostAddress() == local);
+    QVERIFY(QH::HostAddressKey{QH::HostAddress{}}.toHostAddress().isNull());
+}
+
+void HostAddressTest::benchmarkConnectionsMap() {
+    const QStringList ips = {"10.0.0.1", "10.0.0.2", "127.0.0.1", "::1"};
+
+    QList<QH::HostAddress> peers;
+    peers.reserve(PEERS_COUNT);
+    for (int i = 0; i < PEERS_COUNT; ++i) {
+        peers.push_back(QH::HostAddress(ips[i % ips.size()], 1024 + i / ips.size()));
+    }
+
+    QSet<QH::qhash_result_t> hashes;
+    for (const auto& peer: std::as_const(peers)) {
+        hashes.insert(qHash(peer));
+    }
+
+    // all peers have unique ip + port pair, so hashes should be almost unique too.
+    QVERIFY(hashes.size() > PEERS_COUNT * 0.99);
+
+    QHash<QH::HostAddressKey, int> keyMap;
+    QHash<QH::HostAddress, int> addressMap;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int round = 0; round < BENCHMARK_ROUNDS; ++round) {
+        keyMap.clear();
+        for (int i = 0; i < peers.size(); ++i) {
+            keyMap.insert(peers[i], i);
+        }
+
+        for (int i = 0; i < peers.size(); ++i) {
+            QVERIFY(keyMap.value(peers[i], -1) == i);
+        }
+    }
+    const qint64 keyTime = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int round = 0; round < BENCHMARK_ROUNDS; ++round) {
+        addressMap.clear();
+        for (int i = 0; i < peers.size(); ++i) {
+            addressMap.insert(peers[i], i);
+        }
+
+        for (int i = 0; i < peers.size(); ++i) {
+            QVERIFY(addressMap.value(peers[i], -1) == i);
+        }
+    }
+    const qint64 addressTime = timer.nsecsElapsed();
+
+    QVERIFY(keyMap.size() == PEERS_COUNT);
+    QVERIFY(addressMap.size() == PEERS_COUNT);
+
+    qInfo() << "HostAddressKey map:" << keyTime / (BENCHMARK_ROUNDS * PEERS_COUNT) << "ns per peer,"
+            << "HostAddress map:" << addressTime / (BENCHMARK_ROUNDS * PEERS_COUNT) << "ns per peer";
+}
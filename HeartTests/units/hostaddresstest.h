@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef HOSTADDRESSTEST_H
+#define HOSTADDRESSTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The HostAddressTest class test the HostAddressKey and hash of the network addresses.
+ * Contains the benchmark of the connections map with 10k peers behind a few ip addresses.
+ */
+class HostAddressTest: public Test, protected TestUtils
+{
+public:
+    HostAddressTest();
+    ~HostAddressTest();
+    void test();
+
+protected:
+    void testKey();
+    void benchmarkConnectionsMap();
+};
+
+#endif // HOSTADDRESSTEST_H
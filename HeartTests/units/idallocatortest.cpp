@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "idallocatortest.h"
+
+#include <asyncsqldbwriter.h>
+#include <config.h>
+#include <idallocator.h>
+#include <QSet>
+#include <QSqlQuery>
+#include <thread>
+
+#define ID_TEST_THREADS 4
+#define ID_TEST_IDS 500
+
+IdAllocatorTest::IdAllocatorTest() {
+
+}
+
+IdAllocatorTest::~IdAllocatorTest() {
+
+}
+
+void IdAllocatorTest::test() {
+    {
+        QH::AsyncSqlDBWriter writer;
+        QVERIFY(initTestDb(writer, "IdAllocatorTest"));
+
+        QVERIFY(writer.doQuery("CREATE TABLE IF NOT EXISTS Items (id INTEGER PRIMARY KEY, value INT)", {}, true));
+        QVERIFY(writer.doQuery("INSERT INTO Items (id, value) VALUES (41, 0)", {}, true));
+
+        qint64 maxId = 0;
+
+        {
+            QH::IdAllocator allocator(&writer, 16);
+
+            // the sequence starts after existing rows.
+            QVERIFY(allocator.nextId("Items") == 42);
+            QVERIFY(allocator.nextId("Items") == 43);
+
+            // ids are unique for all threads.
+            auto sequence = allocator.sequence("Items");
+            QList<qint64> results[ID_TEST_THREADS];
+            std::vector<std::thread> threads;
+
+            for (int i = 0; i < ID_TEST_THREADS; ++i) {
+                threads.emplace_back([sequence, &results, i]() {
+                    for (int j = 0; j < ID_TEST_IDS; ++j) {
+                        results[i].push_back(sequence->next());
+                    }
+                });
+            }
+
+            for (auto& thread: threads) {
+                thread.join();
+            }
+
+            QSet<qint64> ids;
+            for (const auto& list: results) {
+                for (qint64 id: list) {
+                    QVERIFY(id > 43);
+                    ids.insert(id);
+                    maxId = std::max(maxId, id);
+                }
+            }
+
+            QVERIFY(ids.size() == ID_TEST_THREADS * ID_TEST_IDS);
+
+            // ids can be used before inserting.
+            const qint64 id = allocator.nextId("Items");
+            QVERIFY(writer.doQuery("INSERT INTO Items (id, value) VALUES (:id, 1)", {{":id", id}}, false));
+            maxId = std::max(maxId, id);
+        }
+
+        // the new allocator (after restart) do not repeat ids of the reserved blocks.
+        QH::IdAllocator allocator(&writer, 16);
+        QVERIFY(allocator.nextId("Items") > maxId);
+    }
+
+    removeTestDb("IdAllocatorTest");
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef IDALLOCATORTEST_H
+#define IDALLOCATORTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The IdAllocatorTest class test the block reserving of the unique ids of tables.
+ */
+class IdAllocatorTest: public Test, protected TestUtils
+{
+public:
+    IdAllocatorTest();
+    ~IdAllocatorTest();
+    void test();
+};
+
+#endif // IDALLOCATORTEST_H
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "keyvaluestoretest.h"
+
+#include <asyncsqldbwriter.h>
+#include <config.h>
+#include <keyvaluestore.h>
+#include <QSqlQuery>
+#include <thread>
+
+#define KV_TEST_THREADS 4
+#define KV_TEST_INCREMENTS 1000
+
+KeyValueStoreTest::KeyValueStoreTest() {
+
+}
+
+KeyValueStoreTest::~KeyValueStoreTest() {
+
+}
+
+void KeyValueStoreTest::test() {
+    {
+        QH::AsyncSqlDBWriter writer;
+        QVERIFY(initTestDb(writer, "KeyValueStoreTest"));
+
+        {
+            QH::KeyValueStore store(&writer);
+            QVERIFY(store.load());
+            QVERIFY(!store.contains("flag"));
+
+            store.setValue("flag", true);
+            store.setValue("name", QString("node"));
+            store.setValue("temp", 1);
+            QVERIFY(store.value<bool>("flag"));
+            QVERIFY(store.value<QString>("name") == "node");
+            QVERIFY(store.value<int>("missing", 7) == 7);
+
+            // counters are atomic.
+            std::vector<std::thread> threads;
+            for (int i = 0; i < KV_TEST_THREADS; ++i) {
+                threads.emplace_back([&store]() {
+                    for (int j = 0; j < KV_TEST_INCREMENTS; ++j) {
+                        store.increment("counter");
+                    }
+                });
+            }
+
+            for (auto& thread: threads) {
+                thread.join();
+            }
+
+            QVERIFY(store.value<qint64>("counter") == KV_TEST_THREADS * KV_TEST_INCREMENTS);
+
+            // compare and set
+            QVERIFY(!store.compareAndSet("name", QString("other"), QString("new node")));
+            QVERIFY(store.compareAndSet("name", QString("node"), QString("new node")));
+            QVERIFY(store.compareAndSet("lock", QVariant{}, 1));
+            QVERIFY(!store.compareAndSet("lock", QVariant{}, 2));
+
+            QVERIFY(store.remove("temp"));
+            QVERIFY(!store.remove("temp"));
+
+            QVERIFY(store.flush(true));
+
+            QSqlQuery query;
+            QVERIFY(writer.doQuery("SELECT COUNT(*) FROM " DB_KEY_VALUE_TABLE, {}, true, &query));
+            QVERIFY(query.next());
+            QVERIFY(query.value(0).toInt() == 4);
+
+            store.increment("counter", -1);
+        }
+
+        // not saved changes are written by the destructor.
+        QH::KeyValueStore store(&writer);
+        QVERIFY(store.load());
+        QVERIFY(store.value<bool>("flag"));
+        QVERIFY(store.value<QString>("name") == "new node");
+        QVERIFY(store.value<int>("lock") == 1);
+        QVERIFY(!store.contains("temp"));
+        QVERIFY(store.value<qint64>("counter") == KV_TEST_THREADS * KV_TEST_INCREMENTS - 1);
+    }
+
+    removeTestDb("KeyValueStoreTest");
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef KEYVALUESTORETEST_H
+#define KEYVALUESTORETEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The KeyValueStoreTest class test the in memory key-value storage with write-behind to database.
+ */
+class KeyValueStoreTest: public Test, protected TestUtils
+{
+public:
+    KeyValueStoreTest();
+    ~KeyValueStoreTest();
+    void test();
+};
+
+#endif // KEYVALUESTORETEST_H
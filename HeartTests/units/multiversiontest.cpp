@@ -254,6 +254,7 @@ void MultiVersionTest::test() {
 
     testMultipacakges();
     testSinglePackages();
+    testLegacyPrefix();
 }
 
 void MultiVersionTest::testMultipacakges() {
@@ -358,3 +359,61 @@ void MultiVersionTest::testSinglePackages() {
         QVERIFY(data->v2 ==  0);
     }
 }
+
+void MultiVersionTest::testLegacyPrefix() {
+    // package in the old "mver" format.
+    QByteArray legacy;
+    {
+        QDataStream stream(&legacy, QIODevice::WriteOnly);
+        stream << QByteArray{"mver"};
+        stream << static_cast<unsigned short>(1);
+        stream << 10 << true << 20;
+    }
+
+    MultiVersionPkg2 pkg;
+    QVERIFY(pkg.fromBytes(legacy));
+    QVERIFY(pkg.lastSerializedFrom == 1);
+    QVERIFY(pkg.v1 == 10);
+    QVERIFY(pkg.v2 == 20);
+    QVERIFY(pkg.responce);
+
+    // default writer should be readable by the old reader.
+    QH::DistVersion version;
+    version.setMin(0);
+    version.setMax(2);
+
+    const QByteArray written = pkg.toBytesOf(version);
+    {
+        QDataStream stream(written);
+        QByteArray magic;
+        stream >> magic;
+
+        unsigned short oldVersion = 0;
+        if (magic == "mver") {
+            stream >> oldVersion;
+        } else {
+            stream.device()->seek(0);
+        }
+
+        int v2 = 0;
+        bool responce = false;
+        stream >> v2 >> responce;
+
+        QVERIFY(stream.status() == QDataStream::Ok);
+        QVERIFY(oldVersion == 2);
+        QVERIFY(v2 == 20);
+        QVERIFY(responce);
+    }
+
+    // compact prefix: tag and varint version.
+    QByteArray compact("\xFEmvr\x02", 5);
+    {
+        QDataStream stream(&compact, QIODevice::WriteOnly | QIODevice::Append);
+        stream << 30 << true;
+    }
+
+    MultiVersionPkg2 result;
+    QVERIFY(result.fromBytes(compact));
+    QVERIFY(result.lastSerializedFrom == 2);
+    QVERIFY(result.v2 == 30);
+}
@@ -28,6 +28,7 @@ protected:
 
     void testMultipacakges();
     void testSinglePackages();
+    void testLegacyPrefix();
 
 private:
     QH::AbstractNode *_nodeV1 = nullptr;
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "packagemanagertest.h"
+
+#include <packagemanager.h>
+#include <hostaddress.h>
+
+PackageManagerTest::PackageManagerTest() {
+
+}
+
+PackageManagerTest::~PackageManagerTest() {
+
+}
+
+void PackageManagerTest::test() {
+    const QH::HostAddressKey peerA{QH::HostAddress("10.0.0.1", 1000)};
+    const QH::HostAddressKey peerB{QH::HostAddress("10.0.0.2", 1000)};
+
+    QH::PackageManager cache(4, 100, 0);
+
+    // dedup and replay
+    QVERIFY(cache.begin(peerA, 1));
+    cache.processed(peerA, 1, 1);
+    cache.setResponse(peerA, 1, QByteArray(10, 'a'));
+
+    QByteArray response;
+    QVERIFY(!cache.begin(peerA, 1, &response));
+    QVERIFY(response == QByteArray(10, 'a'));
+    QVERIFY(cache.processResult(peerA, 1) == 1);
+
+    // same hash from other peer is a different package.
+    QVERIFY(cache.begin(peerB, 1));
+
+    // capacity and lru eviction
+    QVERIFY(cache.begin(peerA, 2));
+    QVERIFY(cache.begin(peerA, 3));
+    QVERIFY(!cache.begin(peerA, 1));
+    QVERIFY(cache.begin(peerA, 4));
+
+    QVERIFY(cache.size() == 4);
+    QVERIFY(cache.contains(peerA, 1));
+    QVERIFY(!cache.contains(peerB, 1));
+
+    // memory budget
+    cache.setResponse(peerA, 2, QByteArray(95, 'b'));
+    QVERIFY(cache.memoryUsage() <= 100);
+    QVERIFY(cache.contains(peerA, 2));
+    QVERIFY(!cache.contains(peerA, 1));
+
+    // too big response is not saved.
+    cache.setResponse(peerA, 4, QByteArray(101, 'c'));
+    QVERIFY(cache.contains(peerA, 4));
+    QVERIFY(cache.memoryUsage() <= 100);
+
+    cache.clear();
+    QVERIFY(cache.size() == 0);
+    QVERIFY(cache.memoryUsage() == 0);
+
+    // many packages do not overflow the cache.
+    for (unsigned int i = 1; i < 10000; ++i) {
+        QVERIFY(cache.begin(peerA, i));
+    }
+
+    QVERIFY(cache.size() == cache.capacity());
+    QVERIFY(cache.contains(peerA, 9999));
+    QVERIFY(!cache.contains(peerA, 1));
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef PACKAGEMANAGERTEST_H
+#define PACKAGEMANAGERTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The PackageManagerTest class test the dedup cache of the received packages.
+ */
+class PackageManagerTest: public Test, protected TestUtils
+{
+public:
+    PackageManagerTest();
+    ~PackageManagerTest();
+    void test();
+};
+
+#endif // PACKAGEMANAGERTEST_H
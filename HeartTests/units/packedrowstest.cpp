@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "packedrowstest.h"
+
+#include <datapack.h>
+#include <universaldata.h>
+#include <limits>
+
+class PackedItem: public QH::PKG::UniversalData {
+    QH_PACKAGE("PackedItem")
+
+public:
+    enum Fields {
+        Id = 0,
+        Name = 1,
+        Rating = 2,
+        Extra = 3
+    };
+};
+
+PackedRowsTest::PackedRowsTest() {
+
+}
+
+PackedRowsTest::~PackedRowsTest() {
+
+}
+
+void PackedRowsTest::test() {
+    QH::PKG::DataPack<PackedItem> pack;
+
+    for (int i = 0; i < 100; ++i) {
+        PackedItem item;
+        item.setValue(PackedItem::Id, 1000000 + i);
+        item.setValue(PackedItem::Name, QString("item %0").arg(i));
+        item.setValue(PackedItem::Rating, i / 4.0);
+
+        if (i % 10 == 0) {
+            item.setValue(PackedItem::Extra, QStringList{"a", "b"});
+        }
+
+        pack.push(item);
+    }
+
+    const QByteArray plain = pack.toBytes();
+
+    pack.setPacked(true, true);
+    const QByteArray packed = pack.toBytes();
+    QVERIFY(packed.size() < plain.size());
+
+    QH::PKG::DataPack<PackedItem> result;
+    QVERIFY(result.fromBytes(packed));
+    QVERIFY(result.isPacked());
+    QVERIFY(result.size() == 100);
+    QVERIFY(result.isValid());
+
+    // access without creating of objects.
+    const auto &rows = result.rows();
+    QVERIFY(rows.size() == 100);
+    QVERIFY(rows.at(5).toInt(PackedItem::Id) == 1000005);
+    QVERIFY(rows.at(5).toBytes(PackedItem::Name) == "item 5");
+    QVERIFY(rows.at(6).toDouble(PackedItem::Rating) == 1.5);
+    QVERIFY(rows.at(10).contains(PackedItem::Extra));
+    QVERIFY(!rows.at(11).contains(PackedItem::Extra));
+    QVERIFY(rows.at(20).value(PackedItem::Extra).toStringList() == QStringList({"a", "b"}));
+
+    // materialized objects have same types of values.
+    const auto &items = result.packData();
+    QVERIFY(items.size() == 100);
+    QVERIFY(items[7]->value(PackedItem::Id).userType() == QMetaType::Int);
+    QVERIFY(items[7]->value(PackedItem::Name).toString() == "item 7");
+    QVERIFY(items[7]->value(PackedItem::Rating).toDouble() == 1.75);
+
+    // the old format still works.
+    QH::PKG::DataPack<PackedItem> oldFormat;
+    QVERIFY(oldFormat.fromBytes(plain));
+    QVERIFY(!oldFormat.isPacked());
+    QVERIFY(oldFormat.size() == 100);
+
+    // the old format resets the packed state of the pack.
+    QVERIFY(result.fromBytes(plain));
+    QVERIFY(!result.isPacked());
+    QVERIFY(!result.rows().size());
+    QVERIFY(result.size() == 100);
+
+    // rows without values are sent in the old format.
+    QH::PKG::DataPack<PackedItem> withEmpty;
+    withEmpty.push(PackedItem());
+    withEmpty.setPacked(true);
+
+    QH::PKG::DataPack<PackedItem> withEmptyResult;
+    QVERIFY(withEmptyResult.fromBytes(withEmpty.toBytes()));
+    QVERIFY(!withEmptyResult.isPacked());
+    QVERIFY(withEmptyResult.size() == 1);
+
+    // broken data
+    QH::PKG::DataPack<PackedItem> broken;
+    QVERIFY(!broken.fromBytes(packed.left(packed.size() / 2)) || !broken.rows().size());
+
+    // rows without columns
+    QByteArray empty;
+    {
+        QDataStream stream(&empty, QIODevice::WriteOnly);
+        stream << -1 << quint8(0) << quint8(1) << quint32(std::numeric_limits<int>::max()) << quint32(0);
+    }
+
+    QH::PKG::DataPack<PackedItem> noColumns;
+    noColumns.fromBytes(empty);
+    QVERIFY(!noColumns.rows().size());
+    QVERIFY(!noColumns.isValid());
+
+    // a lot of rows with a small presence bitmap and without values.
+    auto sparse = [](quint32 rows, bool firstPresent) {
+        QByteArray presence((rows + 7) / 8, 0);
+        QByteArray payload;
+        if (firstPresent) {
+            presence[0] = 1;
+            payload.append(char(2));
+        }
+
+        QByteArray result;
+        QDataStream stream(&result, QIODevice::WriteOnly);
+        stream << -1 << quint8(0) << quint8(1) << rows << quint32(1)
+               << qint32(PackedItem::Id) << qint32(QMetaType::Int) << quint8(0) << quint8(0x2)
+               << presence << payload << QByteArray();
+        return result;
+    };
+
+    QH::PKG::DataPack<PackedItem> zeroPresence;
+    zeroPresence.fromBytes(sparse(PACKED_ROWS_MAX / 2, false));
+    QVERIFY(!zeroPresence.rows().size());
+    QVERIFY(!zeroPresence.isValid());
+
+    QH::PKG::DataPack<PackedItem> onePresent;
+    onePresent.fromBytes(sparse(PACKED_ROWS_MAX / 2, true));
+    QVERIFY(!onePresent.rows().size());
+    QVERIFY(!onePresent.isValid());
+
+    QH::PKG::DataPack<PackedItem> tooManyRows;
+    tooManyRows.fromBytes(sparse(PACKED_ROWS_MAX + 1, true));
+    QVERIFY(!tooManyRows.rows().size());
+
+    // the valid sparse column still works.
+    QH::PKG::DataPack<PackedItem> oneRow;
+    QVERIFY(oneRow.fromBytes(sparse(1, true)));
+    QVERIFY(oneRow.rows().size() == 1);
+    QVERIFY(oneRow.rows().at(0).toInt(PackedItem::Id) == 1);
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef PACKEDROWSTEST_H
+#define PACKEDROWSTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The PackedRowsTest class test the packed (column-wise) mode of the DataPack.
+ */
+class PackedRowsTest: public Test, protected TestUtils
+{
+public:
+    PackedRowsTest();
+    ~PackedRowsTest();
+    void test();
+};
+
+#endif // PACKEDROWSTEST_H
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "residenttabletest.h"
+
+#include <asyncsqldbwriter.h>
+#include <config.h>
+#include <dbobjectsrequest.h>
+#include <sqldb.h>
+#include <QSqlRecord>
+#include <atomic>
+
+using Op = QH::PKG::DBPredicate::Operator;
+using Predicate = QH::PKG::DBPredicate;
+
+class Player: public QH::PKG::DBObject {
+    QH_PACKAGE("Player")
+
+public:
+    Player(int id = 0, int score = 0): _id(id), _score(score), _name(QString("player %0").arg(id)) {}
+
+    QH::PKG::DBObject *createDBObject() const override {
+        return create<Player>();
+    }
+
+    bool fromSqlRecord(const QSqlRecord &q) override {
+        _id = q.value("id").toInt();
+        _score = q.value("score").toInt();
+        _name = q.value("name").toString();
+        return true;
+    }
+
+    QString table() const override {
+        return "Players";
+    }
+
+    QString primaryKey() const override {
+        return "id";
+    }
+
+    QVariant primaryValue() const override {
+        return _id;
+    }
+
+    QH::PKG::DBVariantMap variantMap() const override {
+        return {{"id",      {_id,       QH::PKG::MemberType::PrimaryKey}},
+                {"score",   {_score,    QH::PKG::MemberType::InsertUpdate}},
+                {"name",    {_name,     QH::PKG::MemberType::InsertUpdate}}};
+    }
+
+    bool isCached() const override {
+        return false;
+    }
+
+    int score() const {
+        return _score;
+    }
+
+    void setScore(int score) {
+        setField(_score, score, "score");
+    }
+
+    const QString& name() const {
+        return _name;
+    }
+
+    void setName(const QString& name) {
+        setField(_name, name, "name");
+    }
+
+private:
+    int _id = 0;
+    int _score = 0;
+    QString _name;
+};
+
+static int count(QH::ISqlDB* db, const Predicate& predicate) {
+    QH::PKG::DBObjectsRequest<Player> request("Players", predicate);
+    auto result = db->getObject(request);
+    if (!result) {
+        return -1;
+    }
+
+    return result->data().size();
+}
+
+ResidentTableTest::ResidentTableTest() {
+
+}
+
+ResidentTableTest::~ResidentTableTest() {
+
+}
+
+void ResidentTableTest::test() {
+    {
+        QH::AsyncSqlDBWriter writer;
+        QVERIFY(initTestDb(writer, "ResidentTableTest"));
+
+        QVERIFY(writer.doQuery("CREATE TABLE IF NOT EXISTS Players (id INTEGER PRIMARY KEY, score INT, name TEXT)", {}, true));
+
+        auto db = new QH::SqlDB();
+        db->setWriter(&writer);
+
+        QList<QSharedPointer<QH::PKG::DBObject>> players;
+        for (int i = 1; i <= 100; ++i) {
+            players.push_back(QSharedPointer<Player>::create(i, i));
+        }
+        QVERIFY(db->insertObjects(players, true));
+
+        const Predicate top = Predicate("score", Op::Greater, 90);
+        const Predicate complex = (Predicate("score", Op::GreaterOrEqual, 10) && Predicate("score", Op::Less, 20)) ||
+                                  Predicate("name", Op::Equal, "player 50");
+
+        // the predicate works with database.
+        QVERIFY(count(db, top) == 10);
+        QVERIFY(count(db, complex) == 11);
+
+        QVERIFY(db->setResident(QSharedPointer<Player>::create(),
+                                {{"score", QH::ResidentTable::IndexType::Ordered},
+                                 {"name", QH::ResidentTable::IndexType::Hash}}));
+        QVERIFY(db->isResident("Players"));
+
+        // same results from memory.
+        QVERIFY(count(db, top) == 10);
+        QVERIFY(count(db, complex) == 11);
+        QVERIFY(count(db, Predicate("score", Op::Equal, 5) || Predicate("score", Op::LessOrEqual, 2)) == 3);
+        QVERIFY(count(db, Predicate()) == 100);
+
+        // changes of the cache are applied to the resident table.
+        auto player = QSharedPointer<Player>::create(5, 5);
+        player->setScore(95);
+        QVERIFY(db->updateObject(player, true));
+        QVERIFY(count(db, top) == 11);
+
+        // the update writes only changed fields, so other fields keep values of the table.
+        auto renamed = QSharedPointer<Player>::create(7, 0);
+        renamed->setName("renamed");
+        QVERIFY(db->updateObject(renamed, true));
+
+        QH::PKG::DBObjectsRequest<Player> byId("Players", Predicate("id", Op::Equal, 7));
+        auto selected = db->getObject(byId);
+        QVERIFY(selected && selected->data().size() == 1);
+        QVERIFY(selected->data().first()->score() == 7);
+        QVERIFY(selected->data().first()->name() == "renamed");
+
+        // returned objects are copies of the rows.
+        selected->data().first()->setScore(1000);
+        selected = db->getObject(byId);
+        QVERIFY(selected && selected->data().first()->score() == 7);
+
+        QVERIFY(db->deleteObject(QSharedPointer<Player>::create(100, 100), true));
+        QVERIFY(count(db, top) == 10);
+
+        // the resident table do not see direct queries. This is proof that select works without database.
+        QVERIFY(db->doQuery("DELETE FROM Players", {}, true));
+        QVERIFY(count(db, top) == 10);
+
+        // requests with string conditions always go to database.
+        QH::PKG::DBObjectsRequest<Player> sqlRequest("Players", "score > 90");
+        auto sqlResult = db->getObject(sqlRequest);
+        QVERIFY(sqlResult && sqlResult->data().isEmpty());
+
+        db->removeResident("Players");
+        QVERIFY(!db->isResident("Players"));
+        QVERIFY(count(db, top) == 0);
+
+        // background loading by batches.
+        players.clear();
+        for (int i = 1; i <= 50; ++i) {
+            players.push_back(QSharedPointer<Player>::create(i, i * 2));
+        }
+        QVERIFY(db->insertObjects(players, true));
+
+        std::atomic<int> batches{0};
+        std::atomic<int> loaded{0};
+        QObject::connect(db, &QH::ISqlDB::sigPreloadProgress, db,
+                         [&batches, &loaded](const QString&, int rows, int total) {
+                             ++batches;
+                             loaded = rows;
+                             Q_UNUSED(total)
+                         }, Qt::DirectConnection);
+
+        auto preload = db->preloadResident(QSharedPointer<Player>::create(), {}, 7);
+        preload.waitForFinished();
+        QVERIFY(!preload.isCanceled() && preload.result());
+        QVERIFY(batches == 8);
+        QVERIFY(loaded == 50);
+
+        QVERIFY(db->doQuery("DELETE FROM Players", {}, true));
+        QVERIFY(count(db, Predicate("score", Op::Greater, 90)) == 5);
+
+        db->softDelete();
+    }
+
+    removeTestDb("ResidentTableTest");
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef RESIDENTTABLETEST_H
+#define RESIDENTTABLETEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The ResidentTableTest class test the select requests with predicates from the in memory tables.
+ */
+class ResidentTableTest: public Test, protected TestUtils
+{
+public:
+    ResidentTableTest();
+    ~ResidentTableTest();
+    void test();
+};
+
+#endif // RESIDENTTABLETEST_H
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "sqlscripttest.h"
+
+#include <asyncsqldbwriter.h>
+#include <config.h>
+#include <QSqlQuery>
+
+static const char* testScript = R"(
+-- line comment; with semicolon
+/* block comment; with semicolon
+   on several lines */
+CREATE TABLE ScriptItems (id INTEGER PRIMARY KEY, value TEXT);
+CREATE TABLE ScriptLog (id INTEGER PRIMARY KEY AUTOINCREMENT, message TEXT);
+
+CREATE TRIGGER ScriptItemsInsert AFTER INSERT ON ScriptItems
+BEGIN
+    INSERT INTO ScriptLog (message) VALUES ('inserted; ' || NEW.value);
+    UPDATE ScriptLog SET message = message || CASE WHEN NEW.id > 2 THEN ';' ELSE '' END
+        WHERE id = (SELECT MAX(id) FROM ScriptLog);
+END;
+
+INSERT INTO ScriptItems (value) VALUES ('a;b'); -- trailing comment;
+INSERT INTO ScriptItems (value) VALUES ('it''s -- not a comment');
+INSERT INTO "ScriptItems" (value) /* inline; comment */ VALUES ('/* not a comment; */');
+)";
+
+SqlScriptTest::SqlScriptTest() {
+
+}
+
+SqlScriptTest::~SqlScriptTest() {
+
+}
+
+void SqlScriptTest::test() {
+    const QString scriptPath = testDbPath("SqlScriptTest") + ".sql";
+
+    {
+        QFile script(scriptPath);
+        QVERIFY(script.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        script.write(testScript);
+    }
+
+    {
+        QH::AsyncSqlDBWriter writer;
+        QVERIFY(initTestDb(writer, "SqlScriptTest"));
+        QVERIFY(writer.doSql(scriptPath, true));
+
+        QSqlQuery query;
+        QVERIFY(writer.doQuery("SELECT value FROM ScriptItems ORDER BY id", {}, true, &query));
+
+        QStringList values;
+        while (query.next()) {
+            values.push_back(query.value(0).toString());
+        }
+
+        QVERIFY(values == QStringList({"a;b", "it's -- not a comment", "/* not a comment; */"}));
+
+        // the body of the trigger is one statement.
+        QVERIFY(writer.doQuery("SELECT message FROM ScriptLog ORDER BY id", {}, true, &query));
+
+        QStringList messages;
+        while (query.next()) {
+            messages.push_back(query.value(0).toString());
+        }
+
+        QVERIFY(messages == QStringList({"inserted; a;b",
+                                         "inserted; it's -- not a comment",
+                                         "inserted; /* not a comment; */;"}));
+    }
+
+    QFile::remove(scriptPath);
+    removeTestDb("SqlScriptTest");
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef SQLSCRIPTTEST_H
+#define SQLSCRIPTTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The SqlScriptTest class test splitting of the sql scripts into statements (strings, comments and triggers).
+ */
+class SqlScriptTest: public Test, protected TestUtils
+{
+public:
+    SqlScriptTest();
+    ~SqlScriptTest();
+    void test();
+};
+
+#endif // SQLSCRIPTTEST_H
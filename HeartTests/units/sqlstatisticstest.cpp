@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "sqlstatisticstest.h"
+
+#include <asyncsqldbwriter.h>
+#include <config.h>
+#include <sqlstatistics.h>
+
+SqlStatisticsTest::SqlStatisticsTest() {
+
+}
+
+SqlStatisticsTest::~SqlStatisticsTest() {
+
+}
+
+void SqlStatisticsTest::test() {
+    // literals are replaced, identifiers and placeholders are not changed.
+    QVERIFY(QH::SqlStatistics::normalize("SELECT * FROM  table1\n WHERE id = 10 AND name = 'it''s'") ==
+            "SELECT * FROM table1 WHERE id = ? AND name = ?");
+    QVERIFY(QH::SqlStatistics::normalize("UPDATE users SET value = :value1 WHERE id = 2.5") ==
+            "UPDATE users SET value = :value1 WHERE id = ?");
+    QVERIFY(QH::SqlStatistics::normalize("INSERT INTO t (a, b) VALUES (?, ?), (?, ?), (?, ?)") ==
+            QH::SqlStatistics::normalize("INSERT INTO t (a, b) VALUES (?, ?), (?, ?)"));
+
+    QH::AsyncSqlDBWriter writer;
+    QVERIFY(initTestDb(writer, "SqlStatisticsTest", QVariantMap{
+        {QH_DB_SLOW_QUERY_MSEC, 0},
+        {QH_DB_EXPLAIN_SLOW_QUERIES, true}
+    }));
+
+    QVERIFY(writer.doQuery("CREATE TABLE IF NOT EXISTS Stats (id INTEGER PRIMARY KEY, value INTEGER)", {}, true));
+    writer.resetStatistics();
+
+    for (int i = 0; i < 10; ++i) {
+        QVERIFY(writer.doQuery(QString("INSERT INTO Stats (id, value) VALUES (%0, %1)").arg(i).arg(i * 2), {}, true));
+    }
+
+    QVERIFY(writer.doQueryAsync("SELECT * FROM Stats WHERE value > :value", {{":value", 5}}).result().size() == 7);
+
+    const auto statistics = writer.statistics();
+    QVERIFY(statistics.size() == 2);
+
+    bool insertFound = false;
+    bool selectFound = false;
+    for (const auto& stats: statistics) {
+        QVERIFY(stats.p99Msec <= stats.maxMsec);
+
+        if (stats.statement == "INSERT INTO Stats (id, value) VALUES (?, ?)") {
+            insertFound = true;
+            QVERIFY(stats.count == 10);
+            QVERIFY(stats.rows == 10);
+        } else if (stats.statement == "SELECT * FROM Stats WHERE value > :value") {
+            selectFound = true;
+            QVERIFY(stats.count == 1);
+            QVERIFY(stats.rows == 7);
+        }
+    }
+
+    QVERIFY(insertFound);
+    QVERIFY(selectFound);
+
+    writer.resetStatistics();
+    QVERIFY(writer.statistics().isEmpty());
+}
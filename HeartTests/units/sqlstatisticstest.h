@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef SQLSTATISTICSTEST_H
+#define SQLSTATISTICSTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The SqlStatisticsTest class test the normalization of sql statements and the statistics of the SqlDBWriter.
+ */
+class SqlStatisticsTest: public Test, protected TestUtils
+{
+public:
+    SqlStatisticsTest();
+    ~SqlStatisticsTest();
+    void test();
+};
+
+#endif // SQLSTATISTICSTEST_H
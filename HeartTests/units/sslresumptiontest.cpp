@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "sslresumptiontest.h"
+
+#include <abstractnode.h>
+
+#define LOCAL_TEST_PORT TEST_PORT + 7
+#define RECONNECTS_COUNT 5
+
+#ifdef USE_HEART_SSL
+
+class SslTestNode: public QH::AbstractNode {
+public:
+    using QH::AbstractNode::useSelfSignedSslConfiguration;
+    using QH::AbstractNode::setSslSessionResumptionEnabled;
+    using QH::AbstractNode::sslSessionResumptionsCount;
+
+    NodeType nodeType() const override {
+        return NodeType::Node;
+    };
+};
+
+SslResumptionTest::SslResumptionTest() {
+    _server = new SslTestNode();
+    _client = new SslTestNode();
+}
+
+SslResumptionTest::~SslResumptionTest() {
+    _server->softDelete();
+    _client->softDelete();
+}
+
+void SslResumptionTest::test() {
+    QVERIFY(_server->useSelfSignedSslConfiguration({}));
+    QVERIFY(_client->useSelfSignedSslConfiguration({}));
+
+    QVERIFY(_server->run(TEST_LOCAL_HOST, LOCAL_TEST_PORT));
+
+    // without resumption the client do not save tickets, so all reconnects use the full handshake.
+    QCOMPARE(reconnect(false), 0);
+
+    // with resumption each reconnect uses the ticket of the previous connection.
+    QCOMPARE(reconnect(true), RECONNECTS_COUNT);
+}
+
+int SslResumptionTest::reconnect(bool resumption) {
+    _client->setSslSessionResumptionEnabled(resumption);
+
+    const QH::HostAddress server(TEST_LOCAL_HOST, LOCAL_TEST_PORT);
+    const int resumptions = _client->sslSessionResumptionsCount();
+
+    // first connection of the series receives session ticket.
+    if (!connectFunc(_client, TEST_LOCAL_HOST, LOCAL_TEST_PORT)) {
+        return -1;
+    }
+
+    for (int i = 0; i < RECONNECTS_COUNT; ++i) {
+        _client->removeNode(server);
+        if (!wait([this]() {return _client->confirmendCount() == 0;}, WAIT_RESPOCE_TIME)) {
+            return -1;
+        }
+
+        if (!connectFunc(_client, TEST_LOCAL_HOST, LOCAL_TEST_PORT)) {
+            return -1;
+        }
+    }
+
+    _client->removeNode(server);
+    if (!wait([this]() {return _client->confirmendCount() == 0;}, WAIT_RESPOCE_TIME)) {
+        return -1;
+    }
+
+    return _client->sslSessionResumptionsCount() - resumptions;
+}
+
+#else
+
+SslResumptionTest::SslResumptionTest() {
+
+}
+
+SslResumptionTest::~SslResumptionTest() {
+
+}
+
+void SslResumptionTest::test() {
+
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef SSLRESUMPTIONTEST_H
+#define SSLRESUMPTIONTEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+#ifdef USE_HEART_SSL
+class SslTestNode;
+#endif
+
+/**
+ * @brief The SslResumptionTest class checks that the client reuses session tickets of the server on reconnects over loopback.
+ * @note This test do nothing if the library is built without ssl.
+ */
+class SslResumptionTest: public Test, protected TestUtils
+{
+public:
+    SslResumptionTest();
+    ~SslResumptionTest();
+    void test();
+
+#ifdef USE_HEART_SSL
+private:
+    /**
+     * @brief reconnect This method reconnect client to server several times.
+     * @param resumption enable or disable tls session resumption on client.
+     * @return count of the reconnects that used saved session ticket or -1 if connection failed.
+     */
+    int reconnect(bool resumption);
+
+    SslTestNode *_server = nullptr;
+    SslTestNode *_client = nullptr;
+#endif
+};
+
+#endif // SSLRESUMPTIONTEST_H
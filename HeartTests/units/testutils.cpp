@@ -11,7 +11,10 @@
 #include <QCoreApplication>
 #include <QDateTime>
 #include <QVariantMap>
+#include <QFile>
+#include <QStandardPaths>
 #include <abstractnode.h>
+#include <asyncsqldbwriter.h>
 #include <hostaddress.h>
 
 bool TestUtils::funcPrivateConnect(const std::function<bool()> &requestFunc,
@@ -71,3 +74,25 @@ bool TestUtils::connectFunc(
 
     return funcPrivateConnect(wraper, check, [](){ return QMetaObject::Connection{};});
 }
+
+QString TestUtils::testDbPath(const QString &name) const {
+    return QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/" + name + ".db";
+}
+
+bool TestUtils::initTestDb(QH::AsyncSqlDBWriter &writer, const QString &name, const QVariantMap &params) const {
+    removeTestDb(name);
+
+    QVariantMap config = params;
+    config[QH_DB_DRIVER] = "QSQLITE";
+    config[QH_DB_FILE_PATH] = testDbPath(name);
+
+    return writer.initDb(config);
+}
+
+void TestUtils::removeTestDb(const QString &name) const {
+    const QString path = testDbPath(name);
+
+    QFile::remove(path);
+    QFile::remove(path + "-wal");
+    QFile::remove(path + "-shm");
+}
@@ -12,6 +12,9 @@
 #include <abstractnode.h>
 #include <heart.h>
 
+namespace QH {
+class AsyncSqlDBWriter;
+}
 
 class TestUtils
 {
@@ -31,6 +34,22 @@ public:
     bool funcPrivateConnect(const std::function<bool ()> &requestFunc,
                             const std::function<bool ()> &checkFunc) const;
 
+    /**
+     * @brief testDbPath This method return path of the sqlite database of the test with @a name in the temp directory.
+     */
+    QString testDbPath(const QString& name) const;
+
+    /**
+     * @brief initTestDb This method removes old files of the test database with @a name and opens new sqlite database by the @a writer.
+     * @param params This is additional parameters of the database.
+     */
+    bool initTestDb(QH::AsyncSqlDBWriter& writer, const QString& name, const QVariantMap& params = {}) const;
+
+    /**
+     * @brief removeTestDb This method removes all files of the test database with @a name.
+     */
+    void removeTestDb(const QString& name) const;
+
 };
 
 #endif // TESTUTILS_H
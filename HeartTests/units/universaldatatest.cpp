@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "universaldatatest.h"
+
+#include <universaldata.h>
+
+class UniversalItem: public QH::PKG::UniversalData {
+    QH_PACKAGE("UniversalItem")
+};
+
+UniversalDataTest::UniversalDataTest() {
+
+}
+
+UniversalDataTest::~UniversalDataTest() {
+
+}
+
+void UniversalDataTest::test() {
+    // dense, last dense, sparse and negative keys.
+    const QHash<int, QVariant> hash = {
+        {0, 1},
+        {UNIVERSAL_DATA_DENSE_FIELDS - 1, QString("last dense")},
+        {UNIVERSAL_DATA_DENSE_FIELDS, 2.5},
+        {1000, QStringList{"a", "b"}},
+        {-3, QString("negative")}
+    };
+
+    // the old format (QHash) to the UniversalData.
+    QByteArray hashBytes;
+    {
+        QDataStream stream(&hashBytes, QIODevice::WriteOnly);
+        stream << hash;
+    }
+
+    UniversalItem item;
+    item.setValue(5, "removed on read");
+    {
+        QDataStream stream(&hashBytes, QIODevice::ReadOnly);
+        stream >> item;
+        QVERIFY(stream.status() == QDataStream::Ok);
+        QVERIFY(stream.atEnd());
+    }
+
+    QVERIFY(!item.contains(5));
+    QVERIFY(item.keys().size() == hash.size());
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+        QVERIFY(item.contains(it.key()));
+        QVERIFY(item.value(it.key()) == it.value());
+    }
+
+    // the UniversalData to the old format.
+    QByteArray itemBytes;
+    {
+        QDataStream stream(&itemBytes, QIODevice::WriteOnly);
+        stream << item;
+    }
+
+    QHash<int, QVariant> result;
+    {
+        QDataStream stream(&itemBytes, QIODevice::ReadOnly);
+        stream >> result;
+        QVERIFY(stream.status() == QDataStream::Ok);
+        QVERIFY(stream.atEnd());
+    }
+
+    QVERIFY(result == hash);
+    QVERIFY(itemBytes.size() == hashBytes.size());
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef UNIVERSALDATATEST_H
+#define UNIVERSALDATATEST_H
+
+#include "test.h"
+#include "testutils.h"
+
+#include <QtTest>
+
+/**
+ * @brief The UniversalDataTest class test that the UniversalData keeps stream format of the QHash<int, QVariant> for dense and sparse fields.
+ */
+class UniversalDataTest: public Test, protected TestUtils
+{
+public:
+    UniversalDataTest();
+    ~UniversalDataTest();
+    void test();
+};
+
+#endif // UNIVERSALDATATEST_H
@@ -34,6 +34,19 @@ public:
         return ver == version;
     }
 
+    int batchRows() {
+        QSqlQuery query;
+        if (!db()->doQuery("SELECT COUNT(*) FROM BatchData", {},  true, &query)){
+            return -1;
+        };
+
+        if (!query.next()) {
+            return -1;
+        }
+
+        return query.value(0).toInt();
+    }
+
 protected:
 
     void initDBPatches() {
@@ -77,7 +90,109 @@ protected:
                            return true;
                        }
                    });
+
+        QH::DBPatch batchPatch;
+        batchPatch.versionFrom = 3;
+        batchPatch.versionTo = 4;
+        batchPatch.action = [](const QH::iObjectProvider* database) -> bool {
+            return database->doQuery("CREATE TABLE IF NOT EXISTS BatchData (id INTEGER PRIMARY KEY, batch INT)", {}, true);
+        };
+
+        // streaming migration with 3 batches of 10 rows.
+        batchPatch.batchAction = [](const QH::iObjectProvider* database, int batch) -> int {
+            if (batch >= 3) {
+                return 0;
+            }
+
+            for (int i = 0; i < 10; ++i) {
+                if (!database->doQuery("INSERT INTO BatchData (batch) VALUES (:batch)", {{":batch", batch}}, true)) {
+                    return -1;
+                }
+            }
+
+            return 10;
+        };
+
+        addDBPatch(batchPatch);
+    }
+};
+
+// the database with the patch that fails after writing of the data.
+class FailingDatabase: public QH::DataBase {
+
+public:
+    FailingDatabase(const QString& path, bool batch): _path(path) {
+        if (batch) {
+            initBatchPatch();
+        } else {
+            initPatch();
+        }
+    }
+
+    int count(const QString& request) {
+        QSqlQuery query;
+        if (!db()->doQuery(request, {}, true, &query) || !query.next()) {
+            return -1;
+        }
+
+        return query.value(0).toInt();
+    }
+
+    bool fail = true;
+
+protected:
+    QVariantMap defaultDbParams() const override {
+        auto params = QH::DataBase::defaultDbParams();
+        params[QH_DB_FILE_PATH] = _path;
+        params[QH_DB_BACKUP_PATH] = _path + "_BackUp";
+        return params;
+    }
+
+private:
+    void initPatch() {
+        addDBPatch({
+                       0, // from version
+                       1, // to version
+                       [](const QH::iObjectProvider* database) -> bool {
+                           database->doQuery("CREATE TABLE PatchData (value INT)", {}, true);
+                           database->doQuery("INSERT INTO PatchData (value) VALUES (1)", {}, true);
+
+                           return false;
+                       }
+                   });
+    }
+
+    void initBatchPatch() {
+        QH::DBPatch patch;
+        patch.versionFrom = 0;
+        patch.versionTo = 1;
+        patch.action = [](const QH::iObjectProvider* database) -> bool {
+            return database->doQuery("CREATE TABLE IF NOT EXISTS BatchData (value INT)", {}, true);
+        };
+
+        // the second batch fails after writing of the half of rows.
+        patch.batchAction = [this](const QH::iObjectProvider* database, int batch) -> int {
+            if (batch >= 3) {
+                return 0;
+            }
+
+            for (int i = 0; i < 10; ++i) {
+                if (fail && batch == 1 && i == 5) {
+                    return -1;
+                }
+
+                if (!database->doQuery("INSERT INTO BatchData (value) VALUES (:value)", {{":value", batch * 10 + i}}, true)) {
+                    return -1;
+                }
+            }
+
+            return 10;
+        };
+
+        addDBPatch(patch);
     }
+
+    QString _path;
 };
 
 UpgradeDataBaseTest::UpgradeDataBaseTest() {
@@ -91,7 +206,8 @@ void UpgradeDataBaseTest::test() {
     QVERIFY(db->run("UpgradeDBTest"));
     QuasarAppUtils::Params::log("Run DataBase finished successful", QuasarAppUtils::Info);
 
-    QVERIFY(db->checkVersion(3));
+    QVERIFY(db->checkVersion(4));
+    QVERIFY(db->batchRows() == 30);
     QuasarAppUtils::Params::log("Version is valid", QuasarAppUtils::Info);
 
     db->stop();
@@ -102,6 +218,50 @@ void UpgradeDataBaseTest::test() {
 
     delete db;
 
+    testFailedPatch();
+    testFailedBatch();
+
     QuasarAppUtils::Params::log("The UpgradeDataBaseTest test passed.", QuasarAppUtils::Info);
 
 }
+
+void UpgradeDataBaseTest::testFailedPatch() {
+    const QString name = "UpgradeDBFailedPatchTest";
+    removeTestDb(name);
+
+    auto db = new FailingDatabase(testDbPath(name), false);
+
+    // the written data and the version are rolled back together.
+    QVERIFY(!db->run(name));
+    QVERIFY(db->count("SELECT COUNT(*) FROM sqlite_master WHERE name='PatchData'") == 0);
+    QVERIFY(db->count("SELECT COUNT(*) FROM DataBaseAttributes WHERE name='version' AND value=1") == 0);
+
+    delete db;
+    removeTestDb(name);
+    QDir(testDbPath(name) + "_BackUp").removeRecursively();
+}
+
+void UpgradeDataBaseTest::testFailedBatch() {
+    const QString name = "UpgradeDBFailedBatchTest";
+    removeTestDb(name);
+
+    auto db = new FailingDatabase(testDbPath(name), true);
+
+    // the first batch is saved, the rows of the failed batch are rolled back.
+    QVERIFY(!db->run(name));
+    QVERIFY(db->count("SELECT COUNT(*) FROM BatchData") == 10);
+    QVERIFY(db->count("SELECT COUNT(*) FROM DataBaseAttributes WHERE name='version' AND value=1") == 0);
+
+    // the upgrade continues from the failed batch, so rows are not duplicated.
+    db->stop();
+    db->fail = false;
+    QVERIFY(db->run(name));
+    QVERIFY(db->count("SELECT COUNT(*) FROM BatchData") == 30);
+    QVERIFY(db->count("SELECT COUNT(DISTINCT value) FROM BatchData") == 30);
+    QVERIFY(db->count("SELECT COUNT(*) FROM DataBaseUpgradeProgress") == 0);
+    QVERIFY(db->count("SELECT COUNT(*) FROM DataBaseAttributes WHERE name='version' AND value=1") == 1);
+
+    delete db;
+    removeTestDb(name);
+    QDir(testDbPath(name) + "_BackUp").removeRecursively();
+}
@@ -11,6 +11,10 @@ public:
     // Test interface
 public:
     void test();
+
+private:
+    void testFailedPatch();
+    void testFailedBatch();
 };
 
 #endif // UPGRADEDATABASETEST_H
@@ -13,15 +13,32 @@
 #include <bigdatarequest.h>
 #include <closeconnection.h>
 #include <ping.h>
+#include <bigdatapart.h>
+#include <bigdataheader.h>
+#include <bigdatawraper.h>
+#include "apiversion.h"
+#include "versionisreceived.h"
 
 namespace QH {
 
+// all system packages are parsed by the same node, so their commands should not collide with each other.
+static_assert(PKG::uniqueCommands<PKG::Ping,
+                                  PKG::BadRequest,
+                                  PKG::CloseConnection,
+                                  PKG::BigDataWraper,
+                                  PKG::BigDataRequest,
+                                  PKG::BigDataHeader,
+                                  PKG::BigDataPart,
+                                  PKG::APIVersion,
+                                  PKG::VersionIsReceived>(),
+              "The commands of the system packages are collided.");
+
 AbstractNodeParser::AbstractNodeParser(AbstractNode* parentNode): iParser(parentNode) {
     debug_assert(parentNode, "Node object can't be null!");
 
-    registerPackageType<PKG::Ping>();
-    registerPackageType<PKG::BadRequest>();
-    registerPackageType<PKG::CloseConnection>();
+    registerPackageTypes<PKG::Ping,
+                         PKG::BadRequest,
+                         PKG::CloseConnection>();
 }
 
 AbstractNodeParser::~AbstractNodeParser() {
@@ -26,7 +26,7 @@ class APIVersion: public QH::PKG::AbstractData
 public:
     APIVersion();
 
-    static unsigned short command(){return PROTOCKOL_VERSION_COMMAND;}
+    static constexpr unsigned short command(){return PROTOCKOL_VERSION_COMMAND;}
     static unsigned short version(){return 0;}
 
     static QString commandText(){return "PROTOCKOL_VERSION_COMMAND";}
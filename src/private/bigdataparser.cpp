@@ -14,6 +14,7 @@
 #include <cmath>
 #include <params.h>
 #include <bigdatawraper.h>
+#include <heartlog.h>
 
 #define TIMEOUT_INTERVAL 30000
 
@@ -21,10 +22,10 @@ namespace QH {
 
 BigDataParser::BigDataParser(AbstractNode* parentNode): iParser(parentNode) {
 
-    registerPackageType<PKG::BigDataWraper>();
-    registerPackageType<PKG::BigDataRequest>();
-    registerPackageType<PKG::BigDataHeader>();
-    registerPackageType<PKG::BigDataPart>();
+    registerPackageTypes<PKG::BigDataWraper,
+                         PKG::BigDataRequest,
+                         PKG::BigDataHeader,
+                         PKG::BigDataPart>();
 
 }
 
@@ -95,7 +96,7 @@ bool BigDataParser::newPackage(const QSharedPointer<PKG::BigDataHeader> &header,
     request.setCurrentPart(0);
     request.setPackageId(header->packageId());
 
-    qDebug() << "Receive BigData Header:" << header->toString();
+    qhDebug() << "Receive BigData Header:" << header->toString();
 
     return node()->sendData(&request, sender, &hdr);
 }
@@ -112,7 +113,7 @@ bool BigDataParser::processPart(const QSharedPointer<PKG::BigDataPart> &part,
 
     auto& localPool = _pool[part->packageId()];
 
-    qDebug () << "Process Part of" << part->packageId() << ": part" << part->getPakckageNumber() << "/" << localPool.chaindata.size() - 1;
+    qhDebug() << "Process Part of" << part->packageId() << ": part" << part->getPakckageNumber() << "/" << localPool.chaindata.size() - 1;
 
     localPool.chaindata[part->getPakckageNumber()] = part;
 
@@ -164,7 +165,7 @@ bool BigDataParser::processRequest(const QSharedPointer<PKG::BigDataRequest> &re
     unsigned int id = request->packageId();
 
     if (!_pool.contains(id)) {
-        qDebug() << "requested data is missing!";
+        qhLimited(Debug) << "requested data is missing!";
         return false;
     }
 
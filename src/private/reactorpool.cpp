@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#include "reactorpool.h"
+#include "asynclauncher.h"
+#include "datasender.h"
+
+#include <QThread>
+#include <algorithm>
+
+namespace QH {
+
+ReactorPool::ReactorPool(int count) {
+    if (count < 1) {
+        count = QThread::idealThreadCount();
+    }
+
+    count = std::max(count, 1);
+
+    _reactors.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Reactor reactor;
+        reactor.thread = new QThread();
+        reactor.thread->setObjectName(QString("Sender_%0").arg(i));
+        reactor.thread->start();
+
+        // This objects moving to the reactor thread.
+        reactor.sender = new DataSender(reactor.thread);
+        reactor.launcher = new AsyncLauncher(reactor.thread);
+        reactor.connections = QSharedPointer<QAtomicInt>::create(0);
+
+        _reactors.push_back(reactor);
+    }
+}
+
+ReactorPool::~ReactorPool() {
+    for (auto& reactor: _reactors) {
+        reactor.thread->quit();
+    }
+
+    for (auto& reactor: _reactors) {
+        reactor.thread->wait();
+
+        delete reactor.sender;
+        delete reactor.launcher;
+        delete reactor.thread;
+    }
+
+    _reactors.clear();
+}
+
+int ReactorPool::size() const {
+    return _reactors.size();
+}
+
+int ReactorPool::acquire() {
+    int result = 0;
+    int minConnections = _reactors[0].connections->loadAcquire();
+
+    for (int i = 1; i < _reactors.size(); ++i) {
+        const int connections = _reactors[i].connections->loadAcquire();
+        if (connections < minConnections) {
+            minConnections = connections;
+            result = i;
+        }
+    }
+
+    _reactors[result].connections->ref();
+
+    return result;
+}
+
+void ReactorPool::bind(int reactor, QObject *socket) {
+    if (!socket || reactor < 0 || reactor >= _reactors.size()) {
+        return;
+    }
+
+    // the counter is shared pointer because the socket can be destroyed after the pool.
+    auto connections = _reactors[reactor].connections;
+    QObject::connect(socket, &QObject::destroyed, [connections]() {
+        connections->deref();
+    });
+}
+
+void ReactorPool::release(int reactor) {
+    if (reactor < 0 || reactor >= _reactors.size()) {
+        return;
+    }
+
+    _reactors[reactor].connections->deref();
+}
+
+int ReactorPool::connectionsCount(int reactor) const {
+    if (reactor < 0 || reactor >= _reactors.size()) {
+        return 0;
+    }
+
+    return _reactors[reactor].connections->loadAcquire();
+}
+
+AsyncLauncher *ReactorPool::launcher(int reactor) const {
+    if (reactor < 0 || reactor >= _reactors.size()) {
+        return nullptr;
+    }
+
+    return _reactors[reactor].launcher;
+}
+
+AsyncLauncher *ReactorPool::launcherOf(const QObject *socket) const {
+    return reactorOf(socket).launcher;
+}
+
+DataSender *ReactorPool::senderOf(const QObject *socket) const {
+    return reactorOf(socket).sender;
+}
+
+const ReactorPool::Reactor &ReactorPool::reactorOf(const QObject *socket) const {
+    if (socket) {
+        const QThread* thread = socket->thread();
+        for (const auto& reactor: _reactors) {
+            if (reactor.thread == thread) {
+                return reactor;
+            }
+        }
+    }
+
+    return _reactors.first();
+}
+
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#ifndef REACTORPOOL_H
+#define REACTORPOOL_H
+
+#include <QAtomicInt>
+#include <QSharedPointer>
+#include <QVector>
+
+class QObject;
+class QThread;
+
+namespace QH {
+
+class DataSender;
+class AsyncLauncher;
+
+/**
+ * @brief The ReactorPool class contains the io threads (reactors) of the node.
+ * Each socket lives on one reactor for all its life, so all reads, writes and encryption of the socket work in one thread,
+ * but different sockets work in parallel. New connections are assigned to the reactor with the least count of connections.
+ * Each reactor has own DataSender and AsyncLauncher objects.
+ */
+class ReactorPool
+{
+public:
+    /**
+     * @brief ReactorPool This constructor create and start the @a count io threads.
+     * @param count This is count of io threads. if this value less then 1 then will be used QThread::idealThreadCount.
+     */
+    ReactorPool(int count);
+    ~ReactorPool();
+
+    /**
+     * @brief size This method return count of reactors.
+     * @return count of reactors.
+     */
+    int size() const;
+
+    /**
+     * @brief acquire This method select reactor with the least count of connections and reserve one connection on it.
+     * @return index of the selected reactor.
+     * @note invoke the ReactorPool::bind method after creating socket for release reservation after destroying of the socket.
+     */
+    int acquire();
+
+    /**
+     * @brief bind This method bind the @a socket to the @a reactor. The connection of the reactor will be released when the socket is destroyed.
+     * @param reactor This is index of the reactor that returned by the ReactorPool::acquire method.
+     * @param socket This is socket object.
+     */
+    void bind(int reactor, QObject* socket);
+
+    /**
+     * @brief release This method release reservation of the connection if socket was not created.
+     * @param reactor This is index of the reactor.
+     */
+    void release(int reactor);
+
+    /**
+     * @brief connectionsCount This method return count of connections of the @a reactor.
+     * @param reactor This is index of the reactor.
+     * @return count of connections.
+     */
+    int connectionsCount(int reactor) const;
+
+    /**
+     * @brief launcher This method return the AsyncLauncher object of the @a reactor.
+     * @param reactor This is index of the reactor.
+     * @return launcher of the reactor.
+     */
+    AsyncLauncher* launcher(int reactor) const;
+
+    /**
+     * @brief launcherOf This method return the AsyncLauncher object of the reactor that own the @a socket.
+     * @param socket This is socket object.
+     * @return launcher of the reactor. If the socket do not belongs any reactors then return launcher of the first reactor.
+     */
+    AsyncLauncher* launcherOf(const QObject* socket) const;
+
+    /**
+     * @brief senderOf This method return the DataSender object of the reactor that own the @a socket.
+     * @param socket This is socket object.
+     * @return sender of the reactor. If the socket do not belongs any reactors then return sender of the first reactor.
+     */
+    DataSender* senderOf(const QObject* socket) const;
+
+private:
+    struct Reactor {
+        QThread *thread = nullptr;
+        DataSender *sender = nullptr;
+        AsyncLauncher *launcher = nullptr;
+        QSharedPointer<QAtomicInt> connections;
+    };
+
+    const Reactor& reactorOf(const QObject* socket) const;
+
+    QVector<Reactor> _reactors;
+};
+
+}
+#endif // REACTORPOOL_H
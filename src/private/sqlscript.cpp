@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#include "sqlscript.h"
+
+#include <QStringList>
+
+namespace QH {
+
+namespace {
+
+bool isWordChar(QChar c) {
+    return c.isLetterOrNumber() || c == '_';
+}
+
+QString firstWord(const QString& statement) {
+    int begin = 0;
+    while (begin < statement.size() && !isWordChar(statement[begin])) {
+        ++begin;
+    }
+
+    int end = begin;
+    while (end < statement.size() && isWordChar(statement[end])) {
+        ++end;
+    }
+
+    return statement.mid(begin, end - begin).toUpper();
+}
+
+}
+
+QList<SqlStatement> SqlScript::parse(const QString &script) {
+    QList<SqlStatement> result;
+
+    QString current;
+    int line = 1;
+    int startLine = 1;
+
+    // the first words of the statement, used for detection of the triggers.
+    QStringList head;
+    bool trigger = false;
+    int depth = 0;
+
+    auto finish = [&]() {
+        const QString text = current.trimmed();
+        if (!text.isEmpty()) {
+            result.push_back({text, startLine});
+        }
+
+        current.clear();
+        head.clear();
+        trigger = false;
+        depth = 0;
+    };
+
+    auto append = [&](const QString& text) {
+        if (current.trimmed().isEmpty() && !text.trimmed().isEmpty()) {
+            startLine = line;
+        }
+
+        current += text;
+    };
+
+    const int size = script.size();
+    int i = 0;
+    while (i < size) {
+        const QChar c = script[i];
+        const QChar next = (i + 1 < size)? script[i + 1] : QChar();
+
+        // line comment
+        if (c == '-' && next == '-') {
+            while (i < size && script[i] != '\n') {
+                ++i;
+            }
+            continue;
+        }
+
+        // block comment
+        if (c == '/' && next == '*') {
+            i += 2;
+            while (i < size && !(script[i] == '*' && i + 1 < size && script[i + 1] == '/')) {
+                if (script[i] == '\n') {
+                    ++line;
+                }
+                ++i;
+            }
+            i += 2;
+            current += ' ';
+            continue;
+        }
+
+        // quoted strings and identifiers
+        if (c == '\'' || c == '"' || c == '`' || c == '[') {
+            const QChar close = (c == '[')? QChar(']') : c;
+            const int quoteLine = line;
+            int end = i + 1;
+            while (end < size) {
+                if (script[end] == '\n') {
+                    ++line;
+                }
+
+                if (script[end] == close) {
+                    // doubled quote is escaped quote.
+                    if (close != ']' && end + 1 < size && script[end + 1] == close) {
+                        end += 2;
+                        continue;
+                    }
+                    break;
+                }
+                ++end;
+            }
+
+            const int newLines = line;
+            line = quoteLine;
+            append(script.mid(i, end - i + 1));
+            line = newLines;
+
+            i = end + 1;
+            continue;
+        }
+
+        if (isWordChar(c)) {
+            int end = i;
+            while (end < size && isWordChar(script[end])) {
+                ++end;
+            }
+
+            const QString word = script.mid(i, end - i);
+            append(word);
+
+            const QString upper = word.toUpper();
+            if (head.size() < 4) {
+                head.push_back(upper);
+
+                trigger = (head.size() >= 2 && head[0] == "CREATE" &&
+                           (head[1] == "TRIGGER" ||
+                            (head.size() >= 3 && (head[1] == "TEMP" || head[1] == "TEMPORARY") && head[2] == "TRIGGER")));
+            }
+
+            if (trigger) {
+                if (upper == "BEGIN" || upper == "CASE") {
+                    ++depth;
+                } else if (upper == "END" && depth > 0) {
+                    --depth;
+                }
+            }
+
+            i = end;
+            continue;
+        }
+
+        if (c == ';' && depth == 0) {
+            finish();
+            ++i;
+            continue;
+        }
+
+        if (c == '\n') {
+            ++line;
+        }
+
+        append(c);
+        ++i;
+    }
+
+    finish();
+
+    return result;
+}
+
+bool SqlScript::canRunInTransaction(const QList<SqlStatement> &statements) {
+    static const QStringList forbidden = {"BEGIN", "COMMIT", "END", "ROLLBACK",
+                                          "SAVEPOINT", "RELEASE", "VACUUM", "PRAGMA",
+                                          "ATTACH", "DETACH"};
+
+    for (const auto& statement: statements) {
+        if (forbidden.contains(firstWord(statement.text))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#ifndef SQLSCRIPT_H
+#define SQLSCRIPT_H
+
+#include <QList>
+#include <QString>
+
+namespace QH {
+
+/**
+ * @brief The SqlStatement struct is one statement of the sql script.
+ */
+struct SqlStatement {
+    /// text of the statement without comments and the last semicolon.
+    QString text;
+    /// number of the first line of the statement in the script.
+    int line = 0;
+};
+
+/**
+ * @brief The SqlScript class splits sql scripts into statements.
+ * The parser skips comments (-- and / * * /), do not split quoted strings and identifiers ('', "", ``, [])
+ *  and bodies of the triggers (CREATE TRIGGER ... BEGIN ... END;).
+ */
+class SqlScript
+{
+public:
+    /**
+     * @brief parse This method splits the @a script into statements.
+     * @param script This is source code of the sql script.
+     * @return list of statements.
+     */
+    static QList<SqlStatement> parse(const QString& script);
+
+    /**
+     * @brief canRunInTransaction This method return true if all @a statements can be executed in one transaction.
+     *  Scripts with own transactions, VACUUM and PRAGMA statements should be executed without transaction.
+     * @param statements This is list of statements.
+     * @return true if all statements can be executed in one transaction.
+     */
+    static bool canRunInTransaction(const QList<SqlStatement>& statements);
+};
+
+}
+#endif // SQLSCRIPT_H
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#include "sslsessioncache.h"
+
+#ifdef USE_HEART_SSL
+
+#include <QMutexLocker>
+
+namespace QH {
+
+SslSessionCache::SslSessionCache(int limit):
+    _limit(limit) {
+
+}
+
+QByteArray SslSessionCache::ticket(const HostAddressKey &peer) const {
+    QMutexLocker locker(&_mutex);
+
+    auto it = _tickets.constFind(peer);
+    if (it == _tickets.constEnd()) {
+        return {};
+    }
+
+    ++_hits;
+    return it.value();
+}
+
+void SslSessionCache::insert(const HostAddressKey &peer, const QByteArray &ticket) {
+    QMutexLocker locker(&_mutex);
+
+    if (ticket.isEmpty()) {
+        _tickets.remove(peer);
+        return;
+    }
+
+    // tickets are cheap for recreate, so just drop one random ticket when cache is full.
+    if (_limit > 0 && _tickets.size() >= _limit && !_tickets.contains(peer)) {
+        _tickets.erase(_tickets.begin());
+    }
+
+    _tickets.insert(peer, ticket);
+}
+
+void SslSessionCache::remove(const HostAddressKey &peer) {
+    QMutexLocker locker(&_mutex);
+    _tickets.remove(peer);
+}
+
+void SslSessionCache::clear() {
+    QMutexLocker locker(&_mutex);
+    _tickets.clear();
+}
+
+int SslSessionCache::size() const {
+    QMutexLocker locker(&_mutex);
+    return _tickets.size();
+}
+
+int SslSessionCache::hits() const {
+    QMutexLocker locker(&_mutex);
+    return _hits;
+}
+
+}
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#ifndef SSLSESSIONCACHE_H
+#define SSLSESSIONCACHE_H
+
+#include "heart_global.h"
+
+#ifdef USE_HEART_SSL
+
+#include "hostaddresskey.h"
+#include "config.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+
+namespace QH {
+
+/**
+ * @brief The SslSessionCache class contains tls session tickets of the remote servers.
+ * The client side of the node reuses the ticket of the server on the next connection,
+ * so the reconnect do not requires a full asymmetric handshake.
+ * @note This class is thread safe.
+ */
+class SslSessionCache
+{
+public:
+    SslSessionCache(int limit = SSL_SESSION_CACHE_SIZE);
+
+    /**
+     * @brief ticket This method return saved session ticket of the @a peer.
+     *  Each found ticket increments the hits counter.
+     * @param peer This is address of the server.
+     * @return session ticket or empty array if the ticket is not found.
+     */
+    QByteArray ticket(const HostAddressKey& peer) const;
+
+    /**
+     * @brief insert This method save the session @a ticket of the @a peer.
+     * @param peer This is address of the server.
+     * @param ticket This is session ticket. The empty ticket will remove old ticket of the peer.
+     */
+    void insert(const HostAddressKey& peer, const QByteArray& ticket);
+
+    /**
+     * @brief remove This method remove session ticket of the @a peer. Use this method when the session is rejected by server.
+     * @param peer This is address of the server.
+     */
+    void remove(const HostAddressKey& peer);
+
+    /**
+     * @brief clear This method remove all tickets.
+     */
+    void clear();
+
+    /**
+     * @brief size This method return count of saved tickets.
+     * @return count of saved tickets.
+     */
+    int size() const;
+
+    /**
+     * @brief hits This method return count of the found tickets, so it is count of the connections that tried to resume the session.
+     *  The counter is not reset by the clear method.
+     * @return count of the found tickets.
+     */
+    int hits() const;
+
+private:
+    QHash<HostAddressKey, QByteArray> _tickets;
+    int _limit = 0;
+    mutable int _hits = 0;
+    mutable QMutex _mutex;
+};
+
+}
+#endif
+#endif // SSLSESSIONCACHE_H
@@ -24,7 +24,7 @@ public:
     VersionIsReceived();
     static unsigned short version(){return 0;}
 
-    static unsigned short command(){return PROTOCKOL_VERSION_RECEIVED_COMMAND;}
+    static constexpr unsigned short command(){return PROTOCKOL_VERSION_RECEIVED_COMMAND;}
     static QString commandText(){return "PROTOCKOL_VERSION_RECEIVED_COMMAND";}
     unsigned short cmd() const override {return VersionIsReceived::command();}
     QString cmdString() const override {return VersionIsReceived::commandText();}
@@ -10,6 +10,11 @@
 #include "ping.h"
 #include "workstate.h"
 #include <QHostInfo>
+#include <dnsresolver.h>
+#include <admissioncontroller.h>
+#include <confirmtimeouts.h>
+#include <reactorpool.h>
+#include <packagemanager.h>
 
 #include <badrequest.h>
 #include <quasarapp.h>
@@ -18,6 +23,7 @@
 #ifdef USE_HEART_SSL
 
 #include <sslsocket.h>
+#include <sslsessioncache.h>
 #include <easyssl/x509.h>
 #include <easyssl/rsassl.h>
 
@@ -25,10 +31,17 @@
 #include <QSslCertificate>
 #include <QSslKey>
 #include <QSslSocket>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QCryptographicHash>
 
 #endif
 
 #include <QMetaObject>
+#include <QPointer>
+#include <QThread>
 #include <QtConcurrent>
 #include <closeconnection.h>
 #include "tcpsocket.h"
@@ -39,6 +52,7 @@
 #include <apiversion.h>
 #include <versionisreceived.h>
 #include <taskscheduler.h>
+#include <heartlog.h>
 #include <qaglobalutils.h>
 #include <bigdatawraper.h>
 #include <bigdataparser.h>
@@ -54,16 +68,14 @@ AbstractNode::AbstractNode( QObject *ptr):
 
     initThreadId();
 
-    _senderThread = new QThread();
-    _senderThread->setObjectName("Sender");
-
-    _senderThread->start();
-
-    // This object moving to _senderThread.
-    _dataSender = new DataSender(_senderThread);
-    _socketWorker = new AsyncLauncher(_senderThread);
+    _reactors = new ReactorPool(IO_THREADS_COUNT);
     _tasksheduller = new TaskScheduler();
     _apiVersionParser = new APIVersionParser(this);
+    _admission = new AdmissionController();
+    _confirmTimeouts = new ConfirmTimeouts();
+#ifdef USE_HEART_SSL
+    _sslSessions = new SslSessionCache();
+#endif
 
     addApiParser<BigDataParser>();
 
@@ -82,6 +94,11 @@ AbstractNode::AbstractNode( QObject *ptr):
     connect(_tasksheduller, &TaskScheduler::sigPushWork,
             this, &AbstractNode::handleBeginWork);
 
+    connect(_confirmTimeouts, &ConfirmTimeouts::sigTimeout,
+            this, [this](const HostAddressKey& key) {
+        checkConfirmendOfNode(getInfoPtr(key.toHostAddress()));
+    });
+
 
     initThreadPool();
 
@@ -89,8 +106,8 @@ AbstractNode::AbstractNode( QObject *ptr):
 
 AbstractNode::~AbstractNode() {
 
-    _senderThread->quit();
-    _senderThread->wait();
+    // stops all io threads.
+    delete _reactors;
 
     for (auto it: std::as_const(_receiveData)) {
         delete  it;
@@ -98,11 +115,13 @@ AbstractNode::~AbstractNode() {
 
     _receiveData.clear();
 
-    delete _dataSender;
-    delete _senderThread;
-    delete _socketWorker;
     delete _tasksheduller;
     delete _apiVersionParser;
+    delete _admission;
+    delete _confirmTimeouts;
+#ifdef USE_HEART_SSL
+    delete _sslSessions;
+#endif
 }
 
 bool AbstractNode::run(const QString &addres, unsigned short port) {
@@ -204,7 +223,10 @@ void AbstractNode::unBan(const HostAddress &target) {
 
 bool AbstractNode::addNode(const HostAddress &address) {
 
-    AsyncLauncher::Job action = [this, address]() -> bool {
+    lockReactors();
+
+    const int reactor = _reactors->acquire();
+    AsyncLauncher::Job action = [this, address, reactor]() -> bool {
         QAbstractSocket *socket;
 #ifdef USE_HEART_SSL
         if (_mode == SslMode::NoSSL) {
@@ -216,6 +238,7 @@ bool AbstractNode::addNode(const HostAddress &address) {
 #else
         socket = new TcpSocket(nullptr);
 #endif
+        _reactors->bind(reactor, socket);
 
         if (!registerSocket(socket, &address)) {
             addNodeFailed(AddNodeError::RegisterSocketFailed);
@@ -228,7 +251,19 @@ bool AbstractNode::addNode(const HostAddress &address) {
         return true;
     };
 
-    return _socketWorker->run(action);
+    auto launcher = _reactors->launcher(reactor);
+
+    // the job invoked on the reactor thread runs immediately and releases the reactor by itself if failed.
+    if (launcher->thread() == QThread::currentThread()) {
+        return launcher->run(action);
+    }
+
+    if (!launcher->run(action)) {
+        _reactors->release(reactor);
+        return false;
+    }
+
+    return true;
 }
 
 bool AbstractNode::addNode(const HostAddress &address,
@@ -252,29 +287,33 @@ bool AbstractNode::addNode(const QString &domain, unsigned short port,
     HostAddress address{domain, port};
     if (address.isNull()) {
 
-        QHostInfo::lookupHost(domain, [this, port, domain, action, status](QHostInfo info) {
-
-            if (info.error() != QHostInfo::NoError) {
-
-                qCritical() << "The domain name :" + domain +
-                               " has error: " + info.errorString();
-                addNodeFailed(AddNodeError::HostNotFound);
-                return;
-            }
+        // The resolver invokes callbacks on the thread of the lookup,
+        // so the result moves to the thread of this node before using.
+        QPointer<AbstractNode> self = this;
+        DnsResolver::instance()->resolve(domain, [self, port, domain, action, status](const QHostInfo& info) {
+            QMetaObject::invokeMethod(self, [self, port, domain, action, status, info]() {
+                if (!self) {
+                    return;
+                }
 
-            auto addresses = info.addresses();
+                if (info.error() != QHostInfo::NoError) {
 
-            if (addresses.size() > 1) {
-                qWarning() << "The domain name :" + domain +
-                              " has more 1 ip addresses.";
-            }
+                    qCritical() << "The domain name :" + domain +
+                                   " has error: " + info.errorString();
+                    self->addNodeFailed(AddNodeError::HostNotFound);
+                    return;
+                }
 
-            if (action) {
-                addNode(HostAddress{addresses.first(), port}, action, status);
-            } else {
-                addNode(HostAddress{addresses.first(), port});
-            }
+                // The resolver rotates addresses of the host on each request,
+                // so the first address is the next address of the round-robin.
+                auto addresses = info.addresses();
 
+                if (action) {
+                    self->addNode(HostAddress{addresses.first(), port}, action, status);
+                } else {
+                    self->addNode(HostAddress{addresses.first(), port});
+                }
+            }, Qt::QueuedConnection);
         });
 
 
@@ -330,15 +369,96 @@ QSslConfiguration AbstractNode::selfSignedSslConfiguration(const EasySSL::SslSrt
     QSslKey pkey;
     QSslCertificate crt;
 
-    EasySSL::X509 generator(QSharedPointer<EasySSL::RSASSL>::create());
-    EasySSL::SelfSignedSertificate certificate = generator.create(sslData);
-    res.setPrivateKey(certificate.key);
-    res.setLocalCertificate(certificate.crt);
+    // certificates with different data are saved into different files.
+    const QString cacheKey = QCryptographicHash::hash(
+                                 QString("%0\n%1\n%2\n%3").
+                                 arg(sslData.country, sslData.organization, sslData.commonName).
+                                 arg(sslData.endTime).toUtf8(),
+                                 QCryptographicHash::Sha256).toHex().left(16);
+
+    // generation of the rsa key is very slow, so reuse the certificate from previous runs.
+    if (!loadSslCertificateCache(cacheKey, &crt, &pkey)) {
+        EasySSL::X509 generator(QSharedPointer<EasySSL::RSASSL>::create());
+        EasySSL::SelfSignedSertificate certificate = generator.create(sslData);
+        crt = certificate.crt;
+        pkey = certificate.key;
+
+        if (!saveSslCertificateCache(cacheKey, crt, pkey)) {
+            qWarning() << "Failed to save the self signed certificate into cache.";
+        }
+    }
+
+    res.setPrivateKey(pkey);
+    res.setLocalCertificate(crt);
     res.setPeerVerifyMode(QSslSocket::VerifyNone);
 
     return res;
 }
 
+QString AbstractNode::sslCertificateCachePath() const {
+    return DEFAULT_SSL_CACHE_PATH;
+}
+
+bool AbstractNode::loadSslCertificateCache(const QString &cacheKey, QSslCertificate *crt, QSslKey *key) const {
+    const QString path = sslCertificateCachePath();
+    if (path.isEmpty() || !(crt && key)) {
+        return false;
+    }
+
+    QFile crtFile(path + "/" + cacheKey + "_" + SSL_CACHE_CERTIFICATE);
+    QFile keyFile(path + "/" + cacheKey + "_" + SSL_CACHE_KEY);
+
+    if (!(crtFile.open(QIODevice::ReadOnly) && keyFile.open(QIODevice::ReadOnly))) {
+        return false;
+    }
+
+    *crt = QSslCertificate(crtFile.readAll(), QSsl::Pem);
+    *key = QSslKey(keyFile.readAll(), QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey);
+
+    if (crt->isNull() || key->isNull()) {
+        return false;
+    }
+
+    // regenerate the certificate a day before expiration.
+    return crt->expiryDate() > QDateTime::currentDateTime().addDays(1);
+}
+
+bool AbstractNode::saveSslCertificateCache(const QString &cacheKey, const QSslCertificate &crt, const QSslKey &key) const {
+    const QString path = sslCertificateCachePath();
+    if (path.isEmpty()) {
+        return true;
+    }
+
+    if (crt.isNull() || key.isNull()) {
+        return false;
+    }
+
+    if (!QDir().mkpath(path)) {
+        return false;
+    }
+
+    // files are shared between nodes, so they are replaced atomically and readers never see a half written file.
+    QSaveFile keyFile(path + "/" + cacheKey + "_" + SSL_CACHE_KEY);
+    if (!keyFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    // The key is not encrypted, so only owner can read it.
+    keyFile.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+    keyFile.write(key.toPem());
+    if (!keyFile.commit()) {
+        return false;
+    }
+
+    QSaveFile crtFile(path + "/" + cacheKey + "_" + SSL_CACHE_CERTIFICATE);
+    if (!crtFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    crtFile.write(crt.toPem());
+    return crtFile.commit();
+}
+
 bool AbstractNode::configureSslSocket(AbstractNodeInfo *node, bool fServer) {
 
     if (!node)
@@ -352,9 +472,33 @@ bool AbstractNode::configureSslSocket(AbstractNodeInfo *node, bool fServer) {
         return false;
     }
 
-    socket->setSslConfiguration(_ssl);
-
     auto address = node->networkAddress();
+
+    QSslConfiguration config = _ssl;
+    if (_sslSessionResumption) {
+        config.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+
+        if (!fServer) {
+            const HostAddressKey peer{address};
+            const QByteArray ticket = _sslSessions->ticket(peer);
+            if (!ticket.isEmpty()) {
+                config.setSessionTicket(ticket);
+            }
+
+            // the socket context is used for saving tickets in the io thread of the socket.
+            auto saveTicket = [this, socket, peer]() {
+                _sslSessions->insert(peer, socket->sslConfiguration().sessionTicket());
+            };
+
+            connect(socket, &QSslSocket::encrypted, socket, saveTicket, Qt::DirectConnection);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+            // tls 1.3 servers send tickets after handshake.
+            connect(socket, &QSslSocket::newSessionTicketReceived, socket, saveTicket, Qt::DirectConnection);
+#endif
+        }
+    }
+
+    socket->setSslConfiguration(config);
     connect(socket, &QSslSocket::encrypted, this ,[this, address]() {
         handleEncrypted(getInfoPtr(address));
     });
@@ -372,7 +516,7 @@ bool AbstractNode::configureSslSocket(AbstractNodeInfo *node, bool fServer) {
         return true;
     };
 
-    return _socketWorker->run(action);
+    return _reactors->launcherOf(socket)->run(action);
 }
 
 const QList<QSslError> &AbstractNode::ignoreSslErrors() const {
@@ -422,6 +566,22 @@ bool AbstractNode::disableSSL() {
     return true;
 }
 
+bool AbstractNode::isSslSessionResumptionEnabled() const {
+    return _sslSessionResumption;
+}
+
+void AbstractNode::setSslSessionResumptionEnabled(bool enabled) {
+    _sslSessionResumption = enabled;
+
+    if (!enabled) {
+        _sslSessions->clear();
+    }
+}
+
+int AbstractNode::sslSessionResumptionsCount() const {
+    return _sslSessions->hits();
+}
+
 void AbstractNode::handleEncrypted(AbstractNodeInfo *node) {
     handleNodeStatusChanged(node, NodeCoonectionStatus::Connected);
 }
@@ -540,9 +700,7 @@ bool AbstractNode::registerSocket(QAbstractSocket *socket, const HostAddress* cl
             Qt::QueuedConnection);
 
     // check node confirmed
-    QTimer::singleShot(WAIT_TIME, this, [this, cliAddress]() {
-        checkConfirmendOfNode(getInfoPtr(cliAddress));
-    });
+    _confirmTimeouts->add(cliAddress, WAIT_TIME);
 
     nodeAddedSucessful(info);
 
@@ -579,7 +737,7 @@ bool AbstractNode::sendPackage(const Package &pkg, QAbstractSocket *target) cons
         return false;
     }
 
-    return _dataSender->sendData(pkg.toBytes(), target, true);
+    return _reactors->senderOf(target)->sendData(pkg.toBytes(), target, true);
 }
 
 unsigned int AbstractNode::sendData(const AbstractData *resp,
@@ -631,6 +789,11 @@ unsigned int AbstractNode::sendData(const PKG::AbstractData *resp,
         return 0;
     }
 
+    auto packagesCache = this->packagesCache();
+    if (packagesCache && req && req->isValid() && packagesCache->storeResponses()) {
+        packagesCache->setResponse(node->networkAddress(), req->hash, pkg.toBytes());
+    }
+
     return pkg.hdr.hash;
 }
 
@@ -703,7 +866,7 @@ QList<HostAddress> AbstractNode::banedList() const {
 
     for (auto i = _connections.begin(); i != _connections.end(); ++i) {
         if (i.value()->isBanned()) {
-            list.push_back(i.key());
+            list.push_back(i.key().toHostAddress());
         }
     }
 
@@ -751,7 +914,37 @@ bool AbstractNode::isBanned(const AbstractNodeInfo *info) const {
 }
 
 void AbstractNode::incomingConnection(qintptr handle) {
-    AsyncLauncher::Job action = [this, handle]() -> bool {
+
+    // check the connection before creating of the socket object,
+    // so a flood of connections do not creates thousands of sockets.
+    QHostAddress peer;
+    unsigned short peerPort = 0;
+    const bool admissionChecked = AdmissionController::peerOfDescriptor(handle, &peer, &peerPort);
+    if (admissionChecked) {
+        auto decision = _admission->admit(peer, _pendingConnections + _confirmTimeouts->size());
+        if (decision == AdmissionDecision::Accept &&
+                isBanned(getInfoPtr(HostAddress{peer, peerPort}))) {
+            decision = AdmissionDecision::Banned;
+        }
+
+        if (decision != AdmissionDecision::Accept) {
+            if (decision == AdmissionDecision::Banned) {
+                qCritical() << "Income connection from banned address";
+            }
+
+            AdmissionController::closeDescriptor(handle);
+            return;
+        }
+    }
+
+    lockReactors();
+
+    _pendingConnections++;
+
+    const int reactor = _reactors->acquire();
+    AsyncLauncher::Job action = [this, handle, admissionChecked, reactor]() -> bool {
+        _pendingConnections--;
+
         QAbstractSocket* socket = nullptr;
 
 #ifdef USE_HEART_SSL
@@ -765,9 +958,12 @@ void AbstractNode::incomingConnection(qintptr handle) {
         socket = new TcpSocket(nullptr);
 #endif
 
+        _reactors->bind(reactor, socket);
         socket->setSocketDescriptor(handle);
 
-        if (isBanned(getInfoPtr(HostAddress{socket->peerAddress(), socket->peerPort()}))) {
+        if (!admissionChecked &&
+                (_admission->isBannedIp(socket->peerAddress()) ||
+                 isBanned(getInfoPtr(HostAddress{socket->peerAddress(), socket->peerPort()})))) {
             qCritical() << "Income connection from banned address";
 
             delete socket;
@@ -786,7 +982,19 @@ void AbstractNode::incomingConnection(qintptr handle) {
 
     };
 
-    _socketWorker->run(action);
+    auto launcher = _reactors->launcher(reactor);
+
+    // the job invoked on the reactor thread runs immediately and cleans up by itself if failed.
+    if (launcher->thread() == QThread::currentThread()) {
+        launcher->run(action);
+        return;
+    }
+
+    if (!launcher->run(action)) {
+        _pendingConnections--;
+        _reactors->release(reactor);
+        AdmissionController::closeDescriptor(handle);
+    }
 }
 
 bool AbstractNode::changeTrust(const HostAddress &id, int diff) {
@@ -816,17 +1024,26 @@ void AbstractNode::avelableBytes(AbstractNodeInfo *sender) {
     }
 
     auto id = sender->networkAddress();
+    const HostAddressKey key{id};
 
-    if (!_connections.contains(id)) {
+    // This method works in io thread of the socket, so different sockets can be processed in parallel.
+    _connectionsMutex.lock();
+    if (!_connections.contains(key)) {
+        _connectionsMutex.unlock();
         return;
     }
 
-    if (!_receiveData.contains(id)) {
-        _receiveData.insert(id, new ReceiveData());
+    auto &receiveDataPtr = _receiveData[key];
+    if (!receiveDataPtr) {
+        receiveDataPtr = new ReceiveData();
     }
 
-    auto &pkg = _receiveData[id]->_pkg;
-    auto &hdrArray = _receiveData[id]->_hdrArray;
+    // The ReceiveData object is used only by io thread of the sender.
+    ReceiveData *receiveData = receiveDataPtr;
+    _connectionsMutex.unlock();
+
+    auto &pkg = receiveData->_pkg;
+    auto &hdrArray = receiveData->_hdrArray;
 
     int workIndex = 0;
     const int headerSize = sizeof(Header);
@@ -893,7 +1110,7 @@ void AbstractNode::avelableBytes(AbstractNodeInfo *sender) {
             pkg.reset();
             hdrArray.clear();
         } else if (static_cast<unsigned int>(pkg.data.size()) >= pkg.hdr.size) {
-            qWarning() << "Invalid Package received." + pkg.toString();
+            qhLimited(Warning) << "Invalid Package received." << pkg.toString();
             pkg.reset();
             hdrArray.clear();
             changeTrust(id, CRITICAL_ERROOR);
@@ -957,7 +1174,7 @@ AbstractNode::prepareData(const Package &pkg,
 
     auto value = _apiVersionParser->searchPackage(pkg.hdr.command, sender);
     if (!value) {
-        qDebug() << "Package type not registered!"
+        qhLimited(Debug) << "Package type not registered!"
                     " Please use the registerPackageType method before parsing."
                     " Example invoke registerPackageType<MyData>() into constructor of you client and server nodes.";
 
@@ -969,9 +1186,16 @@ AbstractNode::prepareData(const Package &pkg,
 }
 
 QList<HostAddress> AbstractNode::connectionsList() const {
+    QList<HostAddress> result;
+
     QMutexLocker locer(&_connectionsMutex);
 
-    return _connections.keys();
+    result.reserve(_connections.size());
+    for (auto i = _connections.begin(); i != _connections.end(); ++i) {
+        result.push_back(i.key().toHostAddress());
+    }
+
+    return result;
 }
 
 QList<HostAddress> AbstractNode::activeConnectionsList() const {
@@ -1041,7 +1265,21 @@ void AbstractNode::newWork(const Package &pkg, AbstractNodeInfo *sender,
     if (!sender)
         return;
 
-    auto executeObject = [pkg, sender, id, this]() {
+    // each job keeps own pointer to the cache, so the cache can be disabled while jobs are running.
+    auto packagesCache = this->packagesCache();
+    if (packagesCache) {
+        QByteArray response;
+        if (!packagesCache->begin(id, pkg.hdr.hash, &response)) {
+            // This is retransmit of the already received package, so just send saved response again.
+            if (!response.isEmpty()) {
+                _reactors->senderOf(sender->sct())->sendData(response, sender->sct());
+            }
+
+            return;
+        }
+    }
+
+    auto executeObject = [pkg, sender, id, packagesCache, this]() {
 
         auto data = prepareData(pkg, sender);
         if (!data)
@@ -1049,16 +1287,19 @@ void AbstractNode::newWork(const Package &pkg, AbstractNodeInfo *sender,
 
         ParserResult parseResult = parsePackage(data, pkg.hdr, sender);
 
+        if (packagesCache) {
+            packagesCache->processed(id, pkg.hdr.hash, static_cast<char>(parseResult));
+        }
+
 #ifdef HEART_PRINT_PACKAGES
         QuasarAppUtils::Params::log(QString("Package received! %0").arg(data->toString()), QuasarAppUtils::Info);
 #endif
 
         if (parseResult != ParserResult::Processed) {
 
-            auto message = QString("Package not parsed! %0 \nresult: %1. \n%2").
-                           arg(pkg.toString(), iParser::pareseResultToString(parseResult), data->toString());
-
-            qInfo() << message;
+            qhLimited(Info) << "Package not parsed!" << pkg.toString()
+                                 << "\nresult:" << iParser::pareseResultToString(parseResult)
+                                 << "\n" << data->toString();
 
             if (parseResult == ParserResult::Error) {
 
@@ -1113,8 +1354,70 @@ SslMode AbstractNode::getMode() const {
     return _mode;
 }
 
+AdmissionController *AbstractNode::admissionController() const {
+    return _admission;
+}
+
+int AbstractNode::ioThreadsCount() const {
+    return _reactors->size();
+}
+
+QSharedPointer<PackageManager> AbstractNode::packagesCache() const {
+    QMutexLocker locker(&_packagesCacheMutex);
+    return _packagesCache;
+}
+
+void AbstractNode::setPackagesCacheEnabled(bool enable) {
+    QMutexLocker locker(&_packagesCacheMutex);
+
+    if (enable == static_cast<bool>(_packagesCache)) {
+        return;
+    }
+
+    if (enable) {
+        _packagesCache = QSharedPointer<PackageManager>::create();
+    } else {
+        _packagesCache.reset();
+    }
+}
+
+bool AbstractNode::setIoThreadsCount(int count) {
+    QMutexLocker locer(&_connectionsMutex);
+    QWriteLocker reactorsLocker(&_reactorsLock);
+
+    if (_reactorsLocked || _connections.size()) {
+        QuasarAppUtils::Params::log("Can't change count of io threads after first connection of the node.",
+                                    QuasarAppUtils::Error);
+        return false;
+    }
+
+    delete _reactors;
+    _reactors = new ReactorPool(count);
+
+    return true;
+}
+
+void AbstractNode::lockReactors() {
+    if (_reactorsLocked) {
+        return;
+    }
+
+    // after this the pool of reactors can not be changed, so it can be used without lock.
+    QReadLocker locker(&_reactorsLock);
+    _reactorsLocked = true;
+}
+
 QHash<HostAddress, AbstractNodeInfo *> AbstractNode::connections() const {
-    return _connections;
+    QHash<HostAddress, AbstractNodeInfo *> result;
+
+    QMutexLocker locer(&_connectionsMutex);
+
+    result.reserve(_connections.size());
+    for (auto i = _connections.begin(); i != _connections.end(); ++i) {
+        result.insert(i.key().toHostAddress(), i.value());
+    }
+
+    return result;
 }
 
 void AbstractNode::prepareForDelete() {
@@ -1124,6 +1427,7 @@ void AbstractNode::prepareForDelete() {
 void AbstractNode::handleNodeStatusChanged(AbstractNodeInfo *node, NodeCoonectionStatus status) {
 
     if (status == NodeCoonectionStatus::NotConnected) {
+        _confirmTimeouts->remove(node->networkAddress());
         nodeDisconnected(node);
     } else if (status == NodeCoonectionStatus::Connected) {
 
@@ -1153,6 +1457,7 @@ void AbstractNode::handleNodeStatusChanged(AbstractNodeInfo *node, NodeCoonectio
 
         nodeConnected(node);
     } else if (status == NodeCoonectionStatus::Confirmed) {
+        _confirmTimeouts->remove(node->networkAddress());
         nodeConfirmend(node);
     }
 }
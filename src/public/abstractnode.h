@@ -14,12 +14,16 @@
 
 #ifdef USE_HEART_SSL
 #include <QSslConfiguration>
+#include <QSslCertificate>
+#include <QSslKey>
 #include <easyssl/icertificate.h>
 #endif
 
 #include <QAbstractSocket>
+#include <atomic>
 #include <QFutureWatcher>
 #include <QMutex>
+#include <QReadWriteLock>
 #include <QSharedPointer>
 #include <QTcpServer>
 #include <QThreadPool>
@@ -41,6 +45,11 @@ class TaskScheduler;
 class AbstractTask;
 class SslSocket;
 class APIVersionParser;
+class AdmissionController;
+class ConfirmTimeouts;
+class ReactorPool;
+class SslSessionCache;
+class PackageManager;
 
 namespace PKG {
 class ErrorData;
@@ -189,6 +198,8 @@ public:
 
     /**
      * @brief ban - This method set for target connection a trust property to 0 and target connection will been aborted.
+     * @note Only this connection is banned, other nodes from the same ip address are not affected.
+     *  Use the AdmissionController::banIp method (see AbstractNode::admissionController) for banning of the whole ip address.
      * @param target - It is network address of target connection.
      */
     virtual void ban(const HostAddress& target);
@@ -449,6 +460,14 @@ protected:
      * @return The new selfsigned ssl configuration.
      */
     virtual QSslConfiguration selfSignedSslConfiguration( const EasySSL::SslSrtData& data = {});
+
+    /**
+     * @brief sslCertificateCachePath This method return path to the directory where node saves the generated self signed certificate and key between runs.
+     * Override this method for change location of the cache. Return empty string for disable the cache.
+     * @note Each set of the certificate data has own cache files. The cached certificate will be regenerated only when it expires, or when the cache files are removed.
+     * @return path to the cache directory. By default it is DEFAULT_SSL_CACHE_PATH.
+     */
+    virtual QString sslCertificateCachePath() const;
 #endif
 
     /**
@@ -529,7 +548,7 @@ protected:
      * @brief useSelfSignedSslConfiguration This method reconfigure current node to use selfSigned certificate.
      * @note Befor invoke this method stop this node (server) see AbstractNode::stop.
      *  if mode will be working then this method return false.
-     *  The self signed certificate is temp value, this is will be changed after reboot node (server)
+     *  The self signed certificate is saved into the sslCertificateCachePath directory and will be reused after reboot node (server)
      * @param crtData - This is data for generation a new self signed certification.
      * @return result of change node ssl configuration.
      */
@@ -551,6 +570,27 @@ protected:
      * @return true if changes is completed.
      */
     bool disableSSL();
+
+    /**
+     * @brief isSslSessionResumptionEnabled This method return true if the node reuses tls sessions of the servers.
+     * @return true if the tls session resumption is enabled.
+     */
+    bool isSslSessionResumptionEnabled() const;
+
+    /**
+     * @brief setSslSessionResumptionEnabled This method enable or disable resumption of the tls sessions.
+     * When resumption is enabled the node saves session tickets of the servers and
+     * uses them on the next connections to same servers, so the reconnect do not require a full handshake. By default it is enabled.
+     * @param enabled new value.
+     */
+    void setSslSessionResumptionEnabled(bool enabled);
+
+    /**
+     * @brief sslSessionResumptionsCount This method return count of the connections that used saved session ticket of the server.
+     * @note The server may reject the ticket, in this case the full handshake is used.
+     * @return count of the resumption tries.
+     */
+    int sslSessionResumptionsCount() const;
 #endif
 
     /**
@@ -559,6 +599,53 @@ protected:
      */
     QHash<HostAddress, AbstractNodeInfo *> connections() const;
 
+    /**
+     * @brief admissionController This method return controller of the incoming connections.
+     * Use this object for configure limits of the incoming connections and ban whole ip addresses.
+     * @return controller of the incoming connections.
+     * @see AdmissionController
+     */
+    AdmissionController* admissionController() const;
+
+    /**
+     * @brief ioThreadsCount This method return count of the io threads of the node.
+     * Each connection works in one io thread, connections are distributed between threads by count of connections.
+     * @return count of the io threads.
+     */
+    int ioThreadsCount() const;
+
+    /**
+     * @brief setIoThreadsCount This method sets new count of the io threads.
+     * By default the node uses IO_THREADS_COUNT threads (QThread::idealThreadCount).
+     * @param count This is new count of threads. If the count less then 1 then will be used QThread::idealThreadCount.
+     * @return true if the count changed successful. Returns false if node already created any connections.
+     * @note Invoke this method before first connection of the node (see run and addNode methods).
+     */
+    bool setIoThreadsCount(int count);
+
+    /**
+     * @brief packagesCache This method return cache of the received packages.
+     * @return cache of the received packages or nullptr if the cache is disabled.
+     * @see AbstractNode::setPackagesCacheEnabled
+     * @note This method is thread safe.
+     */
+    QSharedPointer<PackageManager> packagesCache() const;
+
+    /**
+     * @brief setPackagesCacheEnabled This method enable or disable cache of the received packages.
+     * When the cache is enabled, the node do not process retransmits of the already received packages and
+     * sends saved response of the package again. By default the cache is disabled.
+     *
+     * @warning Packages are identified by the hash of the content (Header::hash) and address of the sender connection, not by the request id.
+     *  So the same request sent twice by one connection during the PACKAGE_CACHE_TTL is processed only once
+     *  (for example repeated pings or polls), and retransmits sent by the new connection after reconnect are processed again.
+     *  Enable the cache only if all requests of the node are idempotent and unique by content.
+     * @param enable new value.
+     * @note This method is thread safe, jobs that already started use the previous cache.
+     * @see PackageManager
+     */
+    void setPackagesCacheEnabled(bool enable);
+
     /**
      * @brief nodeConfirmend This method invocked when the node status changed to "confirmend"
      *  default implementatio do nothing.
@@ -777,24 +864,39 @@ private:
      */
     void deinitThreadPool();
 
+    /**
+     * @brief lockReactors This method forbids changes of the reactors pool (see setIoThreadsCount). Invoke it before first using of the reactors.
+     */
+    void lockReactors();
+
 
     SslMode _mode = SslMode::NoSSL;
 #ifdef USE_HEART_SSL
     bool configureSslSocket(AbstractNodeInfo *node, bool fServer);
+    bool loadSslCertificateCache(const QString& cacheKey, QSslCertificate* crt, QSslKey* key) const;
+    bool saveSslCertificateCache(const QString& cacheKey, const QSslCertificate& crt, const QSslKey& key) const;
+
     QSslConfiguration _ssl;
     QList<QSslError> _ignoreSslErrors;
+    SslSessionCache *_sslSessions = nullptr;
+    bool _sslSessionResumption = true;
 #endif
-    QHash<HostAddress, AbstractNodeInfo*> _connections;
-    QHash<HostAddress, ReceiveData*> _receiveData;
-
-    DataSender * _dataSender = nullptr;
-    AsyncLauncher * _socketWorker = nullptr;
-    QThread *_senderThread = nullptr;
+    QHash<HostAddressKey, AbstractNodeInfo*> _connections;
+    QHash<HostAddressKey, ReceiveData*> _receiveData;
+
+    ReactorPool *_reactors = nullptr;
+    // the pool of reactors can be changed only before first connection.
+    QReadWriteLock _reactorsLock;
+    std::atomic<bool> _reactorsLocked{false};
+    QSharedPointer<PackageManager> _packagesCache;
     TaskScheduler *_tasksheduller = nullptr;
     APIVersionParser *_apiVersionParser = nullptr;
+    AdmissionController *_admission = nullptr;
+    ConfirmTimeouts *_confirmTimeouts = nullptr;
+    std::atomic_int _pendingConnections{0};
 
     QHash<NodeCoonectionStatus,
-          QHash<HostAddress,
+          QHash<HostAddressKey,
                 std::function<void (QH::AbstractNodeInfo *)>>> _connectActions;
 
     QSet<QFutureWatcher <bool>*> _workers;
@@ -805,6 +907,7 @@ private:
     mutable QMutex _confirmNodeMutex;
     mutable QMutex _threadPoolMutex;
     mutable QMutex _workersMutex;
+    mutable QMutex _packagesCacheMutex;
 
     QThreadPool *_threadPool = nullptr;
 
@@ -7,10 +7,12 @@
 
 #include "abstractnodeinfo.h"
 #include <hostaddress.h>
+#include <dnsresolver.h>
 #include <QAbstractSocket>
 #include <QDataStream>
 #include <QHostInfo>
 #include <QMetaObject>
+#include <QPointer>
 #include <quasarapp.h>
 #include <iparser.h>
 
@@ -181,10 +183,19 @@ void AbstractNodeInfo::setNetworkAddress(const HostAddress &networkAddress) {
     if (!networkAddress.isNull()) {
         _networkAddress = networkAddress;
 
-        QHostInfo::lookupHost(_networkAddress.toString(), [this] (QHostInfo info){
-            if (dynamic_cast<AbstractNodeInfo*>(this)) {
-                setInfo(info);
+        // The resolver invokes callbacks on the thread of the lookup,
+        // so the result moves to the thread of this object before using.
+        QPointer<AbstractNodeInfo> self = this;
+        DnsResolver::instance()->reverseLookup(_networkAddress, [self] (const QHostInfo& info){
+            if (info.error() != QHostInfo::NoError || info.hostName().isEmpty()) {
+                return;
             }
+
+            QMetaObject::invokeMethod(self, [self, info]() {
+                if (self) {
+                    self->setInfo(info);
+                }
+            }, Qt::QueuedConnection);
         });
     }
 }
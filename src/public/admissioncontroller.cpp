@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#include "admissioncontroller.h"
+#include "hostaddress.h"
+
+#include <QDateTime>
+#include <QMutexLocker>
+#include <algorithm>
+
+#ifdef Q_OS_WIN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#endif
+
+namespace QH {
+
+AdmissionController::AdmissionController() {
+
+}
+
+AdmissionDecision AdmissionController::admit(const QHostAddress &peer, int backlog) {
+    return admit(peer, backlog, QDateTime::currentMSecsSinceEpoch());
+}
+
+AdmissionDecision AdmissionController::admit(const QHostAddress &peer, int backlog, qint64 now) {
+    const HostAddressKey key{HostAddress{peer, 0}};
+
+    QMutexLocker locker(&_mutex);
+
+    if (_bannedIps.contains(key)) {
+        _rejected++;
+        return AdmissionDecision::Banned;
+    }
+
+    if (_maxBacklog > 0 && backlog >= _maxBacklog) {
+        _rejected++;
+        return AdmissionDecision::Overloaded;
+    }
+
+    // the global bucket is checked first, so a flood from many addresses do not creates ip buckets.
+    const bool globalLimited = _globalRate > 0;
+    if (globalLimited) {
+        refill(_globalBucket, _globalRate, _globalBurst, now);
+        if (_globalBucket.tokens < 1) {
+            _rejected++;
+            return AdmissionDecision::RateLimited;
+        }
+    }
+
+    // connections from the local host do not limited by ip bucket.
+    if (_ipRate > 0 && !peer.isLoopback()) {
+        auto &bucket = ipBucket(key);
+        refill(bucket, _ipRate, _ipBurst, now);
+        if (bucket.tokens < 1) {
+            _rejected++;
+            return AdmissionDecision::RateLimited;
+        }
+
+        bucket.tokens -= 1;
+    }
+
+    if (globalLimited) {
+        _globalBucket.tokens -= 1;
+    }
+
+    return AdmissionDecision::Accept;
+}
+
+void AdmissionController::banIp(const QHostAddress &address) {
+    QMutexLocker locker(&_mutex);
+    _bannedIps.insert(HostAddressKey{HostAddress{address, 0}});
+}
+
+void AdmissionController::unBanIp(const QHostAddress &address) {
+    QMutexLocker locker(&_mutex);
+    _bannedIps.remove(HostAddressKey{HostAddress{address, 0}});
+}
+
+bool AdmissionController::isBannedIp(const QHostAddress &address) const {
+    QMutexLocker locker(&_mutex);
+    return _bannedIps.contains(HostAddressKey{HostAddress{address, 0}});
+}
+
+void AdmissionController::setIpRate(double perSecond, int burst) {
+    QMutexLocker locker(&_mutex);
+    _ipRate = perSecond;
+    _ipBurst = burst;
+    _ipBuckets.clear();
+    _ipOrder.clear();
+}
+
+void AdmissionController::setGlobalRate(double perSecond, int burst) {
+    QMutexLocker locker(&_mutex);
+    _globalRate = perSecond;
+    _globalBurst = burst;
+    _globalBucket = {};
+}
+
+int AdmissionController::maxBacklog() const {
+    QMutexLocker locker(&_mutex);
+    return _maxBacklog;
+}
+
+void AdmissionController::setMaxBacklog(int maxBacklog) {
+    QMutexLocker locker(&_mutex);
+    _maxBacklog = maxBacklog;
+}
+
+quint64 AdmissionController::rejectedCount() const {
+    QMutexLocker locker(&_mutex);
+    return _rejected;
+}
+
+bool AdmissionController::peerOfDescriptor(qintptr descriptor, QHostAddress *address, unsigned short *port) {
+    if (!(address && port)) {
+        return false;
+    }
+
+    sockaddr_storage storage = {};
+#ifdef Q_OS_WIN
+    int size = sizeof(storage);
+    if (getpeername(static_cast<SOCKET>(descriptor), reinterpret_cast<sockaddr*>(&storage), &size) != 0) {
+        return false;
+    }
+#else
+    socklen_t size = sizeof(storage);
+    if (getpeername(static_cast<int>(descriptor), reinterpret_cast<sockaddr*>(&storage), &size) != 0) {
+        return false;
+    }
+#endif
+
+    if (storage.ss_family == AF_INET) {
+        *port = ntohs(reinterpret_cast<sockaddr_in*>(&storage)->sin_port);
+    } else if (storage.ss_family == AF_INET6) {
+        *port = ntohs(reinterpret_cast<sockaddr_in6*>(&storage)->sin6_port);
+    } else {
+        return false;
+    }
+
+    address->setAddress(reinterpret_cast<sockaddr*>(&storage));
+    return !address->isNull();
+}
+
+void AdmissionController::closeDescriptor(qintptr descriptor) {
+#ifdef Q_OS_WIN
+    closesocket(static_cast<SOCKET>(descriptor));
+#else
+    close(static_cast<int>(descriptor));
+#endif
+}
+
+void AdmissionController::refill(Bucket &bucket, double rate, int burst, qint64 now) const {
+    if (!bucket.lastUpdate) {
+        bucket.tokens = burst;
+    } else {
+        bucket.tokens = std::min<double>(burst, bucket.tokens + (now - bucket.lastUpdate) * rate / 1000);
+    }
+
+    bucket.lastUpdate = now;
+}
+
+AdmissionController::Bucket &AdmissionController::ipBucket(const HostAddressKey &key) {
+    auto it = _ipBuckets.find(key);
+    if (it != _ipBuckets.end()) {
+        _ipOrder.splice(_ipOrder.end(), _ipOrder, it->order);
+        return it.value();
+    }
+
+    // the least recently used bucket is removed, so the map never grows over the limit.
+    if (_ipBuckets.size() >= ADMISSION_IP_BUCKETS_LIMIT && !_ipOrder.empty()) {
+        _ipBuckets.remove(_ipOrder.front());
+        _ipOrder.pop_front();
+    }
+
+    Bucket bucket;
+    bucket.order = _ipOrder.insert(_ipOrder.end(), key);
+    return _ipBuckets.insert(key, bucket).value();
+}
+
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#ifndef ADMISSIONCONTROLLER_H
+#define ADMISSIONCONTROLLER_H
+
+#include "heart_global.h"
+#include "hostaddresskey.h"
+#include "config.h"
+
+#include <QHash>
+#include <QHostAddress>
+#include <QMutex>
+#include <QSet>
+#include <list>
+
+namespace QH {
+
+/**
+ * @brief The AdmissionDecision enum contains results of the AdmissionController::admit method.
+ */
+enum class AdmissionDecision {
+    /// The connection is accepted.
+    Accept,
+    /// The ip address of the connection is banned.
+    Banned,
+    /// The ip address of the connection or node in general receive too many connections in a second.
+    RateLimited,
+    /// The node have too many not confirmed connections.
+    Overloaded
+};
+
+/**
+ * @brief The AdmissionController class decides which incoming connections should be accepted by node before creating any socket object.
+ * The controller uses the token buckets for each ip address and one global bucket,
+ * the list of banned ip addresses and limit of the not confirmed connections (backlog).
+ * The count of the ip buckets is limited by the ADMISSION_IP_BUCKETS_LIMIT, after this limit the least recently used buckets are removed.
+ * All rejected connections are closed on the descriptor level.
+ * @note Connections from the loopback addresses are limited only by global bucket.
+ *
+ * @note This class is thread safe.
+ * @see AbstractNode::admissionController
+ */
+class HEARTSHARED_EXPORT AdmissionController
+{
+public:
+    AdmissionController();
+
+    /**
+     * @brief admit This method check new connection from the @a peer and take tokens from buckets if connection is accepted.
+     * @param peer This is ip address of the connection.
+     * @param backlog This is current count of the not confirmed connections of the node.
+     * @return decision of the controller.
+     */
+    AdmissionDecision admit(const QHostAddress& peer, int backlog);
+
+    /**
+     * @brief admit This is same as the admit(peer, backlog) method, but buckets are filled up to the @a now time.
+     * @param peer This is ip address of the connection.
+     * @param backlog This is current count of the not confirmed connections of the node.
+     * @param now This is current time in msec since epoch.
+     * @return decision of the controller.
+     */
+    AdmissionDecision admit(const QHostAddress& peer, int backlog, qint64 now);
+
+    /**
+     * @brief banIp This method ban all connections from the @a address.
+     * @note The AbstractNode::ban method bans only one connection, use this method for banning of the whole ip address.
+     * @param address This is banned ip address.
+     */
+    void banIp(const QHostAddress& address);
+
+    /**
+     * @brief unBanIp This method remove the @a address from the list of banned ip addresses.
+     * @param address This is ip address.
+     */
+    void unBanIp(const QHostAddress& address);
+
+    /**
+     * @brief isBannedIp This method return true if the @a address is banned.
+     * @param address This is ip address.
+     * @return true if the @a address is banned.
+     */
+    bool isBannedIp(const QHostAddress& address) const;
+
+    /**
+     * @brief setIpRate This method sets limit of connections from one ip address.
+     * @param perSecond This is count of connections per second. 0 disable the limit.
+     * @param burst This is maximum count of connections that can be accepted in moment.
+     */
+    void setIpRate(double perSecond, int burst);
+
+    /**
+     * @brief setGlobalRate This method sets limit of all incoming connections.
+     * @param perSecond This is count of connections per second. 0 disable the limit.
+     * @param burst This is maximum count of connections that can be accepted in moment.
+     */
+    void setGlobalRate(double perSecond, int burst);
+
+    /**
+     * @brief maxBacklog This method return limit of the not confirmed connections.
+     * @return limit of the not confirmed connections.
+     */
+    int maxBacklog() const;
+
+    /**
+     * @brief setMaxBacklog This method sets limit of the not confirmed connections. All connections over this limit will be dropped.
+     * @param maxBacklog new value of limit. 0 disable the limit.
+     */
+    void setMaxBacklog(int maxBacklog);
+
+    /**
+     * @brief rejectedCount This method return count of rejected connections.
+     * @return count of rejected connections.
+     */
+    quint64 rejectedCount() const;
+
+    /**
+     * @brief peerOfDescriptor This method read address of the remote side of the @a descriptor without creating a socket object.
+     * @param descriptor This is native socket descriptor.
+     * @param address This is result address.
+     * @param port This is result port.
+     * @return true if address readed successful.
+     */
+    static bool peerOfDescriptor(qintptr descriptor, QHostAddress* address, unsigned short* port);
+
+    /**
+     * @brief closeDescriptor This method close native socket @a descriptor.
+     * @param descriptor This is native socket descriptor.
+     */
+    static void closeDescriptor(qintptr descriptor);
+
+private:
+    struct Bucket {
+        double tokens = 0;
+        qint64 lastUpdate = 0;
+        std::list<HostAddressKey>::iterator order;
+    };
+
+    void refill(Bucket& bucket, double rate, int burst, qint64 now) const;
+    Bucket& ipBucket(const HostAddressKey& key);
+
+    QHash<HostAddressKey, Bucket> _ipBuckets;
+    // keys of the ip buckets from the least to the most recently used.
+    std::list<HostAddressKey> _ipOrder;
+    QSet<HostAddressKey> _bannedIps;
+    Bucket _globalBucket;
+
+    double _ipRate = ADMISSION_IP_RATE;
+    int _ipBurst = ADMISSION_IP_BURST;
+    double _globalRate = ADMISSION_GLOBAL_RATE;
+    int _globalBurst = ADMISSION_GLOBAL_BURST;
+    int _maxBacklog = ADMISSION_MAX_BACKLOG;
+    quint64 _rejected = 0;
+
+    mutable QMutex _mutex;
+};
+
+}
+#endif // ADMISSIONCONTROLLER_H
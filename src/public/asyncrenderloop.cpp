@@ -6,12 +6,18 @@
 */
 
 #include "asyncrenderloop.h"
+#include <QAbstractEventDispatcher>
+#include <QCoreApplication>
 #include <QThread>
+#include <QTimer>
 #include <qdebug.h>
+#include <algorithm>
+#include <thread>
 
 namespace QH {
 
 AsyncRenderLoop::AsyncRenderLoop(QThread *thread, QObject *ptr): Async(thread, ptr) {
+    _iterationTimes.reserve(RENDER_LOOP_STATISTICS_SIZE);
 }
 
 AsyncRenderLoop::~AsyncRenderLoop() {
@@ -29,6 +35,10 @@ AsyncRenderLoop::~AsyncRenderLoop() {
 
 void QH::AsyncRenderLoop::run() {
     if (auto && thrd = thread()) {
+        if (isRun()) {
+            return;
+        }
+
         m_run = true;
         thrd->start();
 
@@ -43,6 +53,7 @@ void QH::AsyncRenderLoop::run() {
 void QH::AsyncRenderLoop::stop() {
     if (isRun()) {
         m_run = false;
+        wakeUp();
         thread()->quit();
         thread()->wait();
     }
@@ -53,14 +64,109 @@ bool AsyncRenderLoop::isRun() const {
     return m_run && (thread() && thread()->isRunning());
 }
 
+AsyncRenderLoop::Mode AsyncRenderLoop::mode() const {
+    return _mode;
+}
+
+void AsyncRenderLoop::setMode(Mode mode) {
+    _mode = mode;
+    wakeUp();
+}
+
+int AsyncRenderLoop::interval() const {
+    return _interval;
+}
+
+void AsyncRenderLoop::setInterval(int mmsec) {
+    _interval = std::max(mmsec, 0);
+}
+
+int AsyncRenderLoop::idleTimeout() const {
+    return _idleTimeout;
+}
+
+void AsyncRenderLoop::setIdleTimeout(int msec) {
+    _idleTimeout = std::max(msec, 0);
+}
+
+void AsyncRenderLoop::wakeUp() {
+    _wakeRequested = true;
+    _noWork = false;
+
+    if (auto && thrd = thread()) {
+        if (auto dispatcher = thrd->eventDispatcher()) {
+            dispatcher->wakeUp();
+        }
+    }
+}
+
+RenderLoopStatistics AsyncRenderLoop::statistics() const {
+    QMutexLocker lock(&_statisticsMutex);
+
+    RenderLoopStatistics result = _statistics;
+    if (_iterationTimes.isEmpty()) {
+        return result;
+    }
+
+    QVector<int> times = _iterationTimes;
+    const auto minmax = std::minmax_element(times.begin(), times.end());
+    result.min = *minmax.first;
+    result.max = *minmax.second;
+    result.avg = static_cast<int>(_iterationsTimeSum / times.size());
+
+    const int p99 = (times.size() * 99) / 100;
+    std::nth_element(times.begin(), times.begin() + p99, times.end());
+    result.p99 = times[p99];
+
+    return result;
+}
+
+void AsyncRenderLoop::resetStatistics() {
+    QMutexLocker lock(&_statisticsMutex);
+
+    _iterationTimes.clear();
+    _nextIterationTime = 0;
+    _iterationsTimeSum = 0;
+    _statistics = {};
+}
+
+void AsyncRenderLoop::reportNoWork() {
+    _noWork = true;
+}
+
 void QH::AsyncRenderLoop::renderLoopPrivate() {
     auto&& currentTime = std::chrono::high_resolution_clock::now();
 
     _lastIterationTime = currentTime;
     int iterationTime = 0;
 
+    auto deadline = std::chrono::steady_clock::now();
+
     while (m_run) {
+        _noWork = false;
+
+        const auto iterationStart = std::chrono::high_resolution_clock::now();
         renderIteration(iterationTime);
+        addIterationTime(std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::high_resolution_clock::now() - iterationStart).count());
+
+        // process the queued events of this thread, for example jobs of the asyncLauncher method.
+        QCoreApplication::processEvents();
+
+        switch (_mode.load()) {
+        case Mode::FixedRate:
+            waitNextIteration(deadline);
+            break;
+        case Mode::Adaptive:
+            if (_noWork) {
+                park();
+            }
+            deadline = std::chrono::steady_clock::now();
+            break;
+        case Mode::Continuous:
+            deadline = std::chrono::steady_clock::now();
+            break;
+        }
 
         currentTime = std::chrono::high_resolution_clock::now();
         iterationTime = std::chrono::duration_cast<std::chrono::microseconds>(currentTime - _lastIterationTime).count();
@@ -68,4 +174,59 @@ void QH::AsyncRenderLoop::renderLoopPrivate() {
     }
 }
 
+void AsyncRenderLoop::waitNextIteration(std::chrono::steady_clock::time_point& deadline) {
+    const auto interval = std::chrono::microseconds(_interval.load());
+    const auto now = std::chrono::steady_clock::now();
+
+    // the next deadline calculated from the previous deadline, so the sleeping time compensates the drift.
+    // if the loop is late more then one interval then skip missed iterations.
+    deadline += interval;
+    if (deadline + interval < now) {
+        deadline = now;
+        return;
+    }
+
+    // sleep with the system timer and finish waiting with yield to get precise time of the wake up.
+    const auto spinTime = std::chrono::milliseconds(1);
+    if (deadline - now > spinTime) {
+        std::this_thread::sleep_until(deadline - spinTime);
+    }
+
+    while (m_run && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+void AsyncRenderLoop::park() {
+    // the wakeUp method invoked before parking.
+    if (_wakeRequested.exchange(false)) {
+        return;
+    }
+
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    timeout.start(_idleTimeout.load());
+
+    // wait for any event of this thread: posted job, wakeUp call or timeout.
+    QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+
+    // the next iteration handles all wake ups received while parking.
+    _wakeRequested = false;
+}
+
+void AsyncRenderLoop::addIterationTime(int mmsec) {
+    QMutexLocker lock(&_statisticsMutex);
+
+    if (_iterationTimes.size() < RENDER_LOOP_STATISTICS_SIZE) {
+        _iterationTimes.push_back(mmsec);
+    } else {
+        _iterationsTimeSum -= _iterationTimes[_nextIterationTime];
+        _iterationTimes[_nextIterationTime] = mmsec;
+        _nextIterationTime = (_nextIterationTime + 1) % RENDER_LOOP_STATISTICS_SIZE;
+    }
+
+    _iterationsTimeSum += mmsec;
+    _statistics.iterations++;
+}
+
 } // namespace QH
@@ -10,8 +10,31 @@
 
 #include "async.h"
 
+#include <QMutex>
+#include <QVector>
+#include <atomic>
+#include <chrono>
+
 namespace QH {
 
+/**
+ * @brief The RenderLoopStatistics struct contains statistics of the iterations time of the render loop.
+ * All values in microseconds.
+ * @see AsyncRenderLoop::statistics
+ */
+struct RenderLoopStatistics {
+    /// minimum time of the iteration.
+    int min = 0;
+    /// average time of the iteration.
+    int avg = 0;
+    /// 99 percentile of the iteration time.
+    int p99 = 0;
+    /// maximum time of the iteration.
+    int max = 0;
+    /// count of all iterations from the start or last reset.
+    quint64 iterations = 0;
+};
+
 /**
  * @brief The AsyncRenderLoop is a class for asynchronous rendering.
  * This class is used to create a render loop that is executed in a separate thread.
@@ -54,6 +77,13 @@ namespace QH {
  *  return app.exec();
  *  }
  *  @endcode
+ *
+ * The render loop supports next modes (see AsyncRenderLoop::setMode):
+ *  * Continuous - invokes iterations without pauses (default).
+ *  * FixedRate - invokes iterations with fixed rate, the time of the sleeping between iterations is compensated by time of the previous iteration.
+ *  * Adaptive - works like a Continuous but parks thread when the renderIteration report about no work (see AsyncRenderLoop::reportNoWork).
+ *
+ * In all modes the loop processes events of the own thread between iterations, so the jobs of the asyncLauncher method will be invoked.
  */
 class HEARTSHARED_EXPORT AsyncRenderLoop: public Async
 {
@@ -61,6 +91,18 @@ class HEARTSHARED_EXPORT AsyncRenderLoop: public Async
     Q_OBJECT
 public:
 
+    /**
+     * @brief The Mode enum contains modes of the render loop.
+     */
+    enum class Mode {
+        /// invokes iterations without pauses.
+        Continuous,
+        /// invokes iterations with fixed rate. See AsyncRenderLoop::setInterval.
+        FixedRate,
+        /// parks the thread while the renderIteration method report about no work. See AsyncRenderLoop::reportNoWork.
+        Adaptive
+    };
+
     /**
      * @brief The MainSharedPtr class is a helper class for creating a shared pointer to the render loop.
      * @tparam T type of the render loop object.
@@ -140,6 +182,62 @@ public:
      */
     bool isRun() const;
 
+    /**
+     * @brief mode This method return current mode of the render loop.
+     * @return current mode of the render loop.
+     */
+    Mode mode() const;
+
+    /**
+     * @brief setMode This method sets new mode of the render loop. Can be changed while loop is running.
+     * @param mode new mode of the render loop.
+     */
+    void setMode(Mode mode);
+
+    /**
+     * @brief interval This method return interval between iterations in FixedRate mode.
+     * @return interval between iterations in microseconds.
+     */
+    int interval() const;
+
+    /**
+     * @brief setInterval This method sets interval between iterations in FixedRate mode. For example 16666 for 60 iterations per second.
+     * @param mmsec interval in microseconds.
+     */
+    void setInterval(int mmsec);
+
+    /**
+     * @brief idleTimeout This method return maximum time of the parking in the Adaptive mode.
+     * @return maximum time of the parking in milliseconds.
+     */
+    int idleTimeout() const;
+
+    /**
+     * @brief setIdleTimeout This method sets maximum time of the parking in the Adaptive mode.
+     *  After this time the renderIteration will be invoked even if nobody invoked the AsyncRenderLoop::wakeUp method.
+     * @param msec time in milliseconds.
+     */
+    void setIdleTimeout(int msec);
+
+    /**
+     * @brief wakeUp This method wakes up the parked render loop. Use this method when you add new work for the loop from another thread.
+     *  If the loop is not parked yet then the next parking is skipped, so the wake up is never lost.
+     * @note This method is thread safe.
+     */
+    void wakeUp();
+
+    /**
+     * @brief statistics This method return statistics of the time of the last iterations (see RENDER_LOOP_STATISTICS_SIZE).
+     * @return statistics of the iterations.
+     * @note This method is thread safe.
+     */
+    RenderLoopStatistics statistics() const;
+
+    /**
+     * @brief resetStatistics This method removes all collected statistics.
+     */
+    void resetStatistics();
+
     /**
      * @brief createMainPtr This method creates a shared pointer to the render loop.
      * @tparam Type type of the render loop object.
@@ -163,13 +261,35 @@ protected:
      */
     virtual void renderIteration(int mmsec) = 0;
 
+    /**
+     * @brief reportNoWork This method should be invoked in the renderIteration method if the loop has not any work.
+     *  In the Adaptive mode the loop parks thread until the AsyncRenderLoop::wakeUp invoked, new event is received or idle timeout is expired.
+     *  In other modes this method do nothing.
+     */
+    void reportNoWork();
+
 private slots:
     void renderLoopPrivate();
 
 private:
-    bool m_run = false;
+    void waitNextIteration(std::chrono::steady_clock::time_point& deadline);
+    void park();
+    void addIterationTime(int mmsec);
+
+    std::atomic_bool m_run{false};
+    std::atomic<Mode> _mode{Mode::Continuous};
+    std::atomic_int _interval{RENDER_LOOP_INTERVAL};
+    std::atomic_int _idleTimeout{RENDER_LOOP_IDLE_TIMEOUT};
+    std::atomic_bool _noWork{false};
+    std::atomic_bool _wakeRequested{false};
     std::chrono::time_point<std::chrono::high_resolution_clock> _lastIterationTime;
 
+    QVector<int> _iterationTimes;
+    int _nextIterationTime = 0;
+    RenderLoopStatistics _statistics;
+    qint64 _iterationsTimeSum = 0;
+    mutable QMutex _statisticsMutex;
+
 };
 }
 
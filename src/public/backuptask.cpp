@@ -0,0 +1,38 @@
+//#
+//# Copyright (C) 2025-2025 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#include "backuptask.h"
+#include "sqldbwriter.h"
+
+#include <QDateTime>
+
+namespace QH {
+
+BackUpTask::BackUpTask(SqlDBWriter *writer, const QString &path):
+    _writer(writer),
+    _path(path) {
+
+}
+
+bool BackUpTask::execute(AbstractNode *) const {
+    if (!_writer) {
+        return false;
+    }
+
+    const QString file = _path + "/DB_" + QDateTime::currentDateTimeUtc().toString("yyyy_MM_dd_hh_mm_ss") + ".db";
+    return _writer->backUp(file);
+}
+
+bool BackUpTask::isValid() const {
+    return _writer && !_path.isEmpty() && AbstractTask::isValid();
+}
+
+const QString &BackUpTask::path() const {
+    return _path;
+}
+
+}
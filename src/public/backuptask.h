@@ -0,0 +1,54 @@
+//#
+//# Copyright (C) 2025-2025 QuasarApp.
+//# Distributed under the lgplv3 software license, see the accompanying
+//# Everyone is permitted to copy and distribute verbatim copies
+//# of this license document, but changing it is not allowed.
+//#
+
+#ifndef BACKUPTASK_H
+#define BACKUPTASK_H
+
+#include "abstracttask.h"
+
+#include <QPointer>
+#include <QString>
+
+namespace QH {
+
+class SqlDBWriter;
+
+/**
+ * @brief The BackUpTask class makes online backups of the sqlite database by schedule.
+ *  Each backup saved into new file "DB_<time>.db" in the backup folder.
+ *
+ * **Example:**
+ * @code{cpp}
+ *  auto task = QSharedPointer<QH::BackUpTask>::create(writer, backUpPath);
+ *  task->setMode(QH::ScheduleMode::Repeat);
+ *  task->setTime(QH::AbstractTask::Day);
+ *  node->sheduleTask(task);
+ * @endcode
+ * @see SqlDBWriter::backUp
+ * @see DataBase::createBackUpTask
+ */
+class HEARTSHARED_EXPORT BackUpTask: public AbstractTask
+{
+public:
+    BackUpTask(SqlDBWriter* writer, const QString& path);
+
+    bool execute(AbstractNode *node) const override;
+    bool isValid() const override;
+
+    /**
+     * @brief path This method return path to folder of the backups.
+     * @return path to folder of the backups.
+     */
+    const QString& path() const;
+
+private:
+    QPointer<SqlDBWriter> _writer;
+    QString _path;
+};
+
+}
+#endif // BACKUPTASK_H
@@ -21,12 +21,48 @@
 #define LOCAL_SERVER          "127.0.0.1"
 #define DEFAULT_PORT          3090  // Default work port
 #define WAIT_CONFIRM_TIME   WAIT_TIME // timeout for waiting responce of server or client. 30000 msec = 30 sec
+#define DNS_CACHE_TTL 300000          // time to live of the resolved dns names. 300000 msec = 5 min
+#define DNS_NEGATIVE_CACHE_TTL 30000  // time to live of the failed dns lookups. 30000 msec = 30 sec
+#define DNS_CACHE_SIZE 10000          // limit of the dns records, after this limit the least recently used records will be removed.
+#define DNS_CACHE_SWEEP_INTERVAL 60000 // minimal interval between removing of the expired dns records. 60000 msec = 1 min
+#define IO_THREADS_COUNT 0            // count of the io threads of the node. 0 means QThread::idealThreadCount
+#define CONFIRM_TIMEOUTS_RESOLUTION 1000 // resolution of the shared timer of the confirmation timeouts. 1000 msec = 1 sec
+#define PACKED_ROWS_MAX 1000000       // maximum count of the rows in the one received packed DataPack, see PackedRows::read
+
+// Log settings
+#define LOG_DUMP_LIMIT 64               // count of the bytes of the binary data that printed into log, see QH::logDump
+#define LOG_RATE_LIMIT 10               // count of the messages of the one place of the code that printed per LOG_RATE_INTERVAL, see qhLimited
+#define LOG_RATE_INTERVAL 1000          // interval of the log rate limit. 1000 msec = 1 sec
+
+// Admission control settings
+#define ADMISSION_IP_RATE 20            // count of the incoming connections per second from one ip address
+#define ADMISSION_IP_BURST 100          // maximum count of the incoming connections in moment from one ip address
+#define ADMISSION_GLOBAL_RATE 1000      // count of the incoming connections per second for node
+#define ADMISSION_GLOBAL_BURST 2000     // maximum count of the incoming connections in moment for node
+#define ADMISSION_MAX_BACKLOG 10000     // maximum count of the not confirmed connections, all new connections over this limit will be dropped.
+#define ADMISSION_IP_BUCKETS_LIMIT 10000 // limit of the ip buckets, after this limit the least recently used buckets will be removed.
+
+// Ssl settings
+#define DEFAULT_SSL_CACHE_PATH QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/ssl" // default location of the cached self signed certificate
+#define SSL_CACHE_CERTIFICATE "selfsigned.crt" // name of the cached certificate, prefixed by the hash of the certificate data
+#define SSL_CACHE_KEY "selfsigned.key" // name of the cached private key, prefixed by the hash of the certificate data
+#define SSL_SESSION_CACHE_SIZE 1000     // count of the saved tls session tickets of servers
 
 // Data Base settings
 #define DEFAULT_DB_NAME "Storage.sqlite" // default database name of server
 #define DEFAULT_DB_PATH QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) // default location of database. in linux systems it is ~/.local/shared/<Company>/<AppName>
 #define DEFAULT_DB_INIT_FILE_PATH ":/sql/res/BaseDB.sql" // default database file path
 #define DEFAULT_UPDATE_INTERVAL 3600000 // This is interval of update database cache by default it is 1 hour
+#define DEFAULT_DB_PROFILE "durable"    // default performance profile of the sqlite database. See SqlDBWriter::performanceProfile
+#define DB_BACKUP_STEP_PAGES 1024       // count of the database pages that copied in one step of the online backup (HEART_SQLITE_BACKUP_API only)
+#define DB_BULK_MAX_PARAMETERS 999     // maximum count of the bound values in the one multi-row insert statement. 999 is the smallest limit of the supported drivers (old sqlite).
+#define DB_UPDATE_STATEMENTS_CACHE 64  // count of the prepared update statements (one for each table and set of changed fields) that reused by the SqlDBWriter.
+#define DB_ID_BLOCK_SIZE 1000          // count of the ids that reserved by the IdAllocator in the one database query.
+#define DB_KEY_VALUE_TABLE "DataBaseKeyValues" // default table of the KeyValueStore.
+#define DB_KEY_VALUE_RETRY_MSEC 1000  // delay before next try to save values of the KeyValueStore after failed flush.
+#define DB_PRELOAD_BATCH_SIZE 1000     // count of rows that loaded by the one job of the writer while warming up of the cache.
+#define DB_SLOW_QUERY_MSEC 100         // queries that executed longer then this time are printed into log. See QH_DB_SLOW_QUERY_MSEC
+#define DB_SQL_STATISTICS_SIZE 1000    // maximum count of the different statements in the sql statistics, other statements are counted together.
 
 // Database settings keys
 #define QH_DB_DRIVER "DBDriver"
@@ -37,6 +73,11 @@
 #define QH_DB_HOST "DBHost"
 #define QH_DB_PORT "DBPort"
 #define QH_DB_BACKUP_PATH "DBBackUpPath"
+#define QH_DB_BULK_LOAD "DBBulkLoad"
+#define QH_DB_PROFILE "DBProfile"
+#define QH_DB_PRAGMAS "DBPragmas"
+#define QH_DB_SLOW_QUERY_MSEC "DBSlowQueryMsec"
+#define QH_DB_EXPLAIN_SLOW_QUERIES "DBExplainSlowQueries"
 
 // Transport Protockol settings
 #define ROUTE_CACHE_LIMIT 1000          // This is defaut count of routes in the router class obecjt.
@@ -44,6 +85,16 @@
 
 // Node Settings
 #define PACKAGE_CACHE_SIZE 1000         // this is default count limit of received packages
+#define PACKAGE_CACHE_MEMORY_LIMIT 16777216 // this is default limit of saved responses of received packages. 16777216 bytes = 16 MB
+#define PACKAGE_CACHE_TTL 10000         // this is default life time of received packages in the cache. 10000 msec = 10 sec
+
+// Packages settings
+#define UNIVERSAL_DATA_DENSE_FIELDS 16  // count of the first fields of the UniversalData that stored in the inline array instead of the hash. Should be not greater then 32
+
+// Render loop settings
+#define RENDER_LOOP_STATISTICS_SIZE 1000 // count of the last iterations that used for calculation of the render loop statistics
+#define RENDER_LOOP_INTERVAL 16666       // default interval between iterations in the fixed rate mode. 16666 mmsec = 60 iterations per second
+#define RENDER_LOOP_IDLE_TIMEOUT 1000    // maximum time of the parking of the idle render loop in adaptive mode. 1000 msec = 1 sec
 
 
 // Other settings
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#include "confirmtimeouts.h"
+#include "config.h"
+
+#include <QDateTime>
+#include <QTimer>
+
+namespace QH {
+
+ConfirmTimeouts::ConfirmTimeouts(QObject *parent): QObject(parent) {
+    _timer = new QTimer(this);
+    _timer->setInterval(CONFIRM_TIMEOUTS_RESOLUTION);
+
+    connect(_timer, &QTimer::timeout, this, &ConfirmTimeouts::handleTick);
+}
+
+ConfirmTimeouts::~ConfirmTimeouts() {
+    _timer->stop();
+}
+
+void ConfirmTimeouts::add(const HostAddressKey &key, int timeout) {
+    const qint64 deadline = QDateTime::currentMSecsSinceEpoch() + timeout;
+
+    QMutexLocker locker(&_mutex);
+
+    auto it = _deadlines.find(key);
+    if (it != _deadlines.end()) {
+        _queue.remove(it.value(), key);
+        it.value() = deadline;
+    } else {
+        _deadlines.insert(key, deadline);
+    }
+
+    _queue.insert(deadline, key);
+
+    if (_deadlines.size() == 1) {
+        // The timer can be started only from own thread.
+        QMetaObject::invokeMethod(_timer, "start", Qt::QueuedConnection);
+    }
+}
+
+void ConfirmTimeouts::remove(const HostAddressKey &key) {
+    QMutexLocker locker(&_mutex);
+
+    auto it = _deadlines.find(key);
+    if (it == _deadlines.end()) {
+        return;
+    }
+
+    _queue.remove(it.value(), key);
+    _deadlines.erase(it);
+}
+
+int ConfirmTimeouts::size() const {
+    QMutexLocker locker(&_mutex);
+    return _deadlines.size();
+}
+
+void ConfirmTimeouts::handleTick() {
+    expire(QDateTime::currentMSecsSinceEpoch());
+}
+
+int ConfirmTimeouts::expire(qint64 now) {
+    QList<HostAddressKey> expired;
+
+    _mutex.lock();
+    while (!_queue.isEmpty() && _queue.firstKey() <= now) {
+        auto key = _queue.first();
+        _queue.erase(_queue.begin());
+        _deadlines.remove(key);
+        expired.push_back(key);
+    }
+
+    if (_deadlines.isEmpty()) {
+        _timer->stop();
+    }
+    _mutex.unlock();
+
+    for (const auto& key: std::as_const(expired)) {
+        emit sigTimeout(key);
+    }
+
+    return expired.size();
+}
+
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#ifndef CONFIRMTIMEOUTS_H
+#define CONFIRMTIMEOUTS_H
+
+#include "heart_global.h"
+#include "hostaddresskey.h"
+
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+
+class QTimer;
+
+namespace QH {
+
+/**
+ * @brief The ConfirmTimeouts class is one shared timer for the confirmation timeouts of all connections of the node.
+ * Instead of one timer per socket this class keeps sorted queue of the deadlines and checks it with one coarse timer.
+ * The timer works only while the queue is not empty.
+ * @note The add and remove methods are thread safe. The sigTimeout signal emitted in the thread of this object.
+ */
+class HEARTSHARED_EXPORT ConfirmTimeouts: public QObject
+{
+    Q_OBJECT
+public:
+    ConfirmTimeouts(QObject* parent = nullptr);
+    ~ConfirmTimeouts();
+
+    /**
+     * @brief add This method add or update deadline of the @a key.
+     * @param key This is address of the connection.
+     * @param timeout This is timeout in msec.
+     */
+    void add(const HostAddressKey& key, int timeout);
+
+    /**
+     * @brief remove This method remove deadline of the @a key.
+     * @param key This is address of the connection.
+     */
+    void remove(const HostAddressKey& key);
+
+    /**
+     * @brief size This method return count of the waiting connections.
+     * @return count of the waiting connections.
+     */
+    int size() const;
+
+    /**
+     * @brief expire This method removes all deadlines that expired at the @a now time and emits the sigTimeout signal for each of them.
+     *  The shared timer invokes this method with current time.
+     * @param now This is time in msec since epoch.
+     * @return count of the expired connections.
+     * @note This method should be invoked in the thread of this object.
+     */
+    int expire(qint64 now);
+
+signals:
+    /**
+     * @brief sigTimeout This signal emitted when deadline of the @a key is expired.
+     * @param key This is address of the connection.
+     */
+    void sigTimeout(const QH::HostAddressKey& key);
+
+private slots:
+    void handleTick();
+
+private:
+    QMultiMap<qint64, HostAddressKey> _queue;
+    QHash<HostAddressKey, qint64> _deadlines;
+    QTimer *_timer = nullptr;
+    mutable QMutex _mutex;
+};
+
+}
+#endif // CONFIRMTIMEOUTS_H
@@ -8,6 +8,10 @@
 #include "database.h"
 #include "sqldbwriter.h"
 #include "asyncsqldbwriter.h"
+#include "backuptask.h"
+#include "idallocator.h"
+#include "keyvaluestore.h"
+#include "futures.h"
 
 #include <quasarapp.h>
 #include <QCoreApplication>
@@ -19,6 +23,8 @@
 #include "getsinglevalue.h"
 #include "setsinglevalue.h"
 #include <qaglobalutils.h>
+#include <QElapsedTimer>
+#include <QSqlQuery>
 
 namespace QH {
 using namespace PKG;
@@ -58,6 +64,14 @@ bool DataBase::initSqlDb(QString DBparamsFile,
 
     qDebug() << "Database loaded from: " << dbLocation();
 
+    _idAllocator = new IdAllocator(_db->writer());
+
+    _keyValueStore = new KeyValueStore(_db->writer());
+    if (!_keyValueStore->load()) {
+        qCritical() << "Failed to load key-value store";
+        return false;
+    }
+
     connect(_db, &ISqlDB::sigItemChanged,
             this, &DataBase::sigObjectChanged,
             Qt::DirectConnection);
@@ -66,6 +80,8 @@ bool DataBase::initSqlDb(QString DBparamsFile,
             this, &DataBase::sigObjectDeleted,
             Qt::DirectConnection);
 
+    startWarmUp();
+
     return true;
 }
 
@@ -97,6 +113,13 @@ bool DataBase::run(const QString &localNodeName) {
 void DataBase::stop() {
 
     if (db()) {
+        delete _idAllocator;
+        _idAllocator = nullptr;
+
+        // saves not saved values, so it must be deleted before the writer.
+        delete _keyValueStore;
+        _keyValueStore = nullptr;
+
         auto writer = _db->writer();
         _db->softDelete();
         _db = nullptr;
@@ -149,6 +172,57 @@ const DBPatchMap DataBase::dbPatches() const {
     return _dbPatches;
 }
 
+void DataBase::addPreloadTable(const QSharedPointer<PKG::DBObject> &templateObject,
+                               const QHash<QString, ResidentTable::IndexType> &indexes) {
+    _preloadTables.push_back({templateObject, indexes});
+}
+
+QList<SqlStatementStats> DataBase::sqlStatistics() const {
+    if (!_db) {
+        return {};
+    }
+
+    return _db->sqlStatistics();
+}
+
+bool DataBase::isWarm() const {
+    for (const auto& future: _warmUp) {
+        if (!future.isFinished()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void DataBase::startWarmUp() {
+    if (_preloadTables.isEmpty()) {
+        return;
+    }
+
+    connect(_db, &ISqlDB::sigPreloadProgress,
+            this, &DataBase::sigWarmUpProgress,
+            Qt::DirectConnection);
+
+    _warmUp.clear();
+    QList<QFuture<void>> futures;
+    for (const auto& table: std::as_const(_preloadTables)) {
+        auto future = _db->preloadResident(table.templateObject, table.indexes);
+        _warmUp.push_back(future);
+        futures.push_back(future);
+    }
+
+    const auto warmUp = _warmUp;
+    Futures::whenAll(futures, this, [this, warmUp]() {
+        bool success = true;
+        for (const auto& future: warmUp) {
+            success = success && !future.isCanceled() && future.result();
+        }
+
+        emit sigWarmUpFinished(success);
+    });
+}
+
 void DataBase::addDBPatch(const DBPatch &patch) {
     debug_assert(patch.isValid(),
                  "Failed to initialise a Data base patch!"
@@ -187,9 +261,7 @@ QString DataBase::backUp(int version) const {
     if (db() && db()->writer() &&
         QFile::exists(db()->writer()->databaseLocation())) {
 
-        QDir().mkpath(path);
-
-        if (!QFile::copy(db()->writer()->databaseLocation(), file)) {
+        if (!db()->writer()->backUp(file, true)) {
             return {};
         }
     }
@@ -197,10 +269,31 @@ QString DataBase::backUp(int version) const {
     return file;
 }
 
+QSharedPointer<BackUpTask> DataBase::createBackUpTask(quint64 interval) const {
+    if (!db() || !db()->writer()) {
+        return nullptr;
+    }
+
+    const QString path = defaultDbParams().value(QH_DB_BACKUP_PATH).toString();
+    if (path.isEmpty()) {
+        return nullptr;
+    }
+
+    auto task = QSharedPointer<BackUpTask>::create(db()->writer(), path);
+    task->setMode(ScheduleMode::Repeat);
+    task->setTime(interval);
+
+    return task;
+}
+
 ISqlDB *DataBase::db() const {
     return _db;
 }
 
+IdAllocator *DataBase::idAllocator() const {
+    return _idAllocator;
+}
+
 bool DataBase::isForbidenTable(const QString &table) {
     return systemTables().contains(table);
 }
@@ -249,20 +342,133 @@ bool DataBase::upgradeDataBase() {
 
         qInfo() << message.arg("(Begin)");
 
-        if (!patch.action(db())) {
+        QElapsedTimer timer;
+        timer.start();
+
+        if (!applyDBPatch(patch)) {
             qCritical() << "Failed to " + message.arg("Patch finished with error code!");
             return false;
         }
 
+        onDBPatchApplied(patch, timer.elapsed());
         currentVersion = patch.versionTo;
-        if (!setDBAttribute("version", currentVersion)) {
+    }
+
+    return true;
+}
+
+bool DataBase::applyDBPatch(const DBPatch &patch) {
+
+    int batch = -1;
+    if (patch.batchAction) {
+        if (!db()->doQuery("CREATE TABLE IF NOT EXISTS DataBaseUpgradeProgress ("
+                           "version INT NOT NULL PRIMARY KEY, batch INT NOT NULL)", {}, true)) {
             return false;
         }
+
+        // the not negative value means that the previous upgrade was interrupted.
+        if (!upgradeProgress(patch.versionTo, &batch)) {
+            return false;
+        }
+    }
+
+    // the action and the version of database changed in one transaction.
+    if (batch < 0) {
+        if (!savepoint("SAVEPOINT", patch.versionTo)) {
+            return false;
+        }
+
+        bool result = !patch.action || patch.action(db());
+
+        if (result) {
+            if (patch.batchAction) {
+                result = db()->doQuery("INSERT OR REPLACE INTO DataBaseUpgradeProgress (version, batch) VALUES (:version, 0)",
+                                       {{":version", patch.versionTo}}, true);
+            } else {
+                result = setDBAttribute("version", patch.versionTo);
+            }
+        }
+
+        if (!result) {
+            savepoint("ROLLBACK TO SAVEPOINT", patch.versionTo);
+            savepoint("RELEASE SAVEPOINT", patch.versionTo);
+            return false;
+        }
+
+        if (!savepoint("RELEASE SAVEPOINT", patch.versionTo)) {
+            return false;
+        }
+
+        batch = 0;
+    }
+
+    if (!patch.batchAction) {
+        return true;
+    }
+
+    // streaming migration: each batch and number of the next batch saved in one transaction.
+    qint64 processed = 0;
+    while (true) {
+        if (!savepoint("SAVEPOINT", patch.versionTo)) {
+            return false;
+        }
+
+        const int rows = patch.batchAction(db(), batch);
+        bool result = rows >= 0;
+
+        if (result) {
+            if (rows) {
+                result = db()->doQuery("UPDATE DataBaseUpgradeProgress SET batch = :batch WHERE version = :version",
+                                       {{":batch", batch + 1}, {":version", patch.versionTo}}, true);
+            } else {
+                result = db()->doQuery("DELETE FROM DataBaseUpgradeProgress WHERE version = :version",
+                                       {{":version", patch.versionTo}}, true) &&
+                         setDBAttribute("version", patch.versionTo);
+            }
+        }
+
+        if (!result) {
+            savepoint("ROLLBACK TO SAVEPOINT", patch.versionTo);
+            savepoint("RELEASE SAVEPOINT", patch.versionTo);
+            return false;
+        }
+
+        if (!savepoint("RELEASE SAVEPOINT", patch.versionTo)) {
+            return false;
+        }
+
+        if (!rows) {
+            return true;
+        }
+
+        processed += rows;
+        ++batch;
+        emit sigDBUpgradeProgress(patch.versionTo, processed);
+    }
+}
+
+bool DataBase::savepoint(const QString &command, unsigned short version) const {
+    return db()->doQuery(QString("%0 upgrade_%1").arg(command).arg(version), {}, true);
+}
+
+bool DataBase::upgradeProgress(unsigned short version, int* batch) const {
+    QSqlQuery query;
+    if (!db()->doQuery("SELECT batch FROM DataBaseUpgradeProgress WHERE version = :version",
+                       {{":version", version}}, true, &query)) {
+        qCritical() << "Failed to read progress of the database upgrade to version" << version;
+        return false;
     }
 
+    // the upgrade is not started yet.
+    *batch = (query.next())? query.value(0).toInt() : -1;
     return true;
 }
 
+void DataBase::onDBPatchApplied(const DBPatch &patch, qint64 msec) const {
+    qInfo() << QString("Data base patch from %0 to %1 versions applied in %2 msec.").
+               arg(patch.versionFrom).arg(patch.versionTo).arg(msec);
+}
+
 void DataBase::onBeforeDBUpgrade(int currentVerion, int ) const {
     backUp(currentVerion);
 }
@@ -280,7 +486,8 @@ QVariantMap DataBase::defaultDbParams() const {
     return {
         {QH_DB_DRIVER, "QSQLITE"},
         {QH_DB_FILE_PATH, DEFAULT_DB_PATH + "/" + localNodeName() + "/" + QCoreApplication::applicationName() + "_" + DEFAULT_DB_NAME},
-        {QH_DB_BACKUP_PATH, DEFAULT_DB_PATH + "/" + localNodeName() + "/BackUp"}
+        {QH_DB_BACKUP_PATH, DEFAULT_DB_PATH + "/" + localNodeName() + "/BackUp"},
+        {QH_DB_PROFILE, DEFAULT_DB_PROFILE}
     };
 }
 
@@ -299,12 +506,23 @@ QVariant DataBase::getDBAttribute(const QString& key, const QVariant& defaultVal
     return defaultVal;
 }
 
+qint64 DataBase::nextId(const QString &table, const QString &field) {
+    if (!_idAllocator)
+        return 0;
+
+    return _idAllocator->nextId(table, field);
+}
+
+KeyValueStore *DataBase::keyValueStore() const {
+    return _keyValueStore;
+}
+
 bool DataBase::setDBAttribute(const QString& key, const QVariant& newValue) {
     auto updateVersionRequest = QSharedPointer<PKG::SetSingleValue>::create(
         DbAddress{"DataBaseAttributes", key},
         "value", newValue, "name");
 
-    if (!_db->replaceObject(updateVersionRequest, true)) {
+    if (!_db->upsertObject(updateVersionRequest, true)) {
 
         qCritical() << "Failed to update " << key << " attribute";
         return false;
@@ -28,6 +28,9 @@ class DbAddress;
 class NodeId;
 class iObjectProvider;
 class AbstractNodeInfo;
+class BackUpTask;
+class IdAllocator;
+class KeyValueStore;
 
 /**
  * @brief The DataBase class is DataBase base implementation.
@@ -114,6 +117,49 @@ public:
      */
     bool setDBAttribute(const QString& key, const QVariant& newValue);
 
+    /**
+     * @brief nextId This method return next unique id of the @a table without queries to database for each id.
+     *  Ids reserved by blocks, so you can set id to the new object and insert it with the wait = false option.
+     * @param table This is name of the table.
+     * @param field This is id field of the table.
+     * @return next id or 0 if the database is not inited.
+     * @see IdAllocator
+     */
+    qint64 nextId(const QString& table, const QString& field = "id");
+
+    /**
+     * @brief keyValueStore This method return in memory key-value storage of this database. Use it for settings, flags and counters that changed often.
+     *  Unlike the getDBAttribute and setDBAttribute methods the store do not send requests to the database for reading and saves changes in background.
+     * @return key-value storage or nullptr if database is not inited.
+     * @see KeyValueStore
+     */
+    KeyValueStore* keyValueStore() const;
+
+    /**
+     * @brief isWarm This method return true if all tables added by the addPreloadTable method are loaded into memory.
+     *  The database works while warming up too, but requests to not loaded tables go to the database.
+     * @return true if warm up is finished.
+     * @see DataBase::addPreloadTable
+     */
+    bool isWarm() const;
+
+    /**
+     * @brief sqlStatistics This method return execution statistics of the all sql statements of this database sorted by the total execution time.
+     *  Use it for finding of the slow queries. Queries slower then QH_DB_SLOW_QUERY_MSEC are printed into log too.
+     * @return list of the statements statistics or empty list if database is not inited.
+     * @see SqlDBWriter::statistics
+     */
+    QList<SqlStatementStats> sqlStatistics() const;
+
+    /**
+     * @brief createBackUpTask This method creates task that makes online backups of the database into backup folder (see QH_DB_BACKUP_PATH) every @a interval.
+     *  Use the AbstractNode::sheduleTask method for start the task.
+     * @param interval This is interval between backups in milliseconds.
+     * @return task object or nullptr if database is not inited or do not have backup path.
+     * @see BackUpTask
+     */
+    QSharedPointer<BackUpTask> createBackUpTask(quint64 interval) const;
+
 signals:
 
     /**
@@ -134,10 +180,33 @@ signals:
      */
     void sigObjectDeleted(const QH::DbAddress& obj);
 
+    /**
+     * @brief sigDBUpgradeProgress This signal emitted after each finished batch of the streaming database patch.
+     * @param versionTo This is target version of the patch.
+     * @param processedRows This is count of the processed rows.
+     * @see DBPatch::batchAction
+     */
+    void sigDBUpgradeProgress(unsigned short versionTo, qint64 processedRows);
+
+    /**
+     * @brief sigWarmUpProgress This signal emitted after loading of each batch of the preloaded table.
+     * @param table This is name of the loading table.
+     * @param loaded This is count of the loaded rows.
+     * @param total This is count of rows of the table.
+     * @see DataBase::addPreloadTable
+     */
+    void sigWarmUpProgress(const QString& table, int loaded, int total);
+
+    /**
+     * @brief sigWarmUpFinished This signal emitted when all preloaded tables are loaded.
+     * @param success This is false if one of tables can not be loaded. Requests to this table go to the database.
+     */
+    void sigWarmUpFinished(bool success);
+
 protected:
 
     /**
-     * @brief backUp This method make a backup of database.
+     * @brief backUp This method make a backup of database. The backup uses the SqlDBWriter::backUp method, so it is consistent even if database has active transactions.
      * @param version This is current version of db.
      * @return path to backupped db.
      */
@@ -173,6 +242,12 @@ protected:
      */
     ISqlDB* db() const;
 
+    /**
+     * @brief idAllocator This method return allocator of the unique ids of tables.
+     * @return allocator of ids or nullptr if database is not inited.
+     */
+    IdAllocator* idAllocator() const;
+
     /**
      * @brief welcomeAddress This method send to the node information about self.
      * Override this method if you want send custom data to incoming connection.
@@ -293,6 +368,17 @@ protected:
      */
     void addDBPatch(const DBPatch& patch);
 
+    /**
+     * @brief addPreloadTable This method registers the table of the @a templateObject for loading into memory after initialization of database.
+     *  Tables are loaded in background (see ISqlDB::preloadResident), so node starts work immediately.
+     * @param templateObject This is object of the table.
+     * @param indexes This is secondary indexes of the table (field: type of index).
+     * @note This method must be invoked before the DataBase::run method.
+     * @see DataBase::isWarm
+     */
+    void addPreloadTable(const QSharedPointer<PKG::DBObject>& templateObject,
+                         const QHash<QString, ResidentTable::IndexType>& indexes = {});
+
     /**
      * @brief upgradeDataBase This method upgrade data base to actyaly database version.
      * @note The last version of dbPatches is actyaly version.
@@ -310,6 +396,14 @@ protected:
      */
     virtual void onBeforeDBUpgrade(int currentVerion, int tergetVersion) const;
 
+    /**
+     * @brief onDBPatchApplied This method will be invoked after each applied database patch. Use this method for benchmarking of the patches.
+     *  Default implementation prints time of the patch into log.
+     * @param patch This is applied patch.
+     * @param msec This is time of the patch in milliseconds.
+     */
+    virtual void onDBPatchApplied(const DBPatch& patch, qint64 msec) const;
+
 
     /**
      * @brief Get an object by its identifier.
@@ -382,6 +476,8 @@ protected:
      * @brief Save an object in the database.
      *
      * This method saves an object of type @c Object in the database.
+     * If the object already exists then it will be replaced (see the iObjectProvider::replaceObject method).
+     * Use the DataBase::upsertObj method if the existing row should be updated in place.
      *
      * @tparam Object The type of object to save.
      * @param obj The object to save.
@@ -402,6 +498,26 @@ protected:
         return false;
     };
 
+    /**
+     * @brief Insert an object into the database or update the existing object in place.
+     *
+     * Unlike the DataBase::saveObj method the existing row is not removed, so rowid, foreign keys and autoincrement sequence are not changed.
+     * On sqlite older then 3.24 this method works like the DataBase::saveObj method.
+     *
+     * @tparam Object The type of object to save.
+     * @param obj The object to save.
+     * @return true if the object is successfully saved, false otherwise.
+     * @see iObjectProvider::upsertObject
+     */
+    template <class Object>
+    bool upsertObj(const Object& obj) {
+        if (auto&& database = db()) {
+            return database->upsertObject(obj);
+        }
+
+        return false;
+    };
+
     /**
      * @brief insert a new value into database, and save into @a resultId autoincremented id of inserted object.
      *
@@ -468,7 +584,22 @@ private:
 
     bool isForbidenTable(const QString& table);
 
+    bool applyDBPatch(const DBPatch& patch);
+    bool savepoint(const QString& command, unsigned short version) const;
+    bool upgradeProgress(unsigned short version, int* batch) const;
+    void startWarmUp();
+
     ISqlDB *_db = nullptr;
+    IdAllocator *_idAllocator = nullptr;
+    KeyValueStore *_keyValueStore = nullptr;
+
+    struct PreloadTable {
+        QSharedPointer<PKG::DBObject> templateObject;
+        QHash<QString, ResidentTable::IndexType> indexes;
+    };
+
+    QList<PreloadTable> _preloadTables;
+    QList<QFuture<bool>> _warmUp;
     unsigned short _targetDBVersion = 0;
     DBPatchMap _dbPatches;
     QString _localNodeName;
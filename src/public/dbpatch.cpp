@@ -10,7 +10,7 @@
 namespace QH {
 
 bool DBPatch::isValid() const {
-    return versionFrom < versionTo && action;
+    return versionFrom < versionTo && (action || batchAction);
 }
 
 }
@@ -21,6 +21,7 @@ namespace QH {
  *
  * @note version is version number of the current database.
  * After execute this path version of data base will be increment.
+ * @note Each patch executed in the transaction (savepoint), so if the patch failed then all changes of the patch will be rolled back.
  */
 struct DBPatch {
     /// This is version of data base that need to up.
@@ -34,6 +35,12 @@ struct DBPatch {
     /// This is lymbda function with action that will upgrade data base to new versio.
     std::function<bool (QH::iObjectProvider *)> action;
 
+    /// This is optional function for the streaming migration of the big tables.
+    /// The function will be invoked for each batch (starts from 0) until it returns 0. The function should return count of processed rows or -1 if the migration is failed.
+    /// Each batch works in own transaction, so interrupted upgrade will be continued from the last finished batch.
+    /// The action function (if exists) invoked before the first batch.
+    std::function<int (QH::iObjectProvider *, int batch)> batchAction;
+
     /**
      * @brief isValid This method check this oject to valid.
      * @return true if object is valid else false.
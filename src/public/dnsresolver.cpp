@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#include "dnsresolver.h"
+
+#include <QDateTime>
+#include <QMutexLocker>
+#include <algorithm>
+
+namespace QH {
+
+DnsResolver::DnsResolver() {
+
+}
+
+DnsResolver::~DnsResolver() {
+
+}
+
+DnsResolver *DnsResolver::instance() {
+    static DnsResolver resolver;
+    return &resolver;
+}
+
+void DnsResolver::resolve(const QString &name, const LookupResult &result) {
+    if (!result)
+        return;
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    QMutexLocker locker(&_mutex);
+
+    auto it = _cache.find(name);
+    if (it != _cache.end()) {
+        if (it->pending) {
+            it->waiters.push_back(result);
+            return;
+        }
+
+        _order.splice(_order.end(), _order, it->order);
+
+        if (it->expire > now) {
+            const QHostInfo info = selectAddresses(*it);
+            locker.unlock();
+
+            result(info);
+            return;
+        }
+    }
+
+    if (it == _cache.end()) {
+        // expired records are removed time to time, the limit is kept by removing of the least recently used records.
+        if (now >= _nextSweep) {
+            _nextSweep = now + DNS_CACHE_SWEEP_INTERVAL;
+            removeExpired(now);
+        }
+
+        while (_cache.size() >= std::max(_cacheLimit, 1)) {
+            const auto size = _cache.size();
+            removeOldest();
+            if (size == _cache.size()) {
+                break;
+            }
+        }
+    }
+
+    auto &record = (it != _cache.end())? *it : insertRecord(name);
+    record.pending = true;
+    record.waiters.push_back(result);
+
+    locker.unlock();
+
+    lookup(name, [this, name](const QHostInfo& info) {
+        handleResult(name, info);
+    });
+}
+
+void DnsResolver::reverseLookup(const QHostAddress &address, const LookupResult &result) {
+    if (!result)
+        return;
+
+    if (!isReverseLookupEnabled() || address.isNull()) {
+        result(QHostInfo{});
+        return;
+    }
+
+    // QHostInfo runs the reverse lookup when receive an ip address instead of a domain name.
+    resolve(address.toString(), result);
+}
+
+void DnsResolver::setLookupFunction(const LookupFunction &lookupFunction) {
+    QMutexLocker locker(&_mutex);
+    _lookupFunction = lookupFunction;
+}
+
+int DnsResolver::ttl() const {
+    QMutexLocker locker(&_mutex);
+    return _ttl;
+}
+
+void DnsResolver::setTtl(int ttl) {
+    QMutexLocker locker(&_mutex);
+    _ttl = ttl;
+}
+
+int DnsResolver::negativeTtl() const {
+    QMutexLocker locker(&_mutex);
+    return _negativeTtl;
+}
+
+void DnsResolver::setNegativeTtl(int negativeTtl) {
+    QMutexLocker locker(&_mutex);
+    _negativeTtl = negativeTtl;
+}
+
+bool DnsResolver::isReverseLookupEnabled() const {
+    QMutexLocker locker(&_mutex);
+    return _reverseLookup;
+}
+
+void DnsResolver::setReverseLookupEnabled(bool enabled) {
+    QMutexLocker locker(&_mutex);
+    _reverseLookup = enabled;
+}
+
+int DnsResolver::cacheLimit() const {
+    QMutexLocker locker(&_mutex);
+    return _cacheLimit;
+}
+
+void DnsResolver::setCacheLimit(int cacheLimit) {
+    QMutexLocker locker(&_mutex);
+    _cacheLimit = cacheLimit;
+}
+
+int DnsResolver::cacheSize() const {
+    QMutexLocker locker(&_mutex);
+    return _cache.size();
+}
+
+void DnsResolver::clear() {
+    QMutexLocker locker(&_mutex);
+
+    for (auto it = _cache.begin(); it != _cache.end();) {
+        if (it->pending) {
+            ++it;
+        } else {
+            _order.erase(it->order);
+            it = _cache.erase(it);
+        }
+    }
+}
+
+QList<QHostAddress> DnsResolver::happyEyeballsOrder(const QList<QHostAddress> &addresses) {
+    QList<QHostAddress> ipv6;
+    QList<QHostAddress> ipv4;
+
+    for (const auto& address: addresses) {
+        if (address.protocol() == QAbstractSocket::IPv6Protocol) {
+            ipv6.push_back(address);
+        } else {
+            ipv4.push_back(address);
+        }
+    }
+
+    QList<QHostAddress> result;
+    result.reserve(addresses.size());
+
+    for (int i = 0; i < std::max(ipv6.size(), ipv4.size()); ++i) {
+        if (i < ipv6.size())
+            result.push_back(ipv6[i]);
+
+        if (i < ipv4.size())
+            result.push_back(ipv4[i]);
+    }
+
+    return result;
+}
+
+void DnsResolver::lookup(const QString &name, const LookupResult &result) {
+    _mutex.lock();
+    auto lookupFunction = _lookupFunction;
+    _mutex.unlock();
+
+    if (lookupFunction) {
+        lookupFunction(name, result);
+        return;
+    }
+
+    QHostInfo::lookupHost(name, [result](const QHostInfo& info) {
+        result(info);
+    });
+}
+
+void DnsResolver::handleResult(const QString &name, QHostInfo info) {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    if (info.error() == QHostInfo::NoError && info.addresses().isEmpty()) {
+        info.setError(QHostInfo::HostNotFound);
+        info.setErrorString("The host " + name + " has not any addresses.");
+    }
+
+    info.setAddresses(happyEyeballsOrder(info.addresses()));
+
+    QMutexLocker locker(&_mutex);
+
+    auto it = _cache.find(name);
+    auto &record = (it != _cache.end())? *it : insertRecord(name);
+    const auto waiters = record.waiters;
+    record.waiters.clear();
+    record.pending = false;
+    record.info = info;
+    record.nextAddress = 0;
+    record.expire = now + ((info.error() == QHostInfo::NoError)? _ttl : _negativeTtl);
+
+    QList<QHostInfo> results;
+    results.reserve(waiters.size());
+    for (int i = 0; i < waiters.size(); ++i) {
+        results.push_back(selectAddresses(record));
+    }
+
+    if (record.expire <= now) {
+        removeRecord(_cache.find(name));
+    }
+
+    locker.unlock();
+
+    for (int i = 0; i < waiters.size(); ++i) {
+        waiters[i](results[i]);
+    }
+}
+
+QHostInfo DnsResolver::selectAddresses(Record &record) const {
+    auto addresses = record.info.addresses();
+    if (addresses.size() < 2) {
+        return record.info;
+    }
+
+    // round-robin: each request start from the next address of the host.
+    const int start = record.nextAddress++ % addresses.size();
+    std::rotate(addresses.begin(), addresses.begin() + start, addresses.end());
+
+    QHostInfo result = record.info;
+    result.setAddresses(addresses);
+    return result;
+}
+
+DnsResolver::Record &DnsResolver::insertRecord(const QString &name) {
+    auto &record = _cache[name];
+    record.order = _order.insert(_order.end(), name);
+    return record;
+}
+
+void DnsResolver::removeRecord(QHash<QString, Record>::iterator record) {
+    _order.erase(record->order);
+    _cache.erase(record);
+}
+
+void DnsResolver::removeExpired(qint64 now) {
+    for (auto it = _cache.begin(); it != _cache.end();) {
+        if (!it->pending && it->expire <= now) {
+            _order.erase(it->order);
+            it = _cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void DnsResolver::removeOldest() {
+    for (const auto& name: _order) {
+        auto record = _cache.find(name);
+        if (!record->pending) {
+            removeRecord(record);
+            return;
+        }
+    }
+}
+
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#ifndef DNSRESOLVER_H
+#define DNSRESOLVER_H
+
+#include "heart_global.h"
+#include "config.h"
+
+#include <QHash>
+#include <QHostInfo>
+#include <QMutex>
+#include <functional>
+#include <list>
+
+namespace QH {
+
+/**
+ * @brief The DnsResolver class is shared cache of the dns lookups.
+ * All nodes use one instance of this class (see the DnsResolver::instance method), so
+ * many connections to same host or from same ip address do not run the dns work for each connection.
+ *
+ * Features:
+ *  * Cache of the successful lookups with ttl (see the DnsResolver::setTtl method).
+ *  * Negative cache of the failed lookups (see the DnsResolver::setNegativeTtl method).
+ *  * Concurrent lookups of the same name are merged into one request.
+ *  * Addresses of the host sorted by the happy eyeballs rules (ipv6 and ipv4 addresses are interleaved)
+ *    and rotated on each request (round-robin), so connections are distributed between all addresses of the host.
+ *  * Size of the cache is limited, the least recently used records are removed first (see the DnsResolver::setCacheLimit method).
+ *  * Reverse lookups can be disabled (see the DnsResolver::setReverseLookupEnabled method).
+ *  * Lookup backend can be replaced by custom function, for example by local hosts table (see the DnsResolver::setLookupFunction method).
+ *
+ * @note This class is thread safe.
+ */
+class HEARTSHARED_EXPORT DnsResolver
+{
+public:
+
+    /**
+     * @brief LookupResult This is callback of the lookup. Invoked with results of the lookup.
+     * @note The callback can be invoked on any thread (thread of the lookup or thread of the caller if the result is cached),
+     *  so use the QMetaObject::invokeMethod with Qt::QueuedConnection to work with QObjects of other threads.
+     */
+    using LookupResult = std::function<void(const QHostInfo& info)>;
+
+    /**
+     * @brief LookupFunction This is backend of the resolver. Should resolve the name and invoke the result callback.
+     * By default resolver use the QHostInfo::lookupHost method.
+     */
+    using LookupFunction = std::function<void(const QString& name, const LookupResult& result)>;
+
+    DnsResolver();
+    virtual ~DnsResolver();
+
+    /**
+     * @brief instance This method return shared object of the resolver.
+     * @return shared resolver.
+     */
+    static DnsResolver* instance();
+
+    /**
+     * @brief resolve This method resolve the @a name and invoke the @a result callback with list of addresses.
+     * If the name already resolved and ttl of the record is not expired then callback will be invoked immediately.
+     * @param name This is domain name or ip address.
+     * @param result This is callback of the lookup.
+     */
+    void resolve(const QString& name, const LookupResult& result);
+
+    /**
+     * @brief reverseLookup This method search host name of the @a address.
+     * If reverse lookups is disabled then callback will be invoked immediately with empty host info.
+     * @param address This is network address.
+     * @param result This is callback of the lookup.
+     */
+    void reverseLookup(const QHostAddress& address, const LookupResult& result);
+
+    /**
+     * @brief setLookupFunction This method sets new backend of the resolver.
+     * @param lookupFunction This is new backend. Set empty function for use the QHostInfo::lookupHost method.
+     * @note this method do not clear cache, so invoke the DnsResolver::clear method if you want to drop old records.
+     */
+    void setLookupFunction(const LookupFunction& lookupFunction);
+
+    /**
+     * @brief ttl This method return time to live of the successful records in msec.
+     * @return time to live of the successful records.
+     */
+    int ttl() const;
+
+    /**
+     * @brief setTtl This method sets time to live of the successful records in msec. By default it is DNS_CACHE_TTL.
+     * @param ttl new value of the ttl. 0 disable the cache.
+     */
+    void setTtl(int ttl);
+
+    /**
+     * @brief negativeTtl This method return time to live of the failed records in msec.
+     * @return time to live of the failed records.
+     */
+    int negativeTtl() const;
+
+    /**
+     * @brief setNegativeTtl This method sets time to live of the failed records in msec. By default it is DNS_NEGATIVE_CACHE_TTL.
+     * @param negativeTtl new value of the ttl. 0 disable the negative cache.
+     */
+    void setNegativeTtl(int negativeTtl);
+
+    /**
+     * @brief isReverseLookupEnabled This method return true if the reverse lookups is enabled.
+     * @return true if the reverse lookups is enabled.
+     */
+    bool isReverseLookupEnabled() const;
+
+    /**
+     * @brief setReverseLookupEnabled This method enable or disable reverse lookups. By default reverse lookups is enabled.
+     * @param enabled new value.
+     */
+    void setReverseLookupEnabled(bool enabled);
+
+    /**
+     * @brief cacheLimit This method return maximum count of the records in the cache.
+     * @return maximum count of the records in the cache.
+     */
+    int cacheLimit() const;
+
+    /**
+     * @brief setCacheLimit This method sets maximum count of the records in the cache. By default it is DNS_CACHE_SIZE.
+     *  When the cache is full the least recently used record will be removed. Pending lookups are never removed.
+     * @param cacheLimit new value of the limit.
+     */
+    void setCacheLimit(int cacheLimit);
+
+    /**
+     * @brief cacheSize This method return count of the records in the cache.
+     * @return count of the records in the cache.
+     */
+    int cacheSize() const;
+
+    /**
+     * @brief clear This method remove all not pending records from the cache.
+     */
+    void clear();
+
+    /**
+     * @brief happyEyeballsOrder This method sort addresses by happy eyeballs rules (RFC 8305).
+     * The ipv6 and ipv4 addresses will be interleaved, starting with the ipv6 address.
+     * @param addresses This is list of addresses.
+     * @return sorted list of addresses.
+     */
+    static QList<QHostAddress> happyEyeballsOrder(const QList<QHostAddress>& addresses);
+
+private:
+    struct Record {
+        QHostInfo info;
+        qint64 expire = 0;
+        unsigned int nextAddress = 0;
+        bool pending = false;
+        QList<LookupResult> waiters;
+        std::list<QString>::iterator order;
+    };
+
+    void lookup(const QString& name, const LookupResult& result);
+    void handleResult(const QString& name, QHostInfo info);
+    QHostInfo selectAddresses(Record& record) const;
+    Record& insertRecord(const QString& name);
+    void removeRecord(QHash<QString, Record>::iterator record);
+    void removeExpired(qint64 now);
+    void removeOldest();
+
+    QHash<QString, Record> _cache;
+    // names of the records from the least to the most recently used.
+    std::list<QString> _order;
+    qint64 _nextSweep = 0;
+    int _cacheLimit = DNS_CACHE_SIZE;
+    LookupFunction _lookupFunction;
+    int _ttl = DNS_CACHE_TTL;
+    int _negativeTtl = DNS_NEGATIVE_CACHE_TTL;
+    bool _reverseLookup = true;
+
+    mutable QMutex _mutex;
+};
+
+}
+#endif // DNSRESOLVER_H
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef QH_FUTURES_H
+#define QH_FUTURES_H
+
+#include <QFuture>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QList>
+#include <QObject>
+#include <QSharedPointer>
+
+namespace QH {
+
+/**
+ * @brief The Promise class is producer side of the QFuture object. Works on Qt5 and Qt6.
+ * If the promise destroyed before setting of the result (for example the job was dropped from the queue of the destroyed thread)
+ * then the future will be canceled, so waiters never hang.
+ *
+ * @code{cpp}
+ *  auto promise = QSharedPointer<QH::Promise<bool>>::create();
+ *  QMetaObject::invokeMethod(worker, [promise]() {
+ *      promise->setResult(doWork());
+ *  }, Qt::QueuedConnection);
+ *
+ *  return promise->future();
+ * @endcode
+ */
+template<class T>
+class Promise
+{
+public:
+    Promise() {
+        _interface.reportStarted();
+    }
+
+    ~Promise() {
+        if (!_interface.isFinished()) {
+            _interface.reportCanceled();
+            _interface.reportFinished();
+        }
+    }
+
+    Promise(const Promise&) = delete;
+    Promise& operator=(const Promise&) = delete;
+
+    /**
+     * @brief setResult This method sets result of the future and finishes it.
+     * @param result This is result value.
+     */
+    void setResult(const T& result) {
+        _interface.reportResult(result);
+        _interface.reportFinished();
+    }
+
+    /**
+     * @brief future This method return future of this promise.
+     * @return future of this promise.
+     */
+    QFuture<T> future() {
+        return _interface.future();
+    }
+
+private:
+    QFutureInterface<T> _interface;
+};
+
+namespace Futures {
+
+/**
+ * @brief ready This method return already finished future with the @a value.
+ * @param value This is result of the future.
+ * @return finished future.
+ */
+template<class T>
+QFuture<T> ready(const T& value) {
+    Promise<T> promise;
+    promise.setResult(value);
+    return promise.future();
+}
+
+/**
+ * @brief then This method invokes the @a callback in the thread of the @a context object after finishing of the @a future.
+ *  The callback receives the finished future, so check the QFuture::isCanceled before reading of the result.
+ *  Unlike the QFuture::then of Qt6 this method works with Qt5 too.
+ * @param future This is awaited future.
+ * @param context This is context object of the callback. If the context destroyed then callback will not be invoked.
+ * @param callback This is function with signature void(const QFuture<T>&).
+ * @note Invoke this method on the thread of the @a context object.
+ */
+template<class T, class Callback>
+void then(const QFuture<T>& future, QObject* context, Callback callback) {
+    auto watcher = new QFutureWatcher<T>(context);
+    QObject::connect(watcher, &QFutureWatcherBase::finished, context, [watcher, callback]() {
+        callback(watcher->future());
+        watcher->deleteLater();
+    });
+
+    watcher->setFuture(future);
+}
+
+/**
+ * @brief whenAll This method invokes the @a callback in the thread of the @a context object after finishing of all @a futures.
+ *  Use it for running several database queries concurrently.
+ * @param futures This is list of awaited futures. Any QFuture<T> object can be converted to the QFuture<void>.
+ * @param context This is context object of the callback.
+ * @param callback This is function with signature void().
+ * @note Invoke this method on the thread of the @a context object.
+ */
+template<class Callback>
+void whenAll(const QList<QFuture<void>>& futures, QObject* context, Callback callback) {
+    if (futures.isEmpty()) {
+        QMetaObject::invokeMethod(context, callback, Qt::QueuedConnection);
+        return;
+    }
+
+    auto left = QSharedPointer<int>::create(futures.size());
+    for (const auto& future: futures) {
+        then(future, context, [left, callback](const QFuture<void>&) {
+            if (--(*left) == 0) {
+                callback();
+            }
+        });
+    }
+}
+
+}
+}
+#endif // QH_FUTURES_H
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "heartlog.h"
+
+#include <QString>
+#include <chrono>
+
+namespace QH {
+
+const QLoggingCategory &heartLog() {
+    static const QLoggingCategory category("heart");
+    return category;
+}
+
+QString logDump(const QByteArray &data, int limit) {
+    if (data.size() <= limit) {
+        return QString::fromLatin1(data.toHex().toUpper());
+    }
+
+    return QString("%0... (%1 bytes)").
+        arg(QString::fromLatin1(data.left(limit).toHex().toUpper())).arg(data.size());
+}
+
+bool LogRateLimiter::allow(QtMsgType type) {
+    const qint64 now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    qint64 windowStart = _windowStart.load(std::memory_order_relaxed);
+    if (now - windowStart >= LOG_RATE_INTERVAL &&
+        _windowStart.compare_exchange_strong(windowStart, now)) {
+
+        _count.store(0, std::memory_order_relaxed);
+        const int skipped = _skipped.exchange(0);
+        if (skipped) {
+            switch (type) {
+            case QtDebugMsg:
+                qCDebug(heartLog) << skipped << "messages skipped by the log rate limit.";
+                break;
+            case QtInfoMsg:
+                qCInfo(heartLog) << skipped << "messages skipped by the log rate limit.";
+                break;
+            case QtWarningMsg:
+                qCWarning(heartLog) << skipped << "messages skipped by the log rate limit.";
+                break;
+            default:
+                qCCritical(heartLog) << skipped << "messages skipped by the log rate limit.";
+                break;
+            }
+        }
+    }
+
+    if (_count.fetch_add(1, std::memory_order_relaxed) < LOG_RATE_LIMIT) {
+        return true;
+    }
+
+    _skipped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef HEARTLOG_H
+#define HEARTLOG_H
+
+#include "heart_global.h"
+#include "config.h"
+
+#include <QByteArray>
+#include <QLoggingCategory>
+#include <atomic>
+
+/**
+ * Log levels of the heart library. Messages with level less then the HEART_LOG_LEVEL are removed while compilation.
+ * Use the HEART_LOG_LEVEL cmake option for change it.
+ */
+#define HEART_LOG_DEBUG 0
+#define HEART_LOG_INFO 1
+#define HEART_LOG_WARNING 2
+#define HEART_LOG_CRITICAL 3
+
+#ifndef HEART_LOG_LEVEL
+#define HEART_LOG_LEVEL HEART_LOG_DEBUG
+#endif
+
+/**
+ * Logging macros of the heart library. Arguments are calculated only when the message will be printed,
+ * so the messages disabled by the logging rules (for example QT_LOGGING_RULES="heart.debug=false") do not format strings.
+ *
+ * @code{cpp}
+ *  qhDebug() << "Process part" << part->getPakckageNumber();
+ *  qhLimited(Warning) << "Invalid package received." << pkg.toString();
+ * @endcode
+ */
+#if HEART_LOG_LEVEL <= HEART_LOG_DEBUG
+#define qhDebug() qCDebug(QH::heartLog)
+#else
+#define qhDebug() while (false) QMessageLogger().noDebug()
+#endif
+
+#if HEART_LOG_LEVEL <= HEART_LOG_INFO
+#define qhInfo() qCInfo(QH::heartLog)
+#else
+#define qhInfo() while (false) QMessageLogger().noDebug()
+#endif
+
+#if HEART_LOG_LEVEL <= HEART_LOG_WARNING
+#define qhWarning() qCWarning(QH::heartLog)
+#else
+#define qhWarning() while (false) QMessageLogger().noDebug()
+#endif
+
+#if HEART_LOG_LEVEL <= HEART_LOG_CRITICAL
+#define qhCritical() qCCritical(QH::heartLog)
+#else
+#define qhCritical() while (false) QMessageLogger().noDebug()
+#endif
+
+/**
+ * The qhLimited macro prints the message with the @a level (Debug, Info, Warning or Critical) no more then LOG_RATE_LIMIT times per LOG_RATE_INTERVAL for each place of the code.
+ * Messages disabled by the logging rules are not counted by the limit.
+ * Use it for messages that can be caused by the remote nodes.
+ */
+#define qhLimited(level) \
+    for (bool qhLogAllowed = QH::heartLog().isEnabled(Qt##level##Msg) && \
+                             []() -> QH::LogRateLimiter& { static QH::LogRateLimiter limiter; return limiter; }().allow(Qt##level##Msg); \
+         qhLogAllowed; qhLogAllowed = false) qh##level()
+
+namespace QH {
+
+/**
+ * @brief heartLog This is logging category of the heart library ("heart").
+ * @return logging category.
+ */
+HEARTSHARED_EXPORT const QLoggingCategory& heartLog();
+
+/**
+ * @brief logDump This method return hex string of the @a data for the logs. Only first @a limit bytes are printed.
+ * @param data This is dumped data.
+ * @param limit This is maximum count of the printed bytes.
+ * @return hex string with size of the data.
+ */
+HEARTSHARED_EXPORT QString logDump(const QByteArray& data, int limit = LOG_DUMP_LIMIT);
+
+/**
+ * @brief The LogRateLimiter class limits count of the messages of the one place of the code. See the qhLimited macro.
+ *  Count of the skipped messages is printed when the next message is allowed.
+ * @note This class is thread safe.
+ */
+class HEARTSHARED_EXPORT LogRateLimiter
+{
+public:
+    LogRateLimiter() = default;
+
+    /**
+     * @brief allow This method return true if message can be printed.
+     * @param type This is level of the message. Count of the skipped messages is printed with same level.
+     * @return true if limit is not reached.
+     */
+    bool allow(QtMsgType type);
+
+private:
+    std::atomic<qint64> _windowStart{0};
+    std::atomic<int> _count{0};
+    std::atomic<int> _skipped{0};
+};
+
+}
+#endif // HEARTLOG_H
@@ -7,6 +7,7 @@
 
 
 #include "hostaddress.h"
+#include "hostaddresskey.h"
 #include <QDataStream>
 #include <quasarapp.h>
 namespace QH {
@@ -98,17 +99,11 @@ bool operator ==(const HostAddress &left, const HostAddress &right) {
 }
 
 bool operator !=(const HostAddress &left, const HostAddress &right) {
-    return base(left)->operator!=(*base(right)) && left.port() != right.port();
+    return !(left == right);
 }
 
-uint qHash(const HostAddress &address) {
-
-    if (QHostAddress(address.toIPv4Address()).operator==(QHostAddress::LocalHost) ||
-            QHostAddress(address.toIPv6Address()).operator==(QHostAddress::LocalHostIPv6)) {
-        return qHash(QString("%1:%2").arg(address.toString()).arg(address.port()));
-    }
-
-    return qHash(*static_cast<const QHostAddress*>(&address));
+qhash_result_t qHash(const HostAddress &address, qhash_result_t seed) {
+    return qHash(HostAddressKey{address}, seed);
 }
 
 }
@@ -12,6 +12,7 @@
 
 #include <QHostAddress>
 #include "config.h"
+#include "hostaddresskey.h"
 
 namespace QH {
 
@@ -85,7 +86,15 @@ private:
 
 };
 
-uint qHash(const HostAddress& address);
+/**
+ * @brief qHash This is hash function of the HostAddress class. The hash contains the address and port of the host.
+ * @note This function do not allocate memory.
+ * @param address Input data.
+ * @param seed seed of the hash.
+ * @return hash code
+ * @see HostAddressKey
+ */
+qhash_result_t qHash(const HostAddress& address, qhash_result_t seed = 0);
 }
 
 Q_DECLARE_METATYPE(QH::HostAddress);
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#include "hostaddresskey.h"
+#include "hostaddress.h"
+
+namespace QH {
+
+HostAddressKey::HostAddressKey(const HostAddress &address) {
+    // toIPv6Address returns the ::ffff:a.b.c.d for ipv4 addresses and zeros for the null address.
+    const Q_IPV6ADDR ip = address.toIPv6Address();
+
+    for (int i = 0; i < 8; ++i) {
+        _high = (_high << 8) | ip[i];
+        _low = (_low << 8) | ip[i + 8];
+    }
+
+    _port = address.port();
+}
+
+HostAddressKey::HostAddressKey(quint64 high, quint64 low, unsigned short port):
+    _high(high),
+    _low(low),
+    _port(port) {
+
+}
+
+HostAddress HostAddressKey::toHostAddress() const {
+    if (!_high && !_low) {
+        return HostAddress{QHostAddress{}, _port};
+    }
+
+    if (!_high && (_low >> 32) == 0xffffULL) {
+        return HostAddress{QHostAddress{static_cast<quint32>(_low)}, _port};
+    }
+
+    Q_IPV6ADDR ip;
+    for (int i = 0; i < 8; ++i) {
+        ip[7 - i] = static_cast<quint8>(_high >> (i * 8));
+        ip[15 - i] = static_cast<quint8>(_low >> (i * 8));
+    }
+
+    return HostAddress{QHostAddress{ip}, _port};
+}
+
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+
+#ifndef HOSTADDRESSKEY_H
+#define HOSTADDRESSKEY_H
+
+#include "heart_global.h"
+
+#include <QtGlobal>
+
+namespace QH {
+
+class HostAddress;
+
+/**
+ * @brief qhash_result_t This is type of the qHash function result. Qt6 use the size_t type for hashes, but Qt5 use the uint.
+ */
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+using qhash_result_t = uint;
+#else
+using qhash_result_t = size_t;
+#endif
+
+/**
+ * @brief The HostAddressKey class is compact hash key of the network address.
+ * Contains 128 bit of the ip address (ipv4 addresses are mapped into the ipv6 ::ffff:a.b.c.d space) and network port.
+ * This key do not allocate any memory and can be compared and hashed very fast,
+ * so use it as a key of the big connections maps instead of the HostAddress class.
+ * @see HostAddress
+ */
+class HEARTSHARED_EXPORT HostAddressKey
+{
+public:
+    HostAddressKey() = default;
+    HostAddressKey(const HostAddress& address);
+    HostAddressKey(quint64 high, quint64 low, unsigned short port);
+
+    /**
+     * @brief high This method return high 64 bits of the ipv6 address.
+     * @return high 64 bits of the ipv6 address.
+     */
+    quint64 high() const {
+        return _high;
+    }
+
+    /**
+     * @brief low This method return low 64 bits of the ipv6 address.
+     * @return low 64 bits of the ipv6 address.
+     */
+    quint64 low() const {
+        return _low;
+    }
+
+    /**
+     * @brief port This method return network port of the key.
+     * @return network port.
+     */
+    unsigned short port() const {
+        return _port;
+    }
+
+    /**
+     * @brief toHostAddress This method restore the HostAddress object from this key.
+     * @note ipv4 mapped addresses will be restored as ipv4 addresses.
+     * @return network address.
+     */
+    HostAddress toHostAddress() const;
+
+    /**
+     * @brief hash This method calc mixed 64 bit hash of the address and port.
+     * @param seed This is seed of the hash function.
+     * @return hash value.
+     */
+    quint64 hash(quint64 seed = 0) const {
+        quint64 h = mix(_high ^ seed);
+        h = mix(h ^ _low);
+        return mix(h ^ _port);
+    }
+
+    bool operator == (const HostAddressKey& right) const {
+        return _low == right._low && _port == right._port && _high == right._high;
+    }
+
+    bool operator != (const HostAddressKey& right) const {
+        return !operator==(right);
+    }
+
+private:
+    /**
+     * @brief mix This is finalizer of the splitmix64 generator.
+     */
+    static quint64 mix(quint64 value) {
+        value += 0x9e3779b97f4a7c15ULL;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+
+    quint64 _high = 0;
+    quint64 _low = 0;
+    unsigned short _port = 0;
+};
+
+/**
+ * @brief qHash This is hash function of the HostAddressKey class.
+ * @param key Input data.
+ * @param seed seed of the hash.
+ * @return hash code
+ */
+inline qhash_result_t qHash(const HostAddressKey& key, qhash_result_t seed = 0) {
+    const quint64 hash = key.hash(seed);
+    return static_cast<qhash_result_t>(hash ^ (hash >> 32));
+}
+
+}
+
+#endif // HOSTADDRESSKEY_H
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "idallocator.h"
+#include "sqldbwriter.h"
+
+#include <QDebug>
+#include <QSqlQuery>
+#include <QThread>
+
+namespace QH {
+
+// This function works on the thread of the writer, so the update and the select of the sequence can not be mixed with other reservations.
+static bool reserveBlock(const SqlDBWriter* writer,
+                         const QString& table,
+                         const QString& field,
+                         int size,
+                         qint64& last) {
+
+    if (!writer->doQuery("CREATE TABLE IF NOT EXISTS DataBaseSequences ("
+                         "name TEXT NOT NULL PRIMARY KEY, value INTEGER NOT NULL)", {}, true)) {
+        return false;
+    }
+
+    if (!writer->doQuery("SAVEPOINT id_block", {}, true)) {
+        return false;
+    }
+
+    auto rollback = [writer]() {
+        writer->doQuery("ROLLBACK TO id_block", {}, true);
+        writer->doQuery("RELEASE id_block", {}, true);
+        return false;
+    };
+
+    QSqlQuery query;
+    if (!writer->doQuery("UPDATE DataBaseSequences SET value = value + :size WHERE name = :name",
+                         {{":size", size}, {":name", table}}, true, &query)) {
+        return rollback();
+    }
+
+    if (query.numRowsAffected() <= 0) {
+        // the first block of the table starts after the existing rows.
+        const QString insert = QString("INSERT INTO DataBaseSequences (name, value) "
+                                       "SELECT :name, COALESCE(MAX(%0), 0) + :size FROM %1").arg(field, table);
+
+        if (!writer->doQuery(insert, {{":name", table}, {":size", size}}, true)) {
+            return rollback();
+        }
+    }
+
+    if (!writer->doQuery("SELECT value FROM DataBaseSequences WHERE name = :name",
+                         {{":name", table}}, true, &query) || !query.next()) {
+        return rollback();
+    }
+
+    last = query.value(0).toLongLong();
+
+    return writer->doQuery("RELEASE id_block", {}, true);
+}
+
+IdSequence::IdSequence(const QString &table, const QString &field, int blockSize, const SqlDBWriter *writer) {
+    _table = table;
+    _field = field;
+    _blockSize = std::max(1, blockSize);
+    _writer = writer;
+}
+
+IdSequence::~IdSequence() {
+    for (auto block: std::as_const(_blocks)) {
+        delete block;
+    }
+}
+
+qint64 IdSequence::next() {
+    Block* block = _current.load(std::memory_order_acquire);
+
+    if (block) {
+        const qint64 id = block->next.fetch_add(1, std::memory_order_relaxed);
+        if (id <= block->last) {
+            if (id == block->prefetchAt) {
+                prefetch();
+            }
+
+            return id;
+        }
+    }
+
+    return nextSlow(block);
+}
+
+void IdSequence::prefetch() {
+    QMutexLocker locker(&_mutex);
+    prefetchLocked();
+}
+
+const QString &IdSequence::table() const {
+    return _table;
+}
+
+int IdSequence::blockSize() const {
+    return _blockSize;
+}
+
+qint64 IdSequence::nextSlow(Block *exhausted) {
+
+    forever {
+        QMutexLocker locker(&_mutex);
+
+        if (_current.load(std::memory_order_acquire) != exhausted) {
+            // other thread already installed the new block.
+            locker.unlock();
+            return next();
+        }
+
+        prefetchLocked();
+
+        if (_prefetch.isFinished()) {
+            _prefetching = false;
+
+            if (_prefetch.isCanceled() || !_prefetch.resultCount()) {
+                qCritical() << "Failed to reserve ids for the" << _table << "table";
+                return 0;
+            }
+
+            return install(_prefetch.result());
+        }
+
+        if (QThread::currentThread() == _writer->thread()) {
+            // the prefetch job waits in the queue of this thread, so reserve the block directly.
+            qint64 last = 0;
+            if (!reserve(last)) {
+                qCritical() << "Failed to reserve ids for the" << _table << "table";
+                return 0;
+            }
+
+            return install(last);
+        }
+
+        // do not hold the mutex while waiting, the writer thread can use this sequence too.
+        auto future = _prefetch;
+        locker.unlock();
+        future.waitForFinished();
+    }
+}
+
+void IdSequence::prefetchLocked() {
+    if (_prefetching) {
+        return;
+    }
+
+    const SqlDBWriter* writer = _writer;
+    const QString table = _table;
+    const QString field = _field;
+    const int size = _blockSize;
+
+    _prefetch = _writer->asyncFuture<qint64>([writer, table, field, size](qint64& last) {
+        return reserveBlock(writer, table, field, size, last);
+    });
+
+    _prefetching = true;
+}
+
+qint64 IdSequence::install(qint64 last) {
+    const qint64 first = last - _blockSize + 1;
+
+    auto block = new Block;
+    block->next.store(first + 1, std::memory_order_relaxed);
+    block->last = last;
+    block->prefetchAt = first + _blockSize / 2;
+    _blocks.push_back(block);
+
+    _current.store(block, std::memory_order_release);
+
+    if (first == block->prefetchAt) {
+        prefetchLocked();
+    }
+
+    return first;
+}
+
+bool IdSequence::reserve(qint64 &last) const {
+    return reserveBlock(_writer, _table, _field, _blockSize, last);
+}
+
+IdAllocator::IdAllocator(const SqlDBWriter *writer, int blockSize) {
+    _writer = writer;
+    _blockSize = blockSize;
+}
+
+IdAllocator::~IdAllocator() {
+    for (auto sequence: std::as_const(_sequences)) {
+        delete sequence;
+    }
+}
+
+IdSequence *IdAllocator::sequence(const QString &table, const QString &field) {
+    {
+        QReadLocker locker(&_lock);
+        if (auto result = _sequences.value(table)) {
+            return result;
+        }
+    }
+
+    QWriteLocker locker(&_lock);
+    auto &result = _sequences[table];
+    if (!result) {
+        result = new IdSequence(table, field, _blockSize, _writer);
+    }
+
+    return result;
+}
+
+qint64 IdAllocator::nextId(const QString &table, const QString &field) {
+    return sequence(table, field)->next();
+}
+
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef IDALLOCATOR_H
+#define IDALLOCATOR_H
+
+#include "heart_global.h"
+#include "config.h"
+
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QString>
+#include <atomic>
+
+namespace QH {
+
+class SqlDBWriter;
+
+/**
+ * @brief The IdSequence class is sequence of the unique ids of the one table.
+ *  The sequence reserves blocks of ids in the DataBaseSequences table (hi/lo algorithm),
+ *  so the id can be assigned to the object before the object will be inserted (for example by the insertObject method with wait = false).
+ *
+ *  The next method takes ids from the current block without locks, so it can be invoked on any thread.
+ *  The next block is reserved asynchronously when the half of the current block is used.
+ *  Ids of the reserved but not used blocks are lost after restart, so the sequence has gaps.
+ *
+ * @note All tables that use the sequence must get ids only from it.
+ * @see IdAllocator
+ */
+class HEARTSHARED_EXPORT IdSequence
+{
+public:
+    /**
+     * @brief IdSequence This is main constructor of the sequence.
+     * @param table This is name of the table.
+     * @param field This is id field of the table. The max value of this field is first value of the sequence.
+     * @param blockSize This is count of ids that reserved by the one database query.
+     * @param writer This is database writer.
+     */
+    IdSequence(const QString& table, const QString& field, int blockSize, const SqlDBWriter* writer);
+    ~IdSequence();
+
+    IdSequence(const IdSequence&) = delete;
+    IdSequence& operator=(const IdSequence&) = delete;
+
+    /**
+     * @brief next This method return next unique id of the table.
+     * @return next id or 0 if the database is not available.
+     */
+    qint64 next();
+
+    /**
+     * @brief prefetch This method starts asynchronous reservation of the next block if it is not started yet.
+     */
+    void prefetch();
+
+    /**
+     * @brief table This method return name of the table of this sequence.
+     * @return name of the table.
+     */
+    const QString& table() const;
+
+    /**
+     * @brief blockSize This method return count of ids that reserved by the one database query.
+     * @return size of the block.
+     */
+    int blockSize() const;
+
+private:
+    struct Block {
+        std::atomic<qint64> next{0};
+        qint64 last = 0;
+        qint64 prefetchAt = 0;
+    };
+
+    qint64 nextSlow(Block* exhausted);
+    void prefetchLocked();
+    qint64 install(qint64 last);
+    bool reserve(qint64& last) const;
+
+    QString _table;
+    QString _field;
+    int _blockSize = DB_ID_BLOCK_SIZE;
+    const SqlDBWriter* _writer = nullptr;
+
+    std::atomic<Block*> _current{nullptr};
+
+    QMutex _mutex;
+    QFuture<qint64> _prefetch;
+    bool _prefetching = false;
+
+    // used blocks are not deleted while the sequence is alive, because other threads can read them without locks.
+    QList<Block*> _blocks;
+};
+
+/**
+ * @brief The IdAllocator class is collection of the IdSequence objects, one for each table.
+ *  Use it instead of the GetMaxIntegerId requests for generation of the new ids.
+ *
+ * @code{cpp}
+ *  auto obj = QSharedPointer<MyObject>::create();
+ *  obj->setId(idAllocator()->nextId(obj->table()));
+ *  db()->insertObject(obj, false);
+ * @endcode
+ *
+ * @see DataBase::nextId
+ */
+class HEARTSHARED_EXPORT IdAllocator
+{
+public:
+    /**
+     * @brief IdAllocator This is main constructor.
+     * @param writer This is database writer.
+     * @param blockSize This is count of ids that reserved by the one database query.
+     */
+    explicit IdAllocator(const SqlDBWriter* writer, int blockSize = DB_ID_BLOCK_SIZE);
+    ~IdAllocator();
+
+    IdAllocator(const IdAllocator&) = delete;
+    IdAllocator& operator=(const IdAllocator&) = delete;
+
+    /**
+     * @brief sequence This method return sequence of the @a table. The sequence will be created if it is not exists.
+     *  Keep the result pointer for the hot paths, it is valid while this allocator is alive.
+     * @param table This is name of the table.
+     * @param field This is id field of the table.
+     * @return sequence of the table.
+     */
+    IdSequence* sequence(const QString& table, const QString& field = "id");
+
+    /**
+     * @brief nextId This method return next unique id of the @a table.
+     * @param table This is name of the table.
+     * @param field This is id field of the table.
+     * @return next id or 0 if the database is not available.
+     */
+    qint64 nextId(const QString& table, const QString& field = "id");
+
+private:
+    const SqlDBWriter* _writer = nullptr;
+    int _blockSize = DB_ID_BLOCK_SIZE;
+
+    QReadWriteLock _lock;
+    QHash<QString, IdSequence*> _sequences;
+};
+
+}
+#endif // IDALLOCATOR_H
@@ -6,6 +6,9 @@
 */
 
 #include "iobjectprovider.h"
+#include "futures.h"
+
+#include <QSqlQuery>
 
 namespace QH {
 using namespace PKG;
@@ -34,4 +37,95 @@ QSharedPointer<DBObject> iObjectProvider::getObjectRaw(
     return list.first();
 }
 
+bool iObjectProvider::upsertObject(const QSharedPointer<DBObject> &saveObject, bool wait) {
+    return replaceObject(saveObject, wait);
+}
+
+bool iObjectProvider::insertObjects(const QList<QSharedPointer<DBObject>> &objects,
+                                    bool wait,
+                                    const QWeakPointer<QList<unsigned int>> &autoincrementIdsResult) {
+
+    auto ids = autoincrementIdsResult.lock();
+    if (ids) {
+        ids->clear();
+    }
+
+    for (const auto& object: objects) {
+        auto id = QSharedPointer<unsigned int>::create(0);
+        if (!insertObject(object, wait || ids, id)) {
+            return false;
+        }
+
+        if (ids) {
+            ids->push_back(*id);
+        }
+    }
+
+    return true;
+}
+
+bool iObjectProvider::replaceObjects(const QList<QSharedPointer<DBObject>> &objects, bool wait) {
+    for (const auto& object: objects) {
+        if (!replaceObject(object, wait)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QFuture<QList<QSharedPointer<DBObject>>>
+iObjectProvider::getAllObjectsAsync(const QSharedPointer<DBObject> &templateObject) {
+    Promise<QList<QSharedPointer<DBObject>>> promise;
+
+    QList<QSharedPointer<DBObject>> result;
+    if (templateObject && getAllObjects(*templateObject, result)) {
+        promise.setResult(result);
+    }
+
+    return promise.future();
+}
+
+QFuture<QSharedPointer<DBObject>>
+iObjectProvider::getObjectAsync(const QSharedPointer<DBObject> &templateObject) {
+    if (!templateObject) {
+        return Futures::ready(QSharedPointer<DBObject>{});
+    }
+
+    return Futures::ready(getObjectRaw(*templateObject));
+}
+
+QFuture<bool> iObjectProvider::updateObjectAsync(const QSharedPointer<DBObject> &saveObject) {
+    return Futures::ready(updateObject(saveObject, true));
+}
+
+QFuture<bool> iObjectProvider::replaceObjectAsync(const QSharedPointer<DBObject> &saveObject) {
+    return Futures::ready(replaceObject(saveObject, true));
+}
+
+QFuture<bool> iObjectProvider::insertObjectAsync(const QSharedPointer<DBObject> &saveObject,
+                                                 const QWeakPointer<unsigned int> &autoincrementIdResult) {
+    return Futures::ready(insertObject(saveObject, true, autoincrementIdResult));
+}
+
+QFuture<bool> iObjectProvider::deleteObjectAsync(const QSharedPointer<DBObject> &obj) {
+    return Futures::ready(deleteObject(obj, true));
+}
+
+QFuture<QList<QSqlRecord>> iObjectProvider::doQueryAsync(const QString &query, const QVariantMap &bindValues) const {
+    Promise<QList<QSqlRecord>> promise;
+
+    QSqlQuery result;
+    if (doQuery(query, bindValues, true, &result)) {
+        QList<QSqlRecord> records;
+        while (result.next()) {
+            records.push_back(result.record());
+        }
+
+        promise.setResult(records);
+    }
+
+    return promise.future();
+}
+
 }
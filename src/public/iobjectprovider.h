@@ -9,7 +9,9 @@
 #define IOBJECTPROVIDER_H
 #include "heart_global.h"
 
+#include <QFuture>
 #include <QSharedPointer>
+#include <QSqlRecord>
 #include <dbobject.h>
 #include <quasarapp.h>
 
@@ -83,6 +85,16 @@ public:
      */
     virtual bool replaceObject(const QSharedPointer<PKG::DBObject>& saveObject, bool wait) = 0;
 
+    /**
+     * @brief upsertObject This method inserts the @a saveObject or updates the existing row with same primary key (see DBObject::prepareUpsertQuery).
+     *  Unlike the replaceObject method the existing row is updated in place, so the rowid and foreign keys are not changed.
+     * @param saveObject This is object for saving.
+     * @param wait This arguments force current thread wait for the function finishing.
+     * @return true if object is saved successful else false.
+     * @note Default implementation invokes the replaceObject method.
+     */
+    virtual bool upsertObject(const QSharedPointer<PKG::DBObject>& saveObject, bool wait);
+
     /**
      * @brief updateObject This method execute a update method of the saveObject and save all changes into database.
      * @note This method update object in the database only.
@@ -106,6 +118,31 @@ public:
                               bool wait,
                               const QWeakPointer<unsigned int>& autoincrementIdResult) = 0;
 
+    /**
+     * @brief insertObjects This method inserts the list of objects into database in one transaction.
+     *  All objects must be same type (same table and fields).
+     * @param objects This is list of objects for inserting.
+     * @param wait This arguments force current thread wait for the function finishing.
+     * @param autoincrementIdsResult This is list of ids of the inserted objects (same order as @a objects) for the tables with autoincrement id field.
+     * @return true if all objects inserted successful.
+     * @note Default implementation invokes the insertObject method for each object and stops on the first failed object,
+     *  so the previous objects stay inserted. The SqlDBWriter implementation inserts all objects in one transaction, so if one of objects failed then no one object will be inserted.
+     */
+    virtual bool insertObjects(const QList<QSharedPointer<PKG::DBObject>>& objects,
+                               bool wait,
+                               const QWeakPointer<QList<unsigned int>>& autoincrementIdsResult = {});
+
+    /**
+     * @brief replaceObjects This method inserts or replaces the list of objects in one transaction.
+     *  All objects must be same type (same table and fields).
+     * @param objects This is list of objects for saving.
+     * @param wait This arguments force current thread wait for the function finishing.
+     * @return true if all objects saved successful.
+     * @note Default implementation invokes the replaceObject method for each object and stops on the first failed object,
+     *  so the previous objects stay saved. The SqlDBWriter implementation saves all objects in one transaction.
+     */
+    virtual bool replaceObjects(const QList<QSharedPointer<PKG::DBObject>>& objects, bool wait);
+
     /**
      * @brief deleteObject This method execute a delete method of obj and remove current object from database.
      * @param obj This is object for removing.
@@ -139,6 +176,64 @@ public:
      * @return true if the query finished successful
      */
     virtual bool doSql(const QString& sqlFile, bool wait = true) const = 0;
+
+    /**
+     * @brief getAllObjectsAsync This is non blocking version of the getAllObjects method.
+     * @param templateObject This is template object for prepare a select request. The object must be alive until the future finished, so it is shared pointer.
+     * @return future with list of selected objects. If select failed then future will be canceled.
+     * @note Default implementation invokes the synchronous getAllObjects method and return finished future.
+     * @see Futures::then
+     * @see Futures::whenAll
+     */
+    virtual QFuture<QList<QSharedPointer<PKG::DBObject>>>
+    getAllObjectsAsync(const QSharedPointer<PKG::DBObject>& templateObject);
+
+    /**
+     * @brief getObjectAsync This is non blocking version of the getObjectRaw method.
+     * @param templateObject This is template object with request to database.
+     * @return future with the first selected object or nullptr if object not exists.
+     * @note Default implementation invokes the synchronous getObjectRaw method and return finished future.
+     */
+    virtual QFuture<QSharedPointer<PKG::DBObject>>
+    getObjectAsync(const QSharedPointer<PKG::DBObject>& templateObject);
+
+    /**
+     * @brief updateObjectAsync This is non blocking version of the updateObject method.
+     * @param saveObject This is object for updating.
+     * @return future with result of the updateObject method.
+     */
+    virtual QFuture<bool> updateObjectAsync(const QSharedPointer<PKG::DBObject>& saveObject);
+
+    /**
+     * @brief replaceObjectAsync This is non blocking version of the replaceObject method.
+     * @param saveObject This is object for updating.
+     * @return future with result of the replaceObject method.
+     */
+    virtual QFuture<bool> replaceObjectAsync(const QSharedPointer<PKG::DBObject>& saveObject);
+
+    /**
+     * @brief insertObjectAsync This is non blocking version of the insertObject method.
+     * @param saveObject This is object for inserting.
+     * @param autoincrementIdResult is id of the insert query to the Table with autoincrement id field. The id will be set before finishing of the future.
+     * @return future with result of the insertObject method.
+     */
+    virtual QFuture<bool> insertObjectAsync(const QSharedPointer<PKG::DBObject>& saveObject,
+                                            const QWeakPointer<unsigned int>& autoincrementIdResult = {});
+
+    /**
+     * @brief deleteObjectAsync This is non blocking version of the deleteObject method.
+     * @param obj This is object for removing.
+     * @return future with result of the deleteObject method.
+     */
+    virtual QFuture<bool> deleteObjectAsync(const QSharedPointer<PKG::DBObject>& obj);
+
+    /**
+     * @brief doQueryAsync This is non blocking version of the doQuery method.
+     * @param query This is query that will be executed.
+     * @param bindValues This is values that need to bind before excute query.
+     * @return future with all records of the query result. If query failed then future will be canceled.
+     */
+    virtual QFuture<QList<QSqlRecord>> doQueryAsync(const QString& query, const QVariantMap& bindValues = {}) const;
 };
 
 }
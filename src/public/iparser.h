@@ -72,6 +72,19 @@ public:
         }
     };
 
+    /**
+     * @brief registerPackageTypes This method register all package @a Types and checks collisions of their commands at compile time.
+     * @note All types should use the QH_PACKAGE macross, because commands of the QH_PACKAGE_DYNAMIC packages are not known at compile time.
+     * @see registerPackageType
+     */
+    template<class... Types>
+    void registerPackageTypes() {
+        static_assert(PKG::uniqueCommands<Types...>(),
+                      "The commands of the registered packages are collided. Please change the id of one of packages.");
+
+        (registerPackageType<Types>(), ...);
+    }
+
     /**
      * @brief parsePackage This is main method of all childs classes of an AbstractNode class.
      *  This method work on own thread.
@@ -9,9 +9,13 @@
 #include "sqldbwriter.h"
 
 #include <dbobject.h>
+#include <dbobjectset.h>
 #include <asyncsqldbwriter.h>
+#include <futures.h>
 
 #include <QDateTime>
+#include <QPointer>
+#include <QSqlQuery>
 #include <QtConcurrent/QtConcurrent>
 #include <qaglobalutils.h>
 
@@ -92,7 +96,7 @@ bool ISqlDB::insertObjectP(const QSharedPointer<DBObject> &saveObject,
                    _writer->insertObject(saveObject, wait, autoincrementIdResult);
         }
 
-        pushToQueue(saveObject, CacheAction::Update);
+        pushToQueue(saveObject, CacheAction::Insert);
         globalUpdateDataBase(getMode());
 
         return true;
@@ -111,7 +115,7 @@ bool ISqlDB::replaceObjectP(const QSharedPointer<PKG::DBObject> &saveObject, boo
                    _writer->replaceObject(saveObject, wait);
         }
 
-        pushToQueue(saveObject, CacheAction::Update);
+        pushToQueue(saveObject, CacheAction::Replace);
         globalUpdateDataBase(getMode());
 
         return true;
@@ -121,6 +125,25 @@ bool ISqlDB::replaceObjectP(const QSharedPointer<PKG::DBObject> &saveObject, boo
            _writer->replaceObject(saveObject, wait);
 }
 
+bool ISqlDB::upsertObjectP(const QSharedPointer<PKG::DBObject> &saveObject, bool wait) {
+    if (updateCache(saveObject)) {
+
+        if (getMode() == SqlDBCasheWriteMode::Force) {
+
+            return _writer && _writer->isValid() &&
+                   _writer->upsertObject(saveObject, wait);
+        }
+
+        pushToQueue(saveObject, CacheAction::Upsert);
+        globalUpdateDataBase(getMode());
+
+        return true;
+    }
+
+    return _writer && _writer->isValid() &&
+           _writer->upsertObject(saveObject, wait);
+}
+
 qint64 ISqlDB::getLastUpdateTime() const {
     return lastUpdateTime;
 }
@@ -129,11 +152,59 @@ void ISqlDB::setLastUpdateTime(const qint64 &value) {
     lastUpdateTime = value;
 }
 
+// the stronger action of the two changes of the same row is written, for example update after insert is written as insert.
+static int foldPriority(CacheAction action) {
+    switch (action) {
+    case CacheAction::Update: return 0;
+    case CacheAction::Upsert: return 1;
+    case CacheAction::Insert: return 2;
+    case CacheAction::Replace: return 3;
+    default: return -1;
+    }
+}
+
 void ISqlDB::pushToQueue(const QSharedPointer<DBObject> &obj,
                          CacheAction type) {
-    _saveLaterMutex.lock();
-    _changes.insert(type, obj);
-    _saveLaterMutex.unlock();
+    if (!obj) {
+        return;
+    }
+
+    QMutexLocker lock(&_saveLaterMutex);
+
+    const DbAddress address = obj->dbAddress();
+    if (!address.isValid()) {
+        _otherChanges.push_back({type, obj});
+        return;
+    }
+
+    auto change = _changes.find(address);
+    if (change == _changes.end()) {
+        _changes.insert(address, {type, obj});
+        return;
+    }
+
+    // fold the new change with the delayed change of the same row.
+    if (change->action == CacheAction::Delete) {
+
+        // the deleted row can not be updated.
+        if (type == CacheAction::Update) {
+            return;
+        }
+
+        // the old row is not deleted yet, so the new row should replace it with all fields.
+        if (type != CacheAction::Delete) {
+            type = CacheAction::Replace;
+        }
+
+    } else if (type != CacheAction::Delete) {
+        obj->mergeDirtyFields(*change->object);
+
+        if (foldPriority(change->action) > foldPriority(type)) {
+            type = change->action;
+        }
+    }
+
+    *change = {type, obj};
 }
 
 ISqlDB::ISqlDB(qint64 updateInterval, SqlDBCasheWriteMode mode) {
@@ -158,6 +229,10 @@ void ISqlDB::setWriter(SqlDBWriter *writer) {
 bool ISqlDB::getAllObjects(const DBObject &templateObject,
                            QList<QSharedPointer<QH::PKG::DBObject>> &result) {
 
+    if (selectFromResident(templateObject, result)) {
+        return true;
+    }
+
     result = getFromCache(&templateObject);
     if(result.size()) {
         return true;
@@ -192,6 +267,8 @@ bool ISqlDB::deleteObject(const QSharedPointer<DBObject> &delObj,
         return false;
     }
 
+    removeFromResident(delObj);
+
     if (id.isValid())
         emit sigItemDeleted(id);
 
@@ -206,10 +283,13 @@ bool ISqlDB::updateObject(const QSharedPointer<DBObject> &saveObject,
         return false;
     }
 
+    // the writer clears changed fields of the object after saving.
+    const QSet<QString> fields = saveObject->dirtyFields();
     if (!updateObjectP(saveObject, wait)) {
         return false;
     }
 
+    saveToResident(saveObject, fields, false);
     emit sigItemChanged(saveObject);
 
     return true;
@@ -225,6 +305,7 @@ bool ISqlDB::insertObject(const QSharedPointer<DBObject> &saveObject, bool wait,
         return false;
     }
 
+    saveToResident(saveObject);
     emit sigItemChanged(saveObject);
 
     return true;
@@ -239,11 +320,359 @@ bool ISqlDB::replaceObject(const QSharedPointer<PKG::DBObject> &saveObject, bool
         return false;
     }
 
+    saveToResident(saveObject);
     emit sigItemChanged(saveObject);
 
     return true;
 }
 
+bool ISqlDB::upsertObject(const QSharedPointer<PKG::DBObject> &saveObject, bool wait) {
+    if (!saveObject || !saveObject->isValid()) {
+        return false;
+    }
+
+    const QSet<QString> fields = saveObject->dirtyFields();
+    if (!upsertObjectP(saveObject, wait)) {
+        return false;
+    }
+
+    saveToResident(saveObject, fields, true);
+    emit sigItemChanged(saveObject);
+
+    return true;
+}
+
+bool ISqlDB::insertObjects(const QList<QSharedPointer<DBObject>> &objects, bool wait,
+                           const QWeakPointer<QList<unsigned int>> &autoincrementIdsResult) {
+    for (const auto& object: objects) {
+        if (!object || !object->isValid()) {
+            return false;
+        }
+    }
+
+    if (!_writer || !_writer->isValid() ||
+        !_writer->insertObjects(objects, wait, autoincrementIdsResult)) {
+        return false;
+    }
+
+    for (const auto& object: objects) {
+        if (object->isCached()) {
+            insertToCache(object);
+        }
+
+        saveToResident(object);
+        emit sigItemChanged(object);
+    }
+
+    return true;
+}
+
+bool ISqlDB::replaceObjects(const QList<QSharedPointer<DBObject>> &objects, bool wait) {
+    for (const auto& object: objects) {
+        if (!object || !object->isValid()) {
+            return false;
+        }
+    }
+
+    if (!_writer || !_writer->isValid() ||
+        !_writer->replaceObjects(objects, wait)) {
+        return false;
+    }
+
+    for (const auto& object: objects) {
+        if (object->isCached() && !updateCache(object)) {
+            insertToCache(object);
+        }
+
+        saveToResident(object);
+        emit sigItemChanged(object);
+    }
+
+    return true;
+}
+
+bool ISqlDB::setResident(const QSharedPointer<DBObject> &templateObject,
+                         const QHash<QString, ResidentTable::IndexType> &indexes) {
+
+    if (!templateObject || !_writer || !_writer->isValid()) {
+        return false;
+    }
+
+    // delayed changes should be in the database before loading.
+    globalUpdateDataBase(SqlDBCasheWriteMode::Force);
+
+    QSqlQuery query;
+    if (!_writer->doQuery("SELECT * FROM " + templateObject->table(), {}, true, &query)) {
+        return false;
+    }
+
+    auto table = QSharedPointer<ResidentTable>::create(templateObject->cmd(), indexes);
+    while (query.next()) {
+        auto object = QSharedPointer<DBObject>(templateObject->createDBObject());
+        if (!object || !object->fromSqlRecord(query.record())) {
+            qCritical() << "Failed to load the" << templateObject->table() << "table into memory.";
+            return false;
+        }
+
+        object->clearDirtyFields();
+
+        if (!table->insert(object)) {
+            qCritical() << "The" << templateObject->table() << "table can not be loaded into memory,"
+                           " because the object do not have primary key." << object->toString();
+            return false;
+        }
+    }
+
+    QWriteLocker locker(&_residentLock);
+    _residentTables.insert(templateObject->table(), table);
+
+    return true;
+}
+
+/**
+ * @brief The ISqlDB::PreloadState struct is state of the background loading of the resident table.
+ */
+struct ISqlDB::PreloadState {
+    QSharedPointer<DBObject> templateObject;
+    QSharedPointer<ResidentTable> table;
+    QSharedPointer<Promise<bool>> promise;
+    int batchSize = DB_PRELOAD_BATCH_SIZE;
+    QVariant lastKey;
+    int loaded = 0;
+    int total = -1;
+};
+
+QFuture<bool> ISqlDB::preloadResident(const QSharedPointer<DBObject> &templateObject,
+                                      const QHash<QString, ResidentTable::IndexType> &indexes,
+                                      int batchSize) {
+
+    if (!templateObject || templateObject->primaryKey().isEmpty() ||
+        !_writer || !_writer->isValid()) {
+        return Futures::ready(false);
+    }
+
+    auto state = QSharedPointer<PreloadState>::create();
+    state->templateObject = templateObject;
+    state->table = QSharedPointer<ResidentTable>::create(templateObject->cmd(), indexes);
+    state->table->setLoading(true);
+    state->promise = QSharedPointer<Promise<bool>>::create();
+    state->batchSize = std::max(1, batchSize);
+
+    auto future = state->promise->future();
+
+    {
+        // the table is registered before loading, so changes made while loading are not lost.
+        QWriteLocker locker(&_residentLock);
+        _residentTables.insert(templateObject->table(), state->table);
+    }
+
+    QPointer<ISqlDB> self(this);
+    QMetaObject::invokeMethod(_writer, [self, state]() {
+        if (self) {
+            self->preloadBatch(state);
+        }
+    }, Qt::QueuedConnection);
+
+    return future;
+}
+
+void ISqlDB::preloadBatch(const QSharedPointer<PreloadState> &state) {
+    const QString table = state->templateObject->table();
+    const QString primaryKey = state->templateObject->primaryKey();
+
+    auto fail = [this, &state, &table]() {
+        QWriteLocker locker(&_residentLock);
+        if (_residentTables.value(table) == state->table) {
+            _residentTables.remove(table);
+        }
+
+        state->promise->setResult(false);
+    };
+
+    {
+        // the table removed or replaced while loading.
+        QReadLocker locker(&_residentLock);
+        if (_residentTables.value(table) != state->table) {
+            state->promise->setResult(false);
+            return;
+        }
+    }
+
+    QSqlQuery query;
+    if (state->total < 0) {
+        if (!_writer->doQuery("SELECT COUNT(*) FROM " + table, {}, true, &query) || !query.next()) {
+            fail();
+            return;
+        }
+
+        state->total = query.value(0).toInt();
+    }
+
+    QString queryString = "SELECT * FROM " + table;
+    QVariantMap bindValues;
+    if (state->lastKey.isValid()) {
+        queryString += " WHERE " + primaryKey + " > :lastKey";
+        bindValues.insert(":lastKey", state->lastKey);
+    }
+
+    queryString += QString(" ORDER BY %0 LIMIT %1").arg(primaryKey).arg(state->batchSize);
+
+    if (!_writer->doQuery(queryString, bindValues, true, &query)) {
+        fail();
+        return;
+    }
+
+    QList<QSharedPointer<DBObject>> objects;
+    while (query.next()) {
+        auto object = QSharedPointer<DBObject>(state->templateObject->createDBObject());
+        if (!object || !object->fromSqlRecord(query.record())) {
+            qCritical() << "Failed to load the" << table << "table into memory.";
+            fail();
+            return;
+        }
+
+        object->clearDirtyFields();
+        state->lastKey = query.value(primaryKey);
+        objects.push_back(object);
+    }
+
+    const bool finished = objects.size() < state->batchSize;
+
+    {
+        QWriteLocker locker(&_residentLock);
+        if (_residentTables.value(table) != state->table) {
+            state->promise->setResult(false);
+            return;
+        }
+
+        for (const auto& object: std::as_const(objects)) {
+            if (!state->table->load(object)) {
+                qCritical() << "The" << table << "table can not be loaded into memory,"
+                               " because the object do not have primary key." << object->toString();
+                _residentTables.remove(table);
+                state->promise->setResult(false);
+                return;
+            }
+        }
+
+        if (finished) {
+            state->table->setLoading(false);
+        }
+    }
+
+    for (const auto& object: std::as_const(objects)) {
+        if (object->isCached()) {
+            insertToCache(object);
+        }
+    }
+
+    state->loaded += objects.size();
+    emit sigPreloadProgress(table, state->loaded, std::max(state->total, state->loaded));
+
+    if (finished) {
+        state->promise->setResult(true);
+        return;
+    }
+
+    // next batch goes to the end of the queue, so requests of clients are not blocked by the loading.
+    QPointer<ISqlDB> self(this);
+    QMetaObject::invokeMethod(_writer, [self, state]() {
+        if (self) {
+            self->preloadBatch(state);
+        }
+    }, Qt::QueuedConnection);
+}
+
+void ISqlDB::removeResident(const QString &table) {
+    QWriteLocker locker(&_residentLock);
+    _residentTables.remove(table);
+}
+
+bool ISqlDB::isResident(const QString &table) const {
+    QReadLocker locker(&_residentLock);
+    return _residentTables.contains(table);
+}
+
+QList<SqlStatementStats> ISqlDB::sqlStatistics() const {
+    if (!_writer) {
+        return {};
+    }
+
+    return _writer->statistics();
+}
+
+bool ISqlDB::selectFromResident(const DBObject &templateObject,
+                                QList<QSharedPointer<DBObject>> &result) const {
+
+    auto request = dynamic_cast<const DBObjectSet*>(&templateObject);
+    if (!request) {
+        return false;
+    }
+
+    auto predicate = request->predicate();
+    if (!predicate) {
+        return false;
+    }
+
+    QReadLocker locker(&_residentLock);
+    auto table = _residentTables.value(request->table());
+    if (!table || table->isLoading()) {
+        return false;
+    }
+
+    auto bundle = QSharedPointer<DBObject>(request->createDBObject()).dynamicCast<DBObjectSet>();
+    if (!bundle) {
+        return false;
+    }
+
+    const auto objects = table->select(*predicate);
+    for (const auto& object: objects) {
+        if (!bundle->appendObject(object)) {
+            return false;
+        }
+    }
+
+    result = {bundle};
+
+    return true;
+}
+
+void ISqlDB::saveToResident(const QSharedPointer<DBObject> &object,
+                            const QSet<QString> &fields, bool insertIfMissing) {
+    QWriteLocker locker(&_residentLock);
+
+    auto table = _residentTables.value(object->table());
+    if (table && !table->update(object, fields, insertIfMissing)) {
+        qDebug() << "The" << object->table() << "table removed from memory, because it changed by the"
+                 << object->cmdString() << "object.";
+        _residentTables.remove(object->table());
+    }
+}
+
+void ISqlDB::removeFromResident(const QSharedPointer<DBObject> &object) {
+    QWriteLocker locker(&_residentLock);
+
+    auto table = _residentTables.value(object->table());
+    if (!table) {
+        return;
+    }
+
+    if (object->isBundle()) {
+        // rows that not loaded yet can not be removed by the predicate.
+        auto request = object.dynamicCast<DBObjectSet>();
+        if (request && request->predicate() && !table->isLoading()) {
+            table->remove(*request->predicate());
+            return;
+        }
+    } else if (!object->primaryValue().isNull()) {
+        table->remove(*object);
+        return;
+    }
+
+    // the removed rows are unknown.
+    _residentTables.remove(object->table());
+}
+
 bool ISqlDB::doQuery(const QString &query, const QVariantMap& toBind,
                      bool wait, QSqlQuery *result) const {
 
@@ -262,6 +691,90 @@ bool ISqlDB::doSql(const QString &sqlFile, bool wait) const {
     return _writer->doSql(sqlFile, wait);
 }
 
+QFuture<QList<QSharedPointer<DBObject>>>
+ISqlDB::getAllObjectsAsync(const QSharedPointer<DBObject> &templateObject) {
+    using Result = QList<QSharedPointer<DBObject>>;
+
+    if (!templateObject || !_writer) {
+        return Promise<Result>().future();
+    }
+
+    Result cached;
+    if (selectFromResident(*templateObject, cached)) {
+        return Futures::ready(cached);
+    }
+
+    cached = getFromCache(templateObject.data());
+    if (cached.size()) {
+        return Futures::ready(cached);
+    }
+
+    return _writer->asyncFuture<Result>([this, templateObject](Result& result) {
+        return getAllObjects(*templateObject, result);
+    });
+}
+
+QFuture<QSharedPointer<DBObject>>
+ISqlDB::getObjectAsync(const QSharedPointer<DBObject> &templateObject) {
+    if (!templateObject || !_writer) {
+        return Futures::ready(QSharedPointer<DBObject>{});
+    }
+
+    return _writer->asyncFuture<QSharedPointer<DBObject>>([this, templateObject](QSharedPointer<DBObject>& result) {
+        result = getObjectRaw(*templateObject);
+        return true;
+    });
+}
+
+QFuture<bool> ISqlDB::updateObjectAsync(const QSharedPointer<DBObject> &saveObject) {
+    if (!_writer) {
+        return Futures::ready(false);
+    }
+
+    return _writer->asyncFuture([this, saveObject]() {
+        return updateObject(saveObject, true);
+    });
+}
+
+QFuture<bool> ISqlDB::replaceObjectAsync(const QSharedPointer<DBObject> &saveObject) {
+    if (!_writer) {
+        return Futures::ready(false);
+    }
+
+    return _writer->asyncFuture([this, saveObject]() {
+        return replaceObject(saveObject, true);
+    });
+}
+
+QFuture<bool> ISqlDB::insertObjectAsync(const QSharedPointer<DBObject> &saveObject,
+                                        const QWeakPointer<unsigned int> &autoincrementIdResult) {
+    if (!_writer) {
+        return Futures::ready(false);
+    }
+
+    return _writer->asyncFuture([this, saveObject, autoincrementIdResult]() {
+        return insertObject(saveObject, true, autoincrementIdResult);
+    });
+}
+
+QFuture<bool> ISqlDB::deleteObjectAsync(const QSharedPointer<DBObject> &obj) {
+    if (!_writer) {
+        return Futures::ready(false);
+    }
+
+    return _writer->asyncFuture([this, obj]() {
+        return deleteObject(obj, true);
+    });
+}
+
+QFuture<QList<QSqlRecord>> ISqlDB::doQueryAsync(const QString &query, const QVariantMap &bindValues) const {
+    if (!_writer) {
+        return Promise<QList<QSqlRecord>>().future();
+    }
+
+    return _writer->doQueryAsync(query, bindValues);
+}
+
 bool ISqlDB::init(const QString &initDbParams) {
 
     if (!_writer) {
@@ -326,53 +839,67 @@ void ISqlDB::setMode(const SqlDBCasheWriteMode &mode) {
 void ISqlDB::globalUpdateDataBasePrivate(qint64 currentTime) {
     QMutexLocker lock(&_saveLaterMutex);
 
-    for (auto it = _changes.begin(); it != _changes.end(); ++it) {
+    if (!writer() || !writer()->isValid()) {
+        qCritical() << "writeUpdateItemIntoDB failed when db writer is not inited!";
+        return;
+    }
 
-        if (writer() && writer()->isValid()) {
+    for (const auto& change: std::as_const(_changes)) {
+        saveChange(change);
+    }
 
-            auto obj = it.value();
+    for (const auto& change: std::as_const(_otherChanges)) {
+        saveChange(change);
+    }
 
-            if (!obj || !obj->isValid()) {
-                deleteFromCache(obj);
+    _changes.clear();
+    _otherChanges.clear();
+    setLastUpdateTime(currentTime);
+}
 
-                qCritical() << "writeUpdateItemIntoDB failed when db object is not valid! obj=" << obj->toString();
-                continue;
-            }
+void ISqlDB::saveChange(const CacheChange &change) {
+    auto obj = change.object;
 
-            bool saveResult = false;
+    if (!obj || !obj->isValid()) {
+        deleteFromCache(obj);
 
-            switch (it.key()) {
-            case CacheAction::Insert: {
-                saveResult = writer()->insertObject(obj, true);
-                break;
-            }
-            case CacheAction::Update: {
-                saveResult = writer()->updateObject(obj, true);
-                break;
-            }
-            case CacheAction::Delete: {
-                saveResult = writer()->deleteObject(obj, true);
-                break;
-            }
-            default: {
-                qWarning() << "The Object of the cache have wrong type " << obj->toString();
+        qCritical() << "writeUpdateItemIntoDB failed when db object is not valid! obj=" << (obj? obj->toString() : "null");
+        return;
+    }
 
-                continue;
-            }
-            }
+    bool saveResult = false;
 
-            if (!saveResult ) {
-                qCritical() << "writeUpdateItemIntoDB failed when work globalUpdateDataRelease!!! obj=" << obj->toString();
-            }
-        } else {
+    switch (change.action) {
+    case CacheAction::Insert: {
+        saveResult = writer()->insertObject(obj, true);
+        break;
+    }
+    case CacheAction::Update: {
+        saveResult = writer()->updateObject(obj, true);
+        break;
+    }
+    case CacheAction::Delete: {
+        saveResult = writer()->deleteObject(obj, true);
+        break;
+    }
+    case CacheAction::Replace: {
+        saveResult = writer()->replaceObject(obj, true);
+        break;
+    }
+    case CacheAction::Upsert: {
+        saveResult = writer()->upsertObject(obj, true);
+        break;
+    }
+    default: {
+        qWarning() << "The Object of the cache have wrong type " << obj->toString();
 
-            qCritical() << "writeUpdateItemIntoDB failed when db writer is not inited!";
-            return;
-        }
+        return;
+    }
     }
 
-    _changes.clear();
-    setLastUpdateTime(currentTime);
+    if (!saveResult ) {
+        qCritical() << "writeUpdateItemIntoDB failed when work globalUpdateDataRelease!!! obj=" << obj->toString();
+    }
 }
 
 qint64 ISqlDB::getUpdateInterval() const {
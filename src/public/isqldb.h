@@ -15,7 +15,10 @@
 #include <QSet>
 #include <QVariantMap>
 #include <QMutex>
+#include <QReadWriteLock>
 #include "config.h"
+#include "residenttable.h"
+#include "sqlstatistics.h"
 #include "softdelete.h"
 
 namespace QH {
@@ -49,7 +52,11 @@ enum class CacheAction: int {
     /// Invoke the SqlDBWriter::updateObject method of a private database writer implementation.
     Update,
     /// Invoke the SqlDBWriter::deleteObject method of a private database writer implementation.
-    Delete
+    Delete,
+    /// Invoke the SqlDBWriter::replaceObject method of a private database writer implementation.
+    Replace,
+    /// Invoke the SqlDBWriter::upsertObject method of a private database writer implementation.
+    Upsert
 };
 
 /**
@@ -108,12 +115,41 @@ public:
 
     bool replaceObject(const QSharedPointer<QH::PKG::DBObject>& saveObject,
                        bool wait = false) override;
+    bool upsertObject(const QSharedPointer<QH::PKG::DBObject>& saveObject,
+                      bool wait = false) override;
+
+    /**
+     * @brief insertObjects This method writes all @a objects into database by one bulk query of the writer and only after that saves them into cache.
+     * @note The bulk methods do not use the delayed writing of the cache, because they are used for loading of the large data.
+     */
+    bool insertObjects(const QList<QSharedPointer<QH::PKG::DBObject>>& objects,
+                       bool wait = false,
+                       const QWeakPointer<QList<unsigned int>>& autoincrementIdsResult = {}) override;
+    bool replaceObjects(const QList<QSharedPointer<QH::PKG::DBObject>>& objects,
+                        bool wait = false) override;
 
     bool doQuery(const QString &query, const QVariantMap& bindValues,
                  bool wait = false, QSqlQuery* result = nullptr) const override;
 
     bool doSql(const QString &sqlFile, bool wait) const override;
 
+    /**
+     * @brief getAllObjectsAsync This method return cached objects immediately, and selects objects from the database on the writer thread if cache do not contains them.
+     * @param templateObject This is template object for prepare a select request.
+     * @return future with list of selected objects.
+     * @note All async methods of the cache invoke the synchronous methods on the writer thread, so the cache and signals work as in the synchronous api.
+     */
+    QFuture<QList<QSharedPointer<PKG::DBObject>>>
+    getAllObjectsAsync(const QSharedPointer<PKG::DBObject>& templateObject) override;
+    QFuture<QSharedPointer<PKG::DBObject>>
+    getObjectAsync(const QSharedPointer<PKG::DBObject>& templateObject) override;
+    QFuture<bool> updateObjectAsync(const QSharedPointer<PKG::DBObject>& saveObject) override;
+    QFuture<bool> replaceObjectAsync(const QSharedPointer<PKG::DBObject>& saveObject) override;
+    QFuture<bool> insertObjectAsync(const QSharedPointer<PKG::DBObject>& saveObject,
+                                    const QWeakPointer<unsigned int>& autoincrementIdResult = {}) override;
+    QFuture<bool> deleteObjectAsync(const QSharedPointer<PKG::DBObject>& obj) override;
+    QFuture<QList<QSqlRecord>> doQueryAsync(const QString& query, const QVariantMap& bindValues = {}) const override;
+
     /**
      * @brief changeObjects This method change object of the database.
      * @param templateObject This is template for get objects from database.
@@ -151,6 +187,55 @@ public:
 
     void setSQLSources(const QStringList &list) override;
 
+    /**
+     * @brief setResident This method loads all rows of the table of the @a templateObject into memory.
+     *  After that the DBObjectsRequest requests with the DBPredicate conditions (see DBObjectSet::predicate) are answered from memory without the writer thread.
+     *  All changes made by this object are applied to the resident table too.
+     * @param templateObject This is object of the table. All rows will be created by the DBObject::createDBObject method of this object.
+     * @param indexes This is secondary indexes of the table (field: type of index). See the ResidentTable class.
+     * @return true if table loaded successful.
+     * @note Changes made by the doQuery and doSql methods or by other applications are not visible for the resident tables.
+     *  Invoke this method again for reload of the table.
+     * @warning All rows of the table must have primary keys.
+     */
+    bool setResident(const QSharedPointer<PKG::DBObject>& templateObject,
+                     const QHash<QString, ResidentTable::IndexType>& indexes = {});
+
+    /**
+     * @brief preloadResident This method loads the table of the @a templateObject into memory in background, like the setResident method.
+     *  Rows are selected by batches on the writer thread, so other requests are not blocked while loading.
+     *  Until the loading is finished all select requests go to the database. Changes made while loading are applied to the table too.
+     *  Cached objects (see DBObject::isCached) are saved into the cache.
+     * @param templateObject This is object of the table. The table must have the primary key.
+     * @param indexes This is secondary indexes of the table (field: type of index).
+     * @param batchSize This is count of rows that loaded by the one job of the writer.
+     * @return future with result of the loading. Progress is reported by the sigPreloadProgress signal.
+     * @see DataBase::addPreloadTable
+     */
+    QFuture<bool> preloadResident(const QSharedPointer<PKG::DBObject>& templateObject,
+                                  const QHash<QString, ResidentTable::IndexType>& indexes = {},
+                                  int batchSize = DB_PRELOAD_BATCH_SIZE);
+
+    /**
+     * @brief removeResident This method removes the in memory copy of the @a table. All next requests will be sent to the database.
+     * @param table This is name of the table.
+     */
+    void removeResident(const QString& table);
+
+    /**
+     * @brief isResident This method return true if the @a table is loaded into memory.
+     * @param table This is name of the table.
+     * @return true if the @a table is loaded into memory.
+     */
+    bool isResident(const QString& table) const;
+
+    /**
+     * @brief sqlStatistics This method return execution statistics of the sql statements of the writer.
+     * @return list of the statements statistics or empty list if writer is not set.
+     * @see SqlDBWriter::statistics
+     */
+    QList<SqlStatementStats> sqlStatistics() const;
+
 protected:
     void prepareForDelete() override;
 
@@ -198,6 +283,8 @@ protected:
 
     /**
      * @brief pushToQueue this method should be add the object to the update queue in the physical data dash.
+     *  The changes of the same row are folded into one change: insert after delete is written as replace,
+     *  update after delete is ignored and the other changes are written by the stronger action with merged changed fields.
      * @param obj This is obje for update.
      * @param type This is type of action. For more information see the CacheAction enum.
      */
@@ -240,6 +327,22 @@ private:
                        const QWeakPointer<unsigned int>& autoincrementIdResult);
     bool replaceObjectP(const QSharedPointer<QH::PKG::DBObject>& saveObject,
                         bool wait = false);
+    bool upsertObjectP(const QSharedPointer<QH::PKG::DBObject>& saveObject,
+                       bool wait);
+
+    bool selectFromResident(const PKG::DBObject& templateObject,
+                            QList<QSharedPointer<QH::PKG::DBObject>> &result) const;
+    struct PreloadState;
+    void preloadBatch(const QSharedPointer<PreloadState>& state);
+    /**
+     * @brief saveToResident This method saves the @a object into the resident table.
+     * @param object This is saved object.
+     * @param fields This is changed fields that written by the update query. Empty list means all fields.
+     * @param insertIfMissing This option inserts the object if the table do not contains it (insert and upsert queries).
+     */
+    void saveToResident(const QSharedPointer<QH::PKG::DBObject>& object,
+                        const QSet<QString>& fields = {}, bool insertIfMissing = true);
+    void removeFromResident(const QSharedPointer<QH::PKG::DBObject>& object);
 
     qint64 lastUpdateTime = 0;
     qint64 updateInterval = DEFAULT_UPDATE_INTERVAL;
@@ -248,9 +351,25 @@ private:
 
     SqlDBWriter* _writer = nullptr;
 
-    QHash<CacheAction, QSharedPointer<QH::PKG::DBObject>> _changes;
+    /**
+     * @brief The CacheChange struct is delayed change of the database object.
+     */
+    struct CacheChange {
+        CacheAction action = CacheAction::None;
+        QSharedPointer<QH::PKG::DBObject> object;
+    };
+
+    void saveChange(const CacheChange& change);
+
+    // one change for each database row, so several updates of the row are written by one query.
+    QHash<DbAddress, CacheChange> _changes;
+    // changes of the objects without primary key.
+    QList<CacheChange> _otherChanges;
     QMutex _saveLaterMutex;
 
+    QHash<QString, QSharedPointer<ResidentTable>> _residentTables;
+    mutable QReadWriteLock _residentLock;
+
 signals:
     /**
      * @brief sigItemChanged This signal emitted when database object is changed.
@@ -268,6 +387,14 @@ signals:
      */
     void sigItemDeleted(const QH::DbAddress& obj);
 
+    /**
+     * @brief sigPreloadProgress This signal emitted on the writer thread after loading of each batch of the preloadResident method.
+     * @param table This is name of the loading table.
+     * @param loaded This is count of the loaded rows.
+     * @param total This is count of rows in the table at the start of the loading.
+     */
+    void sigPreloadProgress(const QString& table, int loaded, int total);
+
 };
 
 /**
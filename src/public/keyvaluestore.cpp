@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "keyvaluestore.h"
+#include "sqldbwriter.h"
+#include "config.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QIODevice>
+#include <QSqlQuery>
+#include <QTimer>
+
+namespace QH {
+
+// the format of the stored values should not depend on the Qt version that used to build application.
+#define KEY_VALUE_STREAM_VERSION QDataStream::Qt_5_12
+
+static QByteArray toBytes(const QVariant& value) {
+    QByteArray result;
+    QDataStream stream(&result, QIODevice::WriteOnly);
+    stream.setVersion(KEY_VALUE_STREAM_VERSION);
+    stream << value;
+    return result;
+}
+
+static QVariant fromBytes(const QByteArray& bytes) {
+    QVariant result;
+    QDataStream stream(bytes);
+    stream.setVersion(KEY_VALUE_STREAM_VERSION);
+    stream >> result;
+    return result;
+}
+
+KeyValueStore::KeyValueStore(const SqlDBWriter *writer, const QString &table) {
+    _writer = writer;
+    _table = table;
+    _data = QSharedPointer<Data>::create();
+}
+
+KeyValueStore::~KeyValueStore() {
+    flush(true);
+}
+
+bool KeyValueStore::load() {
+    if (!_writer) {
+        return false;
+    }
+
+    if (!_writer->doQuery(QString("CREATE TABLE IF NOT EXISTS %0 ("
+                                  "name TEXT NOT NULL PRIMARY KEY, value BLOB)").arg(_table), {}, true)) {
+        return false;
+    }
+
+    QSqlQuery query;
+    if (!_writer->doQuery(QString("SELECT name, value FROM %0").arg(_table), {}, true, &query)) {
+        return false;
+    }
+
+    QHash<QString, QVariant> values;
+    while (query.next()) {
+        values.insert(query.value(0).toString(), fromBytes(query.value(1).toByteArray()));
+    }
+
+    QMutexLocker locker(&_data->mutex);
+    // values changed before loading are newer then values of the database.
+    for (const auto& key: std::as_const(_data->dirty)) {
+        values.remove(key);
+        if (_data->values.contains(key)) {
+            values.insert(key, _data->values.value(key));
+        }
+    }
+
+    _data->values = values;
+
+    return true;
+}
+
+QVariant KeyValueStore::value(const QString &key, const QVariant &defaultValue) const {
+    QMutexLocker locker(&_data->mutex);
+    return _data->values.value(key, defaultValue);
+}
+
+bool KeyValueStore::contains(const QString &key) const {
+    QMutexLocker locker(&_data->mutex);
+    return _data->values.contains(key);
+}
+
+void KeyValueStore::setValue(const QString &key, const QVariant &value) {
+    bool schedule = false;
+
+    {
+        QMutexLocker locker(&_data->mutex);
+        _data->values.insert(key, value);
+        schedule = markDirty(key);
+    }
+
+    if (schedule) {
+        flush(false);
+    }
+}
+
+bool KeyValueStore::remove(const QString &key) {
+    bool schedule = false;
+
+    {
+        QMutexLocker locker(&_data->mutex);
+        if (!_data->values.remove(key)) {
+            return false;
+        }
+
+        schedule = markDirty(key);
+    }
+
+    if (schedule) {
+        flush(false);
+    }
+
+    return true;
+}
+
+qint64 KeyValueStore::increment(const QString &key, qint64 delta) {
+    bool schedule = false;
+    qint64 result = 0;
+
+    {
+        QMutexLocker locker(&_data->mutex);
+        result = _data->values.value(key).toLongLong() + delta;
+        _data->values.insert(key, result);
+        schedule = markDirty(key);
+    }
+
+    if (schedule) {
+        flush(false);
+    }
+
+    return result;
+}
+
+bool KeyValueStore::compareAndSet(const QString &key, const QVariant &expected, const QVariant &newValue) {
+    bool schedule = false;
+
+    {
+        QMutexLocker locker(&_data->mutex);
+        if (_data->values.value(key) != expected) {
+            return false;
+        }
+
+        if (newValue.isValid()) {
+            _data->values.insert(key, newValue);
+        } else {
+            _data->values.remove(key);
+        }
+
+        schedule = markDirty(key);
+    }
+
+    if (schedule) {
+        flush(false);
+    }
+
+    return true;
+}
+
+bool KeyValueStore::flush(bool wait) {
+    if (!_writer) {
+        return false;
+    }
+
+    const SqlDBWriter* writer = _writer;
+    const QString table = _table;
+    const QSharedPointer<Data> data = _data;
+
+    Async::Job job = [writer, table, data]() {
+        return write(writer, table, data);
+    };
+
+    return _writer->asyncLauncher(job, wait);
+}
+
+bool KeyValueStore::markDirty(const QString &key) {
+    _data->dirty.insert(key);
+
+    if (_data->flushScheduled) {
+        return false;
+    }
+
+    _data->flushScheduled = true;
+    return true;
+}
+
+bool KeyValueStore::write(const SqlDBWriter *writer, const QString &table, const QSharedPointer<Data> &data) {
+    QHash<QString, QVariant> changed;
+    QSet<QString> removed;
+
+    {
+        QMutexLocker locker(&data->mutex);
+        data->flushScheduled = false;
+
+        for (const auto& key: std::as_const(data->dirty)) {
+            auto value = data->values.constFind(key);
+            if (value != data->values.constEnd()) {
+                changed.insert(key, value.value());
+            } else {
+                removed.insert(key);
+            }
+        }
+
+        data->dirty.clear();
+    }
+
+    if (changed.isEmpty() && removed.isEmpty()) {
+        return true;
+    }
+
+    auto writeAll = [&]() {
+        if (!writer->doQuery("SAVEPOINT key_values", {}, true)) {
+            return false;
+        }
+
+        QSqlQuery query;
+        for (auto it = changed.begin(); it != changed.end(); ++it) {
+            const QVariantMap values = {{":name", it.key()}, {":value", toBytes(it.value())}};
+
+            if (!writer->doQuery(QString("UPDATE %0 SET value = :value WHERE name = :name").arg(table),
+                                 values, true, &query)) {
+                return false;
+            }
+
+            if (query.numRowsAffected() <= 0 &&
+                !writer->doQuery(QString("INSERT INTO %0 (name, value) VALUES (:name, :value)").arg(table),
+                                 values, true)) {
+                return false;
+            }
+        }
+
+        for (const auto& key: std::as_const(removed)) {
+            if (!writer->doQuery(QString("DELETE FROM %0 WHERE name = :name").arg(table),
+                                 {{":name", key}}, true)) {
+                return false;
+            }
+        }
+
+        return writer->doQuery("RELEASE key_values", {}, true);
+    };
+
+    if (writeAll()) {
+        return true;
+    }
+
+    writer->doQuery("ROLLBACK TO key_values", {}, true);
+    writer->doQuery("RELEASE key_values", {}, true);
+
+    qCritical() << "Failed to save values of the" << table << "table. Try again after"
+                << DB_KEY_VALUE_RETRY_MSEC << "msec.";
+
+    // keep keys as changed, so next flush writes them again.
+    QMutexLocker locker(&data->mutex);
+    for (auto it = changed.begin(); it != changed.end(); ++it) {
+        data->dirty.insert(it.key());
+    }
+
+    for (const auto& key: std::as_const(removed)) {
+        data->dirty.insert(key);
+    }
+
+    // new changes already scheduled the next flush.
+    if (data->flushScheduled) {
+        return false;
+    }
+
+    // this code works on the thread of the writer, so the timer will invoke the retry on the same thread.
+    // The retry will be dropped if the writer is destroyed.
+    data->flushScheduled = true;
+    QTimer::singleShot(DB_KEY_VALUE_RETRY_MSEC, writer, [writer, table, data]() {
+        write(writer, table, data);
+    });
+
+    return false;
+}
+
+}
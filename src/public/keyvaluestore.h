@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef KEYVALUESTORE_H
+#define KEYVALUESTORE_H
+
+#include "heart_global.h"
+#include "config.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QSharedPointer>
+#include <QVariant>
+
+namespace QH {
+
+class SqlDBWriter;
+
+/**
+ * @brief The KeyValueStore class is typed key-value storage for the settings, flags and counters of the services.
+ *  All values are kept in the memory and loaded once by the load method, so reading of values do not use the database.
+ *  Changes are written to the database on the writer thread (write-behind). All changes made while previous write is in the queue of the writer are saved by one transaction.
+ *  If the writing failed then the store tries again after DB_KEY_VALUE_RETRY_MSEC msec.
+ *  Values are serialized by the QDataStream with the fixed version, so database can be read by the application built with other Qt version.
+ *
+ * Values are saved into separate table with any QVariant values (see DB_KEY_VALUE_TABLE).
+ *
+ * @code{cpp}
+ *  auto store = keyValueStore();
+ *  store->setValue("featureEnabled", true);
+ *  qint64 requests = store->increment("requests");
+ *  if (store->value<bool>("featureEnabled")) {
+ *      ...
+ *  }
+ * @endcode
+ *
+ * @note This class is thread safe.
+ * @see DataBase::keyValueStore
+ */
+class HEARTSHARED_EXPORT KeyValueStore
+{
+public:
+    /**
+     * @brief KeyValueStore This is main constructor.
+     * @param writer This is database writer.
+     * @param table This is name of the table with values. The table will be created if it is not exists.
+     */
+    explicit KeyValueStore(const SqlDBWriter* writer, const QString& table = DB_KEY_VALUE_TABLE);
+
+    /**
+     * @brief ~KeyValueStore The destructor saves all not saved changes.
+     */
+    ~KeyValueStore();
+
+    KeyValueStore(const KeyValueStore&) = delete;
+    KeyValueStore& operator=(const KeyValueStore&) = delete;
+
+    /**
+     * @brief load This method loads all values from the database. Invoke it once before using of the store.
+     * @return true if values loaded successful.
+     */
+    bool load();
+
+    /**
+     * @brief value This method return value of the @a key.
+     * @param key This is key of the value.
+     * @param defaultValue This is value that will be returned if the @a key is not exists.
+     * @return value of the @a key.
+     */
+    QVariant value(const QString& key, const QVariant& defaultValue = {}) const;
+
+    /**
+     * @brief value This is typed version of the value method.
+     * @param key This is key of the value.
+     * @param defaultValue This is value that will be returned if the @a key is not exists.
+     * @return value of the @a key converted to the T type.
+     */
+    template<class T>
+    T value(const QString& key, const T& defaultValue = {}) const {
+        const QVariant result = value(key);
+        if (!result.isValid()) {
+            return defaultValue;
+        }
+
+        return result.value<T>();
+    }
+
+    /**
+     * @brief contains This method return true if the store contains the @a key.
+     * @param key This is key of the value.
+     * @return true if the @a key is exists.
+     */
+    bool contains(const QString& key) const;
+
+    /**
+     * @brief setValue This method sets new value of the @a key.
+     * @param key This is key of the value.
+     * @param value This is new value.
+     */
+    void setValue(const QString& key, const QVariant& value);
+
+    /**
+     * @brief remove This method removes the @a key.
+     * @param key This is key of the value.
+     * @return true if the key was exists.
+     */
+    bool remove(const QString& key);
+
+    /**
+     * @brief increment This method adds the @a delta to the integer value of the @a key atomically.
+     *  Not existing values are counted as 0.
+     * @param key This is key of the counter.
+     * @param delta This is added value.
+     * @return new value of the counter.
+     */
+    qint64 increment(const QString& key, qint64 delta = 1);
+
+    /**
+     * @brief compareAndSet This method sets the @a newValue only if the current value of the @a key is equal to the @a expected value.
+     *  Use invalid QVariant as the @a expected value for the not existing keys.
+     * @param key This is key of the value.
+     * @param expected This is expected current value.
+     * @param newValue This is new value.
+     * @return true if the value changed.
+     */
+    bool compareAndSet(const QString& key, const QVariant& expected, const QVariant& newValue);
+
+    /**
+     * @brief flush This method writes all not saved changes into database.
+     * @param wait This option force current thread wait for the writing.
+     * @return true if changes saved (or scheduled if @a wait is false).
+     */
+    bool flush(bool wait = false);
+
+private:
+    struct Data {
+        QMutex mutex;
+        QHash<QString, QVariant> values;
+        // changed and removed keys that are not saved yet.
+        QSet<QString> dirty;
+        bool flushScheduled = false;
+    };
+
+    // return true if the new flush should be scheduled.
+    bool markDirty(const QString& key);
+
+    static bool write(const SqlDBWriter* writer, const QString& table, const QSharedPointer<Data>& data);
+
+    const SqlDBWriter* _writer = nullptr;
+    QString _table;
+    QSharedPointer<Data> _data;
+};
+
+}
+#endif // KEYVALUESTORE_H
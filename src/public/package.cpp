@@ -6,6 +6,7 @@
 */
 
 #include "package.h"
+#include "heartlog.h"
 #include <crc/crchash.h>
 #include <QDataStream>
 
@@ -38,7 +39,7 @@ void Package::reset() {
 QString Package::toString() const {
     return QString("Pakcage description: %0."
                    " Data description: Data size - %1, Data: %2").
-        arg(hdr.toString()).arg(data.size()).arg(QString(data.toHex().toUpper()));
+        arg(hdr.toString()).arg(data.size()).arg(logDump(data));
 }
 
 unsigned int Package::calcHash() const {
@@ -48,7 +48,7 @@ public:
     virtual void reset();
 
     /**
-     * @brief toString This method convert a package information to a string label.
+     * @brief toString This method convert a package information to a string label. Only first LOG_DUMP_LIMIT bytes of the data are printed.
      * @return string value of the package.
      */
     QString toString() const;
@@ -8,61 +8,284 @@
 
 #include "packagemanager.h"
 
-#include <package.h>
-#include <ctime>
-#include <config.h>
-#include <packadata.h>
+#include <QDateTime>
+#include <algorithm>
 
 namespace QH {
 
-PackageManager::PackageManager()
-{
+PackageManager::PackageManager(int capacity, qint64 memoryLimit, int ttl):
+    _memoryLimit(memoryLimit),
+    _ttl(ttl) {
 
+    capacity = std::max(capacity, 0);
+
+    // the table is at least two times bigger then count of entries, so the probe sequences are short.
+    int tableSize = 1;
+    while (tableSize < capacity * 2) {
+        tableSize <<= 1;
+    }
+
+    _slots.resize(tableSize);
+    _mask = tableSize - 1;
+
+    _entries.resize(capacity);
+    for (int i = 0; i < capacity; ++i) {
+        _entries[i].next = (i + 1 < capacity)? i + 1 : -1;
+    }
+
+    _free = (capacity)? 0 : -1;
 }
 
 PackageManager::~PackageManager() {
-    for (const auto& data : std::as_const(_parseResults)) {
-        delete data;
-    }
 
-    _parseResults.clear();
 }
 
-const Package *PackageManager::getPkgFromArhive(const unsigned int &id) const {
-    if (!contains(id))
-        return nullptr;
+bool PackageManager::begin(const HostAddressKey &sender, unsigned int hash, QByteArray *response) {
+    if (!hash || _entries.isEmpty()) {
+        return true;
+    }
+
+    const quint64 senderHash = sender.hash();
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
 
     QMutexLocker lock(&_processMutex);
-    return _parseResults.value(id)->_data;
+
+    int entry = find(senderHash, hash);
+    if (entry >= 0) {
+        if (_ttl > 0 && now - _entries[entry].time > _ttl) {
+            remove(entry);
+        } else {
+            unlink(entry);
+            pushFront(entry);
+
+            if (response) {
+                *response = _entries[entry].response;
+            }
+
+            return false;
+        }
+    }
+
+    insert(senderHash, hash, now);
+    return true;
 }
 
-bool PackageManager::contains(const unsigned int &id) const {
+void PackageManager::processed(const HostAddressKey &sender, unsigned int hash, char processResult) {
+    if (!hash) {
+        return;
+    }
+
     QMutexLocker lock(&_processMutex);
-    return _parseResults.contains(id);
+
+    int entry = find(sender.hash(), hash);
+    if (entry >= 0) {
+        _entries[entry].processResult = processResult;
+    }
 }
 
-void PackageManager::processed(const Package &pkg, char processResult) {
+void PackageManager::setResponse(const HostAddressKey &sender, unsigned int hash, const QByteArray &response) {
+    if (!hash) {
+        return;
+    }
+
+    QMutexLocker lock(&_processMutex);
 
-    if (!pkg.hdr.hash || !PACKAGE_CACHE_SIZE) {
+    if (!_storeResponses || (_memoryLimit > 0 && response.size() > _memoryLimit)) {
         return;
     }
 
+    int entry = find(sender.hash(), hash);
+    if (entry < 0) {
+        return;
+    }
+
+    auto &data = _entries[entry];
+    _memory += response.size() - data.response.size();
+    data.response = response;
+
+    unlink(entry);
+    pushFront(entry);
+
+    // remove the least recently used packages until memory usage is greater then limit.
+    while (_memoryLimit > 0 && _memory > _memoryLimit && _tail != entry) {
+        remove(_tail);
+    }
+}
+
+bool PackageManager::contains(const HostAddressKey &sender, unsigned int hash) const {
+    QMutexLocker lock(&_processMutex);
+    return find(sender.hash(), hash) >= 0;
+}
+
+char PackageManager::processResult(const HostAddressKey &sender, unsigned int hash) const {
+    QMutexLocker lock(&_processMutex);
+
+    int entry = find(sender.hash(), hash);
+    if (entry < 0) {
+        return -1;
+    }
+
+    return _entries[entry].processResult;
+}
+
+bool PackageManager::storeResponses() const {
+    QMutexLocker lock(&_processMutex);
+    return _storeResponses;
+}
+
+void PackageManager::setStoreResponses(bool store) {
+    QMutexLocker lock(&_processMutex);
+    _storeResponses = store;
+}
+
+int PackageManager::size() const {
+    QMutexLocker lock(&_processMutex);
+    return _size;
+}
+
+int PackageManager::capacity() const {
+    return _entries.size();
+}
+
+qint64 PackageManager::memoryUsage() const {
     QMutexLocker lock(&_processMutex);
+    return _memory;
+}
 
-    if (_parseResults.size() > PACKAGE_CACHE_SIZE) {
-#if QT_VERSION <= QT_VERSION_CHECK(6, 0, 0)
-        _processTime.erase(_processTime.begin());
-#else
-        _processTime.erase(_processTime.cbegin());
-#endif
+void PackageManager::clear() {
+    QMutexLocker lock(&_processMutex);
+
+    while (_tail >= 0) {
+        remove(_tail);
     }
+}
+
+int PackageManager::slotIndex(quint64 sender, unsigned int hash) const {
+    quint64 key = sender ^ (static_cast<quint64>(hash) * 0x9e3779b97f4a7c15ULL);
+    key ^= key >> 29;
+    return static_cast<int>(key & static_cast<quint64>(_mask));
+}
+
+int PackageManager::findSlot(quint64 sender, unsigned int hash) const {
+    int index = slotIndex(sender, hash);
+
+    while (_slots[index].entry >= 0) {
+        const auto &slot = _slots[index];
+        if (slot.hash == hash && slot.sender == sender) {
+            return index;
+        }
+
+        index = (index + 1) & _mask;
+    }
+
+    return -1;
+}
+
+int PackageManager::find(quint64 sender, unsigned int hash) const {
+    int slot = findSlot(sender, hash);
+    if (slot < 0) {
+        return -1;
+    }
+
+    return _slots[slot].entry;
+}
+
+int PackageManager::insert(quint64 sender, unsigned int hash, qint64 now) {
+    if (_free < 0) {
+        remove(_tail);
+    }
+
+    const int entry = _free;
+    auto &data = _entries[entry];
+    _free = data.next;
+
+    data.sender = sender;
+    data.hash = hash;
+    data.processResult = -1;
+    data.time = now;
+
+    int index = slotIndex(sender, hash);
+    while (_slots[index].entry >= 0) {
+        index = (index + 1) & _mask;
+    }
+
+    _slots[index] = Slot{sender, hash, entry};
 
-    _parseResults.insert(pkg.hdr.hash, new PackaData {
-                             processResult,
-                             new Package(pkg)
-                         });
+    pushFront(entry);
+    _size++;
 
-    _processTime.insert(static_cast<int>(time(nullptr)), pkg.hdr.hash);
+    return entry;
+}
+
+void PackageManager::remove(int entry) {
+    auto &data = _entries[entry];
+
+    // backward shift deletion, so the table do not needs tombstones.
+    int empty = findSlot(data.sender, data.hash);
+    int index = empty;
+    while (true) {
+        index = (index + 1) & _mask;
+        if (_slots[index].entry < 0) {
+            break;
+        }
+
+        const int ideal = slotIndex(_slots[index].sender, _slots[index].hash);
+        const bool stay = (empty <= index)? (empty < ideal && ideal <= index):
+                                            (empty < ideal || ideal <= index);
+        if (!stay) {
+            _slots[empty] = _slots[index];
+            empty = index;
+        }
+    }
+
+    _slots[empty] = Slot{};
+
+    unlink(entry);
+
+    _memory -= data.response.size();
+    data.response = QByteArray{};
+    data.hash = 0;
+    data.sender = 0;
+    data.next = _free;
+    _free = entry;
+
+    _size--;
+}
+
+void PackageManager::unlink(int entry) {
+    auto &data = _entries[entry];
+
+    if (data.prev >= 0) {
+        _entries[data.prev].next = data.next;
+    } else {
+        _head = data.next;
+    }
+
+    if (data.next >= 0) {
+        _entries[data.next].prev = data.prev;
+    } else {
+        _tail = data.prev;
+    }
+
+    data.prev = -1;
+    data.next = -1;
+}
+
+void PackageManager::pushFront(int entry) {
+    auto &data = _entries[entry];
+
+    data.prev = -1;
+    data.next = _head;
+
+    if (_head >= 0) {
+        _entries[_head].prev = entry;
+    }
+
+    _head = entry;
+
+    if (_tail < 0) {
+        _tail = entry;
+    }
 }
 
 }
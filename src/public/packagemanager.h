@@ -10,50 +10,165 @@
 #define PAKCAGEMANAGER_H
 
 #include "package.h"
+#include "hostaddresskey.h"
+#include "config.h"
 
+#include <QByteArray>
 #include <QMutex>
-#include <QSharedDataPointer>
+#include <QVector>
 
 
 namespace QH {
 
-class PackaData;
-
 /**
- * @brief The PakcageManager class contains all processed packages. Working like a cache of packages.
+ * @brief The PakcageManager class contains all processed packages. Working like a dedup and replay cache of packages.
+ * The cache has fixed capacity and memory limit. The table of the packages allocated in the constructor,
+ * so the cache do not allocates memory for the new packages while working. Saved responses are separate copies of the sent packages
+ * (the node serializes the response again for the cache), so they are limited by the memory limit.
+ *
+ * Packages are identified by the Header::hash field and address of the sender. The cache uses open addressing table for searching
+ * of the packages and the LRU list for eviction, so all operations work with O(1) time.
+ *
+ * @warning The Header::hash is hash of the content of the package, not an id of the request. Same requests of one sender are
+ *  dropped as retransmits while they are in the cache, so use the cache only for idempotent requests that are unique by content.
+ *
+ * Work flow:
+ *  * PackageManager::begin - invoked when node receive package, if the package already processed (retransmit) then returns false and the response of the package.
+ *  * PackageManager::setResponse - saves the response of the package.
+ *  * PackageManager::processed - saves the parse result of the package.
+ *
+ * @note This class is thread safe.
  */
 class HEARTSHARED_EXPORT PackageManager
 {
 public:
-    PackageManager();
-    ~PackageManager();
-
     /**
-     * @brief getPkgFromArhive This method return pointer to package from archive.
-     * @param id This is id of the requirement package.
-     * @result pointer of the processed package, if package not find then return nullptr.
+     * @brief PackageManager This is main constructor of the cache.
+     * @param capacity This is maximum count of the packages in the cache.
+     * @param memoryLimit This is maximum size of the saved responses in bytes. 0 disable the limit.
+     * @param ttl This is life time of the packages in msec. After this time the same package will be processed again. 0 disable the limit.
      */
-    const Package * getPkgFromArhive(const unsigned int &id) const;
+    PackageManager(int capacity = PACKAGE_CACHE_SIZE,
+                   qint64 memoryLimit = PACKAGE_CACHE_MEMORY_LIMIT,
+                   int ttl = PACKAGE_CACHE_TTL);
+    ~PackageManager();
 
     /**
-     * @brief contains This method checks if the package contains in this container by id.
-     * @param id This is unique key of package.
-     * In Default implementation it is qHash of package.
-     * @return True if the pakcage has been parsed.
+     * @brief begin This method registers the package with @a hash from the @a sender before processing.
+     * @param sender This is address of the sender.
+     * @param hash This is hash of the package (Header::hash).
+     * @param response This is pointer to result response of the already processed package. Can be nullptr.
+     * @return true if the package is new and should be processed. Returns false if the package is retransmit of the already received package.
      */
-    bool contains(const unsigned int& id) const;
+    bool begin(const HostAddressKey& sender, unsigned int hash, QByteArray* response = nullptr);
 
     /**
-     * @brief processed This method add a package to the archive.
-     * @param pkg This is object of the package.
+     * @brief processed This method saves result of the parsing of the package.
+     * @param sender This is address of the sender.
+     * @param hash This is hash of the package (Header::hash).
      * @param processResult This is result of method parsePackage.
      * For more information see ParserResult enum.
      */
-    void processed(const Package& pkg, char processResult);
+    void processed(const HostAddressKey& sender, unsigned int hash, char processResult);
+
+    /**
+     * @brief setResponse This method saves the @a response of the package with @a hash. The response will be sent again for all retransmits of the package.
+     * @param sender This is address of the sender of the request.
+     * @param hash This is hash of the request (Header::triggerHash of the response).
+     * @param response This is raw bytes of the response package.
+     * @note If responses storing is disabled (see PackageManager::setStoreResponses) then this method do nothing.
+     */
+    void setResponse(const HostAddressKey& sender, unsigned int hash, const QByteArray& response);
+
+    /**
+     * @brief contains This method checks if the package contains in this container.
+     * @param sender This is address of the sender.
+     * @param hash This is hash of the package (Header::hash).
+     * @return True if the pakcage has been received.
+     */
+    bool contains(const HostAddressKey& sender, unsigned int hash) const;
+
+    /**
+     * @brief processResult This method return result of the parsing of the package.
+     * @param sender This is address of the sender.
+     * @param hash This is hash of the package (Header::hash).
+     * @return result of the parsing or -1 if the package is not processed yet.
+     */
+    char processResult(const HostAddressKey& sender, unsigned int hash) const;
+
+    /**
+     * @brief storeResponses This method return true if the cache saves responses of the packages.
+     * @return true if the cache saves responses of the packages.
+     */
+    bool storeResponses() const;
+
+    /**
+     * @brief setStoreResponses This method enable or disable saving responses. If saving disabled, then the cache only suppress duplicates. By default it is enabled.
+     * @param store new value.
+     */
+    void setStoreResponses(bool store);
+
+    /**
+     * @brief size This method return count of the packages in the cache.
+     * @return count of the packages in the cache.
+     */
+    int size() const;
+
+    /**
+     * @brief capacity This method return maximum count of the packages in the cache.
+     * @return maximum count of the packages.
+     */
+    int capacity() const;
+
+    /**
+     * @brief memoryUsage This method return size of all saved responses in bytes.
+     * @return size of all saved responses.
+     */
+    qint64 memoryUsage() const;
+
+    /**
+     * @brief clear This method remove all packages from the cache.
+     */
+    void clear();
+
 private:
+    struct Slot {
+        quint64 sender = 0;
+        unsigned int hash = 0;
+        int entry = -1;
+    };
+
+    struct Entry {
+        quint64 sender = 0;
+        unsigned int hash = 0;
+        char processResult = -1;
+        qint64 time = 0;
+        QByteArray response;
+        int prev = -1;
+        int next = -1;
+    };
+
+    int slotIndex(quint64 sender, unsigned int hash) const;
+    int findSlot(quint64 sender, unsigned int hash) const;
+    int find(quint64 sender, unsigned int hash) const;
+    int insert(quint64 sender, unsigned int hash, qint64 now);
+    void remove(int entry);
+
+    void unlink(int entry);
+    void pushFront(int entry);
+
+    QVector<Slot> _slots;
+    QVector<Entry> _entries;
+    int _mask = 0;
+    int _head = -1;
+    int _tail = -1;
+    int _free = -1;
+    int _size = 0;
+    qint64 _memory = 0;
 
-    QMultiMap<int, unsigned int> _processTime;
-    QHash<unsigned int, const PackaData*> _parseResults;
+    qint64 _memoryLimit = 0;
+    int _ttl = 0;
+    bool _storeResponses = true;
 
     mutable QMutex _processMutex;
 };
@@ -13,6 +13,7 @@
 #include <QSharedPointer>
 #include <streambase.h>
 #include <crc/crchash.h>
+#include "commandhash.h"
 
 /**
  * @brief PROTOCKOL_VERSION_COMMAND is command for exchange versions number betwin nodes.
@@ -27,15 +28,32 @@
 /**
  * @brief QH_PACKAGE This macross prepare data to send and create a global id for package.
  * For get global id use the cmd method.
- * For get quick access for global command use the ClassName::command() method. This method is static.
- * @arg S This is unique id of the pacakge. Shold be some on all your network devices.
-
+ * For get quick access for global command use the ClassName::command() method. This method is static and constexpr, so the command can be used in the switch and static_assert.
+ * @arg S This is unique id of the pacakge. Shold be some on all your network devices. Must be a string literal, for not literal ids use the QH_PACKAGE_DYNAMIC macross.
+ * @see uniqueCommands
 */
 #define QH_PACKAGE(S) \
+   public: \
+    static constexpr unsigned short command(){return QH::PKG::commandHash(S);} \
+    static QString commandText(){return S;} \
+    unsigned short cmd() const override {return command();} \
+\
+    QString cmdString() const override {return S;} \
+   private:
+
+/**
+ * @brief QH_PACKAGE_DYNAMIC This is same as a QH_PACKAGE macross but works with any string expression (for example QString).
+ * The command calculated only once on first call of the ClassName::command() method.
+ * @arg S This is unique id of the pacakge.
+*/
+#define QH_PACKAGE_DYNAMIC(S) \
    public: \
     static unsigned short command(){\
-        QByteArray ba = QString(S).toLocal8Bit();\
-        return qa_common::hash16(ba.data(), ba.size());\
+        static const unsigned short cmd = [](){\
+            QByteArray ba = QString(S).toLocal8Bit();\
+            return qa_common::hash16(ba.data(), ba.size());\
+        }();\
+        return cmd;\
     } \
     static QString commandText(){return S;} \
     unsigned short cmd() const override {return command();} \
@@ -146,7 +164,7 @@ public:
      * @return global code
      * @see QH_PACKAGE
      */
-    static unsigned int command(){return 0;};
+    static constexpr unsigned int command(){return 0;};
 
     /**
      * @brief commandText This method return text of package command
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef COMMANDHASH_H
+#define COMMANDHASH_H
+
+#include <cstddef>
+
+namespace QH {
+namespace PKG {
+
+/**
+ * @brief commandHash This is compile time version of the qa_common::hash16 function (CRC-16 CCITT, poly 0x1021, init 0xFFFF).
+ *  Returns the same values as the qa_common::hash16, so commands of the packages are not changed on the wire.
+ * @param data This is pointer to bytes of the command.
+ * @param size This is size of the @a data.
+ * @param crc This is initial value of the hash. Use hash of the prefix for hashing of the string that starts with prefix.
+ * @return 16 bit hash of the @a data.
+ */
+constexpr unsigned short commandHash(const char* data, std::size_t size, unsigned short crc = 0xFFFF) {
+    for (std::size_t i = 0; i < size; ++i) {
+        crc ^= static_cast<unsigned short>(static_cast<unsigned char>(data[i]) << 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000)? static_cast<unsigned short>((crc << 1) ^ 0x1021):
+                                  static_cast<unsigned short>(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief commandHash This is overload for the string literals.
+ * @param str This is string literal.
+ * @return 16 bit hash of the @a str without the null terminator.
+ */
+template<std::size_t N>
+constexpr unsigned short commandHash(const char (&str)[N]) {
+    return commandHash(str, N - 1);
+}
+
+/**
+ * @brief uniqueCommands This method return true if all @a Packages have different commands.
+ *  Use it in the static_assert for checking collisions of the commands at compile time.
+ *
+ * @code{cpp}
+ *  static_assert(QH::PKG::uniqueCommands<MyPackage, MyOtherPackage>(), "Commands of the packages are collided.");
+ * @endcode
+ */
+template<class... Packages>
+constexpr bool uniqueCommands() {
+    constexpr unsigned short commands[] = {static_cast<unsigned short>(Packages::command())..., 0};
+    constexpr std::size_t count = sizeof...(Packages);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t j = i + 1; j < count; ++j) {
+            if (commands[i] == commands[j]) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+}
+}
+#endif // COMMANDHASH_H
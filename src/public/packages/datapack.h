@@ -9,6 +9,11 @@
 #define DATAPACK_H
 
 #include <abstractdata.h>
+#include "packedrows.h"
+#include "universaldata.h"
+
+#include <QMutex>
+#include <type_traits>
 
 namespace QH {
 namespace PKG {
@@ -19,14 +24,21 @@ namespace PKG {
  * @note All packs data objects should be inherited of the UniversalData class.
  *  This is due to classes base on abstract data may broken transporting data between nodes if you change toStream and fromStream methods.
  *  To fix this issue, we use QVariantMap container for parsing data.
+ *
+ * The pack supports the packed mode (see DataPack::setPacked) for items based on UniversalData class.
+ * In this mode the items written column-wise and received pack do not create objects for each item, use the DataPack::rows method for access to items.
  * @see UniversalData
+ * @see PackedRows
  */
 template<class Package>
 class DataPack final: public AbstractData
 {
-    QH_PACKAGE(Package::commandText() + "Pack")
-
 public:
+    // The crc hash of the item command continues with the "Pack" suffix, so result is same as hash of the "<Package command>Pack" string.
+    static constexpr unsigned short command(){return commandHash("Pack", 4, Package::command());}
+    static QString commandText(){return Package::commandText() + "Pack";}
+    unsigned short cmd() const override {return command();}
+    QString cmdString() const override {return commandText();}
 
         DataPack(const QList<QSharedPointer<Package>> &newPackData = {}) {
         setPackData(newPackData);
@@ -36,19 +48,54 @@ public:
 #endif
     }
 
+    DataPack(const DataPack& other): AbstractData(other) {
+        QMutexLocker lock(&other._materializeMutex);
+        _packData = other._packData;
+        _rows = other._rows;
+        _data = other._data;
+        _packed = other._packed;
+        _deltaIntegers = other._deltaIntegers;
+    }
+
+    DataPack& operator=(const DataPack& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        AbstractData::operator=(other);
+
+        QMutexLocker lock(&other._materializeMutex);
+        _packData = other._packData;
+        _rows = other._rows;
+        _data = other._data;
+        _packed = other._packed;
+        _deltaIntegers = other._deltaIntegers;
+
+        return *this;
+    }
+
     /**
      * @brief size This method return of the items count of this pack.
      * @return size of the packs.
      */
     unsigned int size() const {
+        QMutexLocker lock(&_materializeMutex);
+        if (_packData.isEmpty()) {
+            return _rows.size();
+        }
+
         return _packData.size();
     }
 
     /**
      * @brief packData This method return source list of the elements.
+     * @note If this pack received in the packed mode then this method creates objects for all items on the first call.
+     *  Use the DataPack::rows method for reading items without creating objects.
+     *  The first call is thread safe, so const packs can be shared between threads.
      * @return source list
      */
     const QList<QSharedPointer<Package>> &packData() const {
+        materialize();
         return _packData;
     }
 
@@ -57,6 +104,8 @@ public:
      * @param newPackData This is new source lsit.
      */
     void setPackData(const QList<QSharedPointer<Package>> &newPackData) {
+        QMutexLocker lock(&_materializeMutex);
+        _rows.clear();
         _packData = newPackData;
     }
 
@@ -65,6 +114,7 @@ public:
      * @param data This is new data pacakge that will be added into back of this list.
      */
     void push(const QSharedPointer<Package>& data) {
+        materialize();
         _packData.push_back(data);
     };
 
@@ -73,20 +123,53 @@ public:
      * @param data This is new data pacakge that will be added into back of this list.
      */
     void push(const Package& data) {
+        materialize();
         _packData.push_back(QSharedPointer<Package>::create(data));
     };
 
+    /**
+     * @brief isPacked This method return true if this pack uses the packed (column-wise) mode.
+     * @return true if this pack uses the packed mode.
+     * @see DataPack::setPacked
+     */
+    bool isPacked() const {
+        return _packed;
+    }
+
+    /**
+     * @brief setPacked This method enables or disables the packed mode. In this mode items written column-wise, so the type of each field saved only once.
+     *  Works only for items based on the UniversalData class with same fields, for other items this option is ignored.
+     * @param packed This is new value of the mode.
+     * @param deltaIntegers This option enables delta encoding of the integer fields. Use it if fields contains sorted ids or timestamps.
+     * @note Old versions of the library can not read packs in packed mode.
+     */
+    void setPacked(bool packed, bool deltaIntegers = false) {
+        _packed = packed;
+        _deltaIntegers = deltaIntegers;
+    }
+
+    /**
+     * @brief rows This method return items of the pack received in the packed mode.
+     *  Items are not copied into objects, use the PackedRows::at method for access to the fields.
+     * @return items of the pack. If pack is not received in the packed mode return empty container.
+     */
+    const PackedRows& rows() const {
+        return _rows;
+    }
+
     /**
      * @brief isValid This implementation check all items of the pack to valid and packa size. The pack size should be more then 0.
+     * @note Items of the pack received in the packed mode are created by this method, because each item should be validated.
      * @return true if the pack of items is valid else flase..
      */
     bool isValid() const override {
 
-        if (!_packData.size()) {
+        const auto &items = packData();
+        if (!items.size()) {
             return false;
         }
 
-        for (const auto& it: _packData) {
+        for (const auto& it: items) {
             if (!it->isValid()) {
                 return false;
             }
@@ -116,9 +199,32 @@ public:
 protected:
     QDataStream &fromStream(QDataStream &stream) override {
 
+        QMutexLocker lock(&_materializeMutex);
+        _packData.clear();
+        _rows.clear();
+        _packed = false;
+        _deltaIntegers = false;
+
         int size = 0;
         stream >> size;
 
+        // negative size is marker of the packed mode.
+        if (size < 0) {
+            if constexpr (std::is_base_of_v<UniversalData, Package>) {
+                quint8 flags = 0;
+                stream >> flags;
+                _packed = true;
+                _deltaIntegers = flags & 0x1;
+                if (!_rows.read(stream)) {
+                    stream.setStatus(QDataStream::ReadCorruptData);
+                    return stream;
+                }
+            } else {
+                stream.setStatus(QDataStream::ReadCorruptData);
+                return stream;
+            }
+        }
+
         for (int i = 0; i < size; ++i) {
             auto data = QSharedPointer<Package>::create();
             stream >> *data;
@@ -132,6 +238,33 @@ protected:
     };
 
     QDataStream &toStream(QDataStream &stream) const override {
+        if constexpr (std::is_base_of_v<UniversalData, Package>) {
+            materialize();
+
+            QList<const UniversalData*> rows;
+            if (_packed) {
+                rows.reserve(_packData.size());
+                for (const auto &data: std::as_const(_packData)) {
+                    // rows without values are not supported by the packed format, so send them in the old format.
+                    if (data->keys().isEmpty()) {
+                        rows.clear();
+                        break;
+                    }
+
+                    rows.push_back(data.data());
+                }
+            }
+
+            if (rows.size()) {
+                stream << static_cast<int>(-1);
+                stream << static_cast<quint8>(_deltaIntegers);
+                PackedRows::write(stream, rows, _deltaIntegers);
+                stream << _data;
+
+                return stream;
+            }
+        }
+
         stream << static_cast<int>(_packData.size());
 
         for (const auto &data: std::as_const(_packData)) {
@@ -144,8 +277,28 @@ protected:
     }
 
 private:
-    QList<QSharedPointer<Package>> _packData;
+    void materialize() const {
+        if constexpr (std::is_base_of_v<UniversalData, Package>) {
+            QMutexLocker lock(&_materializeMutex);
+            if (!_packData.isEmpty() || !_rows.size()) {
+                return;
+            }
+
+            _packData.reserve(_rows.size());
+            for (int i = 0; i < _rows.size(); ++i) {
+                auto data = QSharedPointer<Package>::create();
+                _rows.at(i).fill(*data);
+                _packData.push_back(data);
+            }
+        }
+    }
+
+    mutable QList<QSharedPointer<Package>> _packData;
+    PackedRows _rows;
     QByteArray _data;
+    bool _packed = false;
+    bool _deltaIntegers = false;
+    mutable QMutex _materializeMutex;
 
 };
 
@@ -9,12 +9,14 @@
 #include <QDataStream>
 #include <QDateTime>
 #include <QSqlQuery>
+#include <QSqlDriver>
 #include <QHash>
 #include <QSqlRecord>
 #include <QVariantMap>
 #include <QSharedPointer>
 #include <quasarapp.h>
 #include <qaglobalutils.h>
+#include <QMutex>
 
 namespace QH {
 namespace PKG {
@@ -23,10 +25,30 @@ DBObject::DBObject() {
     DBObject::clear();
 }
 
+DBObject::DBObject(const DBObject &other):
+    AbstractData(other),
+    _dirtyFields(other.dirtyFields()) {
+
+}
+
 DBObject::~DBObject() {
 
 }
 
+DBObject &DBObject::operator=(const DBObject &other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    AbstractData::operator=(other);
+
+    const QSet<QString> dirty = other.dirtyFields();
+    QMutexLocker locker(&_dirtyFieldsMutex);
+    _dirtyFields = dirty;
+
+    return *this;
+}
+
 PrepareResult DBObject::prepareSelectQuery(QSqlQuery &q) const {
 
     auto map = variantMap().keys();
@@ -119,6 +141,92 @@ PrepareResult DBObject::prepareInsertQuery(QSqlQuery &q, bool replace) const {
     return PrepareResult::Fail;
 }
 
+PrepareResult DBObject::prepareUpsertQuery(QSqlQuery &q) const {
+
+    DBVariantMap map = variantMap();
+
+    if (!map.size()) {
+        qCritical() << "The variantMap method return an empty map.";
+
+        return PrepareResult::Fail;
+    }
+
+    const QString key = primaryKey();
+
+    QStringList insertFields;
+    QStringList updateFields;
+    for (auto it = map.cbegin(); it != map.cend(); ++it) {
+        if (!bool(it.value().type & MemberType::Insert)) {
+            continue;
+        }
+
+        // new object without id, the database generates it.
+        if (bool(it.value().type & MemberType::Autoincement) && it.value().value.isNull()) {
+            continue;
+        }
+
+        insertFields.push_back(it.key());
+
+        if (it.key() != key && bool(it.value().type & MemberType::Update) &&
+            (_dirtyFields.isEmpty() || _dirtyFields.contains(it.key()))) {
+            updateFields.push_back(it.key());
+        }
+    }
+
+    const QString conflict = (key.isEmpty())? "" : upsertClause(q, key, updateFields);
+    if (conflict.isEmpty()) {
+        return prepareInsertQuery(q, true);
+    }
+
+    QString queryString = QString("INSERT INTO %0(%1) VALUES (:%2) %3").
+                          arg(table(), insertFields.join(", "), insertFields.join(", :"), conflict);
+
+    if (!q.prepare(queryString)) {
+        return PrepareResult::Fail;
+    }
+
+    for (const auto& field: std::as_const(insertFields)) {
+        q.bindValue(":" + field, map.value(field).value);
+    }
+
+    return PrepareResult::Success;
+}
+
+QString DBObject::upsertClause(const QSqlQuery &q, const QString &key, const QStringList &updateFields) {
+    const QSqlDriver* driver = q.driver();
+    if (!driver) {
+        return "";
+    }
+
+    QStringList updates;
+    switch (driver->dbmsType()) {
+    case QSqlDriver::SQLite:
+    case QSqlDriver::PostgreSQL: {
+        if (updateFields.isEmpty()) {
+            return QString("ON CONFLICT(%0) DO NOTHING").arg(key);
+        }
+
+        for (const auto& field: updateFields) {
+            updates.push_back(QString("%0=excluded.%0").arg(field));
+        }
+
+        return QString("ON CONFLICT(%0) DO UPDATE SET %1").arg(key, updates.join(", "));
+    }
+
+    case QSqlDriver::MySqlServer: {
+        // mysql do not have the DO NOTHING option, so the key is updated by self.
+        for (const auto& field: (updateFields.isEmpty())? QStringList{key} : updateFields) {
+            updates.push_back(QString("%0=VALUES(%0)").arg(field));
+        }
+
+        return QString("ON DUPLICATE KEY UPDATE %0").arg(updates.join(", "));
+    }
+
+    default:
+        return "";
+    }
+}
+
 PrepareResult DBObject::prepareUpdateQuery(QSqlQuery &q) const {
 
     DBVariantMap map = variantMap();
@@ -141,8 +249,14 @@ PrepareResult DBObject::prepareUpdateQuery(QSqlQuery &q) const {
     queryString = queryString.arg(table());
     QString tableUpdateValues = "";
 
-    for (auto it = map.begin(); it != map.end(); ++it) {
-        if (!bool(it.value().type & MemberType::Update)) {
+    // write only changed fields if the object tracks changes.
+    auto isUpdated = [this](const DBVariantMap::const_iterator& it) {
+        return bool(it.value().type & MemberType::Update) &&
+               (_dirtyFields.isEmpty() || _dirtyFields.contains(it.key()));
+    };
+
+    for (auto it = map.cbegin(); it != map.cend(); ++it) {
+        if (!isUpdated(it)) {
             continue;
         }
 
@@ -162,10 +276,10 @@ PrepareResult DBObject::prepareUpdateQuery(QSqlQuery &q) const {
 
     queryString = queryString.arg(tableUpdateValues);
 
-    if (q.prepare(queryString)) {
+    if (q.lastQuery() == queryString || q.prepare(queryString)) {
 
-        for (auto it = map.begin(); it != map.end(); ++it) {
-            if (!bool(it.value().type & MemberType::Update)) {
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            if (!isUpdated(it)) {
                 continue;
             }
 
@@ -308,6 +422,65 @@ bool DBObject::isHaveAPrimaryKey() const {
 
 void DBObject::clear() {}
 
+QSet<QString> DBObject::dirtyFields() const {
+    QMutexLocker locker(&_dirtyFieldsMutex);
+    return _dirtyFields;
+}
+
+void DBObject::clearDirtyFields() {
+    QMutexLocker locker(&_dirtyFieldsMutex);
+    _dirtyFields.clear();
+}
+
+PrepareResult DBObject::prepareAndTakeDirtyFields(const std::function<PrepareResult ()> &prepare,
+                                                  QSet<QString> *taken) {
+    QMutexLocker locker(&_dirtyFieldsMutex);
+
+    const PrepareResult result = prepare();
+    if (result == PrepareResult::Success && taken) {
+        *taken = _dirtyFields;
+        _dirtyFields.clear();
+    }
+
+    return result;
+}
+
+void DBObject::restoreDirtyFields(const QSet<QString> &taken) {
+    QMutexLocker locker(&_dirtyFieldsMutex);
+
+    // The empty list means that all fields was written.
+    if (taken.isEmpty()) {
+        _dirtyFields.clear();
+        return;
+    }
+
+    _dirtyFields.unite(taken);
+}
+
+void DBObject::mergeDirtyFields(const DBObject &other) {
+    if (this == &other) {
+        return;
+    }
+
+    // copy the list before locking of this object, so two objects never locked together.
+    const QSet<QString> otherFields = other.dirtyFields();
+
+    QMutexLocker locker(&_dirtyFieldsMutex);
+
+    // The empty list means that all fields are changed.
+    if (_dirtyFields.isEmpty() || otherFields.isEmpty()) {
+        _dirtyFields.clear();
+        return;
+    }
+
+    _dirtyFields.unite(otherFields);
+}
+
+void DBObject::markDirty(const QString &field) {
+    QMutexLocker locker(&_dirtyFieldsMutex);
+    _dirtyFields.insert(field);
+}
+
 DBVariant::DBVariant() {
 
 }
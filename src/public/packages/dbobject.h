@@ -7,8 +7,11 @@
 
 #ifndef DBOBJECT_H
 #define DBOBJECT_H
+#include <QMutex>
+#include <QSet>
 #include <QSqlRecord>
 #include <QVariantMap>
+#include <functional>
 #include "abstractdata.h"
 #include "heart_global.h"
 #include "dbaddress.h"
@@ -97,9 +100,12 @@ class HEARTSHARED_EXPORT DBObject : public AbstractData
 public:
 
     DBObject();
+    DBObject(const DBObject& other);
 
     ~DBObject() override;
 
+    DBObject& operator=(const DBObject& other);
+
     bool isValid() const override;
 
     /**
@@ -227,6 +233,22 @@ public:
      */
     virtual PrepareResult prepareInsertQuery(QSqlQuery& q, bool replace) const;
 
+    /**
+     * @brief prepareUpsertQuery This method should be prepare a query for insert object or update the existing object with same primary key.
+     * Unlike the replace mode of the prepareInsertQuery method, the existing row is not removed, so rowid, foreign keys and autoincrement sequence are not changed.
+     *
+     * Default upsert query have a next template (sqlite >= 3.24 and postgres):
+     * \code{sql}
+     *     INSERT INTO %0(%1) VALUES (%2) ON CONFLICT(primaryKey) DO UPDATE SET field=excluded.field
+     * \endcode
+     * For MySql the ON DUPLICATE KEY UPDATE clause is used. For other drivers and objects without primary key the REPLACE query is used.
+     * On sqlite older then 3.24 the SqlDBWriter uses the prepareInsertQuery method with replace mode instead of this method.
+     * Only fields with the MemberType::Update type (and changed fields if object tracks changes) are updated.
+     * @param q This is query object.
+     * @return PrepareResult object with information about prepare results.
+     */
+    virtual PrepareResult prepareUpsertQuery(QSqlQuery& q) const;
+
     /**
      * @brief prepareUpdateQuery this method should be prepare a insert data query.
      *
@@ -282,6 +304,8 @@ public:
             return PrepareResult::Fail;
         }
      * \endcode
+     * @note The default implementation writes only changed fields if the object tracks changes (see DBObject::dirtyFields).
+     *  If the @a q already prepared with the same statement (the writer reuses queries) then statement will not be prepared again.
      * @param q This is query object.
      * @return PrepareResult object with information about prepare results.
      */
@@ -328,6 +352,45 @@ public:
 
     QString toString() const override;
 
+    /**
+     * @brief dirtyFields This method return list of the changed fields of this object (see the DBObject::setField method).
+     *  The default implementation of the DBObject::prepareUpdateQuery method updates only these fields.
+     *  If list is empty then all update fields will be written.
+     * @return copy of the list of the changed fields.
+     * @note Changed fields are protected by the lock of this object, so the list can be changed on the other thread while database writer saves the object.
+     */
+    QSet<QString> dirtyFields() const;
+
+    /**
+     * @brief clearDirtyFields This method clears list of the changed fields.
+     *  Invoked by the database writer after reading of this object.
+     */
+    void clearDirtyFields();
+
+    /**
+     * @brief prepareAndTakeDirtyFields This method invokes the @a prepare function and removes all changed fields that used by it.
+     *  The list of changed fields of this object is locked while the @a prepare function works, so fields changed after preparing of the query stay dirty and will be written by the next save.
+     *  Other objects are not locked, so the writer and setters of other objects do not wait for each other.
+     *  The database writer uses this method for all queries that save the object.
+     * @param prepare This is function that prepares the save query.
+     * @param taken This is list of the removed fields. Return it by the restoreDirtyFields method if the query failed.
+     * @return result of the @a prepare function.
+     */
+    PrepareResult prepareAndTakeDirtyFields(const std::function<PrepareResult()>& prepare, QSet<QString>* taken);
+
+    /**
+     * @brief restoreDirtyFields This method returns the @a taken fields into the list of the changed fields after failed saving.
+     * @param taken This is fields returned by the prepareAndTakeDirtyFields method.
+     */
+    void restoreDirtyFields(const QSet<QString>& taken);
+
+    /**
+     * @brief mergeDirtyFields This method adds changed fields of the @a other object (old change of the same database row) to this object.
+     *  If one of objects do not track changes (has empty list of dirty fields) then all fields will be written.
+     * @param other This is object with old changes.
+     */
+    void mergeDirtyFields(const DBObject& other);
+
     /**
      * @brief variantMap This method should be create a DBVariantMap implementation of this database object.
      *
@@ -413,6 +476,57 @@ protected:
      */
     bool isInsertPrimaryKey() const;
 
+    /**
+     * @brief upsertClause This method return conflict clause of the upsert query for driver of the @a q query.
+     * @param q This is query object.
+     * @param key This is conflict column (primary key).
+     * @param updateFields This is list of fields that will be updated if row already exists.
+     * @return conflict clause or empty string if driver do not supports upserts.
+     */
+    static QString upsertClause(const QSqlQuery& q, const QString& key, const QStringList& updateFields);
+
+    /**
+     * @brief markDirty This method marks the @a field as changed. Invoke this method in setters of your object.
+     * @param field This is name of field (key of the variantMap).
+     * @see DBObject::setField
+     */
+    void markDirty(const QString& field);
+
+    /**
+     * @brief setField This is helper for setters with dirty tracking. Changes the @a member and marks the @a field as changed if value is different.
+     *
+     * Example:
+     * \code{cpp}
+     *  void setScore(int score) {
+     *      setField(_score, score, "score");
+     *  }
+     * \endcode
+     *
+     * @param member This is member of the object.
+     * @param value This is new value.
+     * @param field This is name of field (key of the variantMap).
+     * @return true if value is changed.
+     */
+    template<class T>
+    bool setField(T& member, const T& value, const QString& field) {
+        if (member == value) {
+            return false;
+        }
+
+        member = value;
+        markDirty(field);
+        return true;
+    }
+
+private:
+    QSet<QString> _dirtyFields;
+
+    // The lock is recursive because the prepare functions invoked under the lock can read the list of changed fields.
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    mutable QRecursiveMutex _dirtyFieldsMutex;
+#else
+    mutable QMutex _dirtyFieldsMutex{QMutex::Recursive};
+#endif
 };
 }
 }
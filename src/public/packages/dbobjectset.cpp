@@ -16,6 +16,10 @@ PrepareResult DBObjectSet::prepareInsertQuery(QSqlQuery &, bool ) const {
     return PrepareResult::Disabled;
 }
 
+PrepareResult DBObjectSet::prepareUpsertQuery(QSqlQuery &) const {
+    return PrepareResult::Disabled;
+}
+
 PrepareResult DBObjectSet::prepareRemoveQuery(QSqlQuery &q) const {
     return DBObject::prepareRemoveQuery(q);
 }
@@ -44,6 +48,14 @@ QString DBObjectSet::table() const {
     return _table;
 }
 
+const DBPredicate *DBObjectSet::predicate() const {
+    return nullptr;
+}
+
+bool DBObjectSet::appendObject(const QSharedPointer<DBObject> &) {
+    return false;
+}
+
 
 }
 }
@@ -9,6 +9,7 @@
 #define DBOBJECTSET_H
 
 #include "dbobject.h"
+#include "dbpredicate.h"
 
 
 namespace QH {
@@ -28,6 +29,7 @@ public:
     DBObjectSet(const QString table);
 
     PrepareResult prepareInsertQuery(QSqlQuery &q, bool replace) const override final;
+    PrepareResult prepareUpsertQuery(QSqlQuery &q) const override final;
     PrepareResult prepareRemoveQuery(QSqlQuery &q) const override final;
     PrepareResult prepareSelectQuery(QSqlQuery &q) const override final;
     PrepareResult prepareUpdateQuery(QSqlQuery &q) const override final;
@@ -37,6 +39,22 @@ public:
     QString primaryKey() const override;
     QString table() const override;
 
+    /**
+     * @brief predicate This method return typed condition of this request. Database caches use it for select objects from memory.
+     *  Return nullptr if the request contains conditions that can not be checked without database.
+     * @return pointer to predicate of the request or nullptr. Default implementation return nullptr.
+     * @see ISqlDB::setResident
+     */
+    virtual const DBPredicate* predicate() const;
+
+    /**
+     * @brief appendObject This method adds already loaded @a object into result of this request.
+     *  Database caches use it instead of the fromSqlRecord method when objects selected from memory.
+     * @param object This is selected object.
+     * @return true if object added. Default implementation return false.
+     */
+    virtual bool appendObject(const QSharedPointer<DBObject>& object);
+
 private:
     QString _table;
 
@@ -27,7 +27,15 @@ namespace PKG {
  *  auto result = query.data();
  * \endcode
  *
+ * Conditions can be set by the typed predicate too. Requests with the predicate only can be answered by the resident tables of the cache without database.
+ *
+ * \code{cpp}
+ *  using Op = DBPredicate::Operator;
+ *  DBObjectsRequest<User> query("users", DBPredicate("points", Op::Greater, 10));
+ * \endcode
+ *
  * @note Any objects in the query well not be saved in to cache. For caching your objects use the CachedDbObjectsRequest class.
+ * @see ISqlDB::setResident
  */
 template <class T>
 class DBObjectsRequest final: public DBObjectSet
@@ -59,6 +67,19 @@ public:
         _condirionValues = valuesToBind;
     };
 
+    /**
+     * @brief DBObjectsRequest This contsrucor create a object with request the array of T objects that match to the @a predicate.
+     * @param table  This is name of database table.
+     * @param predicate This is typed condition of the request.
+     * @see DBObjectsRequest::setPredicate
+     */
+    DBObjectsRequest(const QString& table,
+                     const DBPredicate& predicate):
+        DBObjectSet (table) {
+
+        _predicate = predicate;
+    };
+
     void clear() override {
         _data.clear();
     };
@@ -108,10 +129,49 @@ public:
         _conditions = newConditions;
     }
 
+    /**
+     * @brief setPredicate This method sets typed condition for request. If the request has the string condition too then both conditions are used.
+     * @param newPredicate This is new predicate.
+     */
+    void setPredicate(const DBPredicate &newPredicate) {
+        _predicate = newPredicate;
+    }
+
+    const DBPredicate* predicate() const override {
+        // the string conditions can be checked only by database.
+        if (_conditions.size()) {
+            return nullptr;
+        }
+
+        return &_predicate;
+    }
+
+    bool appendObject(const QSharedPointer<DBObject>& object) override {
+        auto ptr = object.dynamicCast<T>();
+        if (!ptr) {
+            return false;
+        }
+
+        _data.push_back(ptr);
+
+        return true;
+    }
+
 protected:
 
     std::pair<QString, QMap<QString, QVariant> > condition() const override {
-        return {_conditions, _condirionValues};
+        if (_predicate.isEmpty()) {
+            return {_conditions, _condirionValues};
+        }
+
+        QVariantMap values = _condirionValues;
+        const QString predicate = _predicate.toSql(values);
+
+        if (_conditions.isEmpty()) {
+            return {predicate, values};
+        }
+
+        return {"(" + _conditions + ") AND (" + predicate + ")", values};
     }
 
     DBObject *createDBObject() const override {
@@ -123,6 +183,7 @@ protected:
 private:
     QString _conditions;
     QVariantMap _condirionValues;
+    DBPredicate _predicate;
 
 
 };
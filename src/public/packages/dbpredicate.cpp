@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "dbpredicate.h"
+
+#include <QStringList>
+
+namespace QH {
+namespace PKG {
+
+static bool isInteger(const QVariant& value) {
+    switch (value.userType()) {
+    case QMetaType::Bool:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool isNumber(const QVariant& value) {
+    return isInteger(value) ||
+           value.userType() == QMetaType::Double ||
+           value.userType() == QMetaType::Float;
+}
+
+// strings with numbers are converted to numbers like the sqlite does for numeric columns.
+static bool toNumber(const QVariant& value, double& result) {
+    bool ok = true;
+    result = value.toDouble(&ok);
+    return ok && (isNumber(value) ||
+                  value.userType() == QMetaType::QString ||
+                  value.userType() == QMetaType::QByteArray);
+}
+
+DBPredicate::DBPredicate() {
+
+}
+
+DBPredicate::DBPredicate(const QString &field, Operator op, const QVariant &value) {
+    _field = field;
+    _op = op;
+    _value = value;
+}
+
+DBPredicate::DBPredicate(Operator op, const QList<DBPredicate> &operands) {
+    _op = op;
+    _operands = operands;
+}
+
+DBPredicate DBPredicate::operator&&(const DBPredicate &other) const {
+    return combine(Operator::And, other);
+}
+
+DBPredicate DBPredicate::operator||(const DBPredicate &other) const {
+    return combine(Operator::Or, other);
+}
+
+DBPredicate DBPredicate::combine(Operator op, const DBPredicate &other) const {
+    if (isEmpty()) {
+        return other;
+    }
+
+    if (other.isEmpty()) {
+        return *this;
+    }
+
+    QList<DBPredicate> operands;
+    for (const DBPredicate* part: {this, &other}) {
+        // (a AND b) AND c is a AND b AND c.
+        if (part->_op == op) {
+            operands += part->_operands;
+        } else {
+            operands.push_back(*part);
+        }
+    }
+
+    return DBPredicate(op, operands);
+}
+
+bool DBPredicate::isEmpty() const {
+    return _op == Operator::None;
+}
+
+DBPredicate::Operator DBPredicate::op() const {
+    return _op;
+}
+
+const QString &DBPredicate::field() const {
+    return _field;
+}
+
+const QVariant &DBPredicate::value() const {
+    return _value;
+}
+
+const QList<DBPredicate> &DBPredicate::operands() const {
+    return _operands;
+}
+
+bool DBPredicate::match(const QVariantMap &values) const {
+    switch (_op) {
+    case Operator::None:
+        return true;
+
+    case Operator::And:
+        for (const auto& operand: _operands) {
+            if (!operand.match(values)) {
+                return false;
+            }
+        }
+        return true;
+
+    case Operator::Or:
+        for (const auto& operand: _operands) {
+            if (operand.match(values)) {
+                return true;
+            }
+        }
+        return false;
+
+    default:
+        break;
+    }
+
+    const QVariant value = values.value(_field);
+
+    if (_value.isNull() || value.isNull()) {
+        const bool bothNull = _value.isNull() && value.isNull();
+        switch (_op) {
+        case Operator::Equal: return bothNull;
+        case Operator::NotEqual: return _value.isNull() && !bothNull;
+        default: return false;
+        }
+    }
+
+    const int result = compare(value, _value);
+
+    switch (_op) {
+    case Operator::Equal: return result == 0;
+    case Operator::NotEqual: return result != 0;
+    case Operator::Less: return result < 0;
+    case Operator::LessOrEqual: return result <= 0;
+    case Operator::Greater: return result > 0;
+    case Operator::GreaterOrEqual: return result >= 0;
+    default: return false;
+    }
+}
+
+QString DBPredicate::toSql(QVariantMap &bindValues) const {
+    switch (_op) {
+    case Operator::None:
+        return "";
+
+    case Operator::And:
+    case Operator::Or: {
+        QStringList parts;
+        for (const auto& operand: _operands) {
+            parts.push_back("(" + operand.toSql(bindValues) + ")");
+        }
+
+        return parts.join((_op == Operator::And)? " AND ": " OR ");
+    }
+
+    default:
+        break;
+    }
+
+    if (_value.isNull()) {
+        if (_op == Operator::Equal) {
+            return _field + " IS NULL";
+        }
+
+        if (_op == Operator::NotEqual) {
+            return _field + " IS NOT NULL";
+        }
+    }
+
+    QString key;
+    int index = bindValues.size();
+    do {
+        key = QString(":predicate%0").arg(index++);
+    } while (bindValues.contains(key));
+
+    bindValues.insert(key, _value);
+
+    QString sqlOperator;
+    switch (_op) {
+    case Operator::Equal: sqlOperator = "="; break;
+    case Operator::NotEqual: sqlOperator = "<>"; break;
+    case Operator::Less: sqlOperator = "<"; break;
+    case Operator::LessOrEqual: sqlOperator = "<="; break;
+    case Operator::Greater: sqlOperator = ">"; break;
+    case Operator::GreaterOrEqual: sqlOperator = ">="; break;
+    default: break;
+    }
+
+    return QString("%0 %1 %2").arg(_field, sqlOperator, key);
+}
+
+int DBPredicate::compare(const QVariant &left, const QVariant &right) {
+    if (isInteger(left) && isInteger(right)) {
+        const qint64 l = left.toLongLong();
+        const qint64 r = right.toLongLong();
+        return (l < r)? -1: (l > r)? 1: 0;
+    }
+
+    double l = 0, r = 0;
+    if ((isNumber(left) || isNumber(right)) && toNumber(left, l) && toNumber(right, r)) {
+        return (l < r)? -1: (l > r)? 1: 0;
+    }
+
+    if (left.userType() == QMetaType::QByteArray && right.userType() == QMetaType::QByteArray) {
+        const QByteArray lb = left.toByteArray();
+        const QByteArray rb = right.toByteArray();
+        return (lb < rb)? -1: (lb > rb)? 1: 0;
+    }
+
+    return left.toString().compare(right.toString());
+}
+
+}
+}
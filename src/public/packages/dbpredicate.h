@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef DBPREDICATE_H
+#define DBPREDICATE_H
+
+#include "heart_global.h"
+
+#include <QList>
+#include <QString>
+#include <QVariantMap>
+
+namespace QH {
+namespace PKG {
+
+/**
+ * @brief The DBPredicate class is typed condition of the select request (field, operator, value) that can be combined by the AND and OR operators.
+ *  Unlike the string conditions the predicate can be converted into sql and checked in the memory, so caches can answer to requests without database.
+ *
+ * Example:
+ * \code{cpp}
+ *  using Op = QH::PKG::DBPredicate::Operator;
+ *  QH::PKG::DBObjectsRequest<User> request("users", QH::PKG::DBPredicate("points", Op::Greater, 10) &&
+ *                                                   QH::PKG::DBPredicate("name", Op::NotEqual, "admin"));
+ * \endcode
+ *
+ * @note The null value compared by the Equal and NotEqual operators works as the IS NULL and IS NOT NULL conditions. Other operators with null values are always false, like in sql.
+ * @see DBObjectsRequest
+ */
+class HEARTSHARED_EXPORT DBPredicate
+{
+public:
+
+    /**
+     * @brief The Operator enum contains operators of the predicate.
+     */
+    enum class Operator: int {
+        /// Empty predicate. Matches all rows.
+        None,
+        /// field = value
+        Equal,
+        /// field <> value
+        NotEqual,
+        /// field < value
+        Less,
+        /// field <= value
+        LessOrEqual,
+        /// field > value
+        Greater,
+        /// field >= value
+        GreaterOrEqual,
+        /// All operands should be true.
+        And,
+        /// One of operands should be true.
+        Or
+    };
+
+    /**
+     * @brief DBPredicate This constructor creates empty predicate that matches all rows.
+     */
+    DBPredicate();
+
+    /**
+     * @brief DBPredicate This constructor creates comparison of the @a field with the @a value.
+     * @param field This is name of the column.
+     * @param op This is comparison operator.
+     * @param value This is value for comparison.
+     */
+    DBPredicate(const QString& field, Operator op, const QVariant& value);
+
+    /**
+     * @brief operator && This operator return predicate that is true when this and @a other predicates are true.
+     */
+    DBPredicate operator&&(const DBPredicate& other) const;
+
+    /**
+     * @brief operator || This operator return predicate that is true when this or @a other predicates are true.
+     */
+    DBPredicate operator||(const DBPredicate& other) const;
+
+    /**
+     * @brief isEmpty This method return true if this predicate do not contains conditions.
+     * @return true if predicate is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief op This method return operator of this predicate.
+     * @return operator of this predicate.
+     */
+    Operator op() const;
+
+    /**
+     * @brief field This method return field of the comparison.
+     * @return name of the column.
+     */
+    const QString& field() const;
+
+    /**
+     * @brief value This method return value of the comparison.
+     * @return value of the comparison.
+     */
+    const QVariant& value() const;
+
+    /**
+     * @brief operands This method return operands of the And and Or predicates.
+     * @return list of operands.
+     */
+    const QList<DBPredicate>& operands() const;
+
+    /**
+     * @brief match This method checks the row.
+     * @param values This is values of the row (column: value).
+     * @return true if the row matches to this predicate.
+     */
+    bool match(const QVariantMap& values) const;
+
+    /**
+     * @brief toSql This method return condition of the WHERE block of the sql query.
+     * @param bindValues This is values for binding. New values added with unique keys.
+     * @return sql condition or empty string if predicate is empty.
+     */
+    QString toSql(QVariantMap& bindValues) const;
+
+    /**
+     * @brief compare This method compares values like sqlite: numbers are compared as numbers (strings with numbers too) and other values as strings.
+     * @param left This is left value.
+     * @param right This is right value.
+     * @return negative value if @a left less then @a right, 0 if values are equal and positive value in other case.
+     */
+    static int compare(const QVariant& left, const QVariant& right);
+
+private:
+    DBPredicate(Operator op, const QList<DBPredicate>& operands);
+    DBPredicate combine(Operator op, const DBPredicate& other) const;
+
+    Operator _op = Operator::None;
+    QString _field;
+    QVariant _value;
+    QList<DBPredicate> _operands;
+};
+
+}
+}
+#endif // DBPREDICATE_H
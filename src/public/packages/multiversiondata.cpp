@@ -7,16 +7,31 @@
 
 #include "multiversiondata.h"
 #include "qaglobalutils.h"
+#include "config.h"
 
 #include <QIODevice>
+#include <algorithm>
+#include <cstring>
 
 namespace QH {
 namespace PKG {
 
-#define MAGIC "mver"
+// legacy prefix: QByteArray{"mver"} - size of array and 4 chars.
+#define LEGACY_MAGIC "\x00\x00\x00\x04mver"
+#define LEGACY_MAGIC_SIZE 8
 
-MultiversionData::MultiversionData(const QMap<unsigned short /*version*/, SerializationBox>& serializers):
-    _serializers(serializers) {
+#define MAGIC "\xFEmvr"
+#define MAGIC_SIZE 4
+
+MultiversionData::MultiversionData(const QMap<unsigned short /*version*/, SerializationBox>& serializers) {
+
+    _versions.reserve(serializers.size());
+    _serializers.reserve(serializers.size());
+
+    for (auto it = serializers.cbegin(); it != serializers.cend(); ++it) {
+        _versions.push_back(it.key());
+        _serializers.push_back(it.value());
+    }
 
     if (serializers.size()) {
         _packageVersion.setMax(serializers.lastKey());
@@ -33,17 +48,19 @@ QDataStream &MultiversionData::fromStream(QDataStream &stream) {
         return stream;
     }
 
-    QByteArray magic;
-    stream >> magic;
-
     unsigned short version = 0;
-    if (magic == MAGIC) {
-        stream >> version;
-    } else {
-        stream.device()->seek(0);
+    if (!readVersion(stream, &version)) {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return stream;
+    }
+
+    auto box = serializer(version);
+    if (!box || !box->from) {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return stream;
     }
 
-    return _serializers.value(version).from(stream);
+    return box->from(stream);
 }
 
 QDataStream &MultiversionData::toStream(QDataStream &stream) const {
@@ -55,8 +72,7 @@ QDataStream &MultiversionData::toStream(QDataStream &stream) const {
         return stream;
     }
 
-    stream << QByteArray{MAGIC};
-    stream << _serializers.lastKey();
+    writeVersion(stream, _versions.last());
 
     return _serializers.last().to(stream);
 }
@@ -76,8 +92,8 @@ QByteArray MultiversionData::toBytesOf(const DistVersion& version) const {
 QDataStream &MultiversionData::toStreamOf(QDataStream &stream, const DistVersion& version) const {
 
     unsigned short ver = _packageVersion.getMaxCompatible(version);
-    auto serializer = _serializers.value(ver, {});
-    if (!serializer.to) {
+    auto box = serializer(ver);
+    if (!box || !box->to) {
         debug_assert(false,
                      "Your MultiversionData not support the required version serialized functions. "
                      "Please initialize it in constructor of the MultiversionData class.");
@@ -85,11 +101,10 @@ QDataStream &MultiversionData::toStreamOf(QDataStream &stream, const DistVersion
     }
 
     if (ver) {
-        stream << QByteArray{MAGIC};
-        stream << ver;
+        writeVersion(stream, ver);
     }
 
-    return serializer.to(stream);
+    return box->to(stream);
 }
 
 bool MultiversionData::toPackage(Package &package,
@@ -114,5 +129,75 @@ const DistVersion &MultiversionData::packageVersion() const {
     return _packageVersion;
 }
 
+const SerializationBox *MultiversionData::serializer(unsigned short version) const {
+    auto it = std::lower_bound(_versions.cbegin(), _versions.cend(), version);
+    if (it == _versions.cend() || *it != version) {
+        return nullptr;
+    }
+
+    return &_serializers[static_cast<int>(it - _versions.cbegin())];
+}
+
+void MultiversionData::writeVersion(QDataStream &stream, unsigned short version) const {
+#ifndef HEART_MULTIVERSION_COMPACT_PREFIX
+    // old nodes can read only the "mver" prefix, see the HEART_MULTIVERSION_COMPACT_PREFIX option.
+    stream.writeRawData(LEGACY_MAGIC, LEGACY_MAGIC_SIZE);
+    stream << version;
+#else
+    stream.writeRawData(MAGIC, MAGIC_SIZE);
+
+    // varint: the most of versions takes only one byte.
+    while (version >= 0x80) {
+        const char byte = static_cast<char>((version & 0x7F) | 0x80);
+        stream.writeRawData(&byte, 1);
+        version >>= 7;
+    }
+
+    const char byte = static_cast<char>(version);
+    stream.writeRawData(&byte, 1);
+#endif
+}
+
+bool MultiversionData::readVersion(QDataStream &stream, unsigned short *version) const {
+    *version = 0;
+
+    auto device = stream.device();
+    if (!device) {
+        return false;
+    }
+
+    char prefix[LEGACY_MAGIC_SIZE];
+    const qint64 size = device->peek(prefix, LEGACY_MAGIC_SIZE);
+
+    if (size >= MAGIC_SIZE && memcmp(prefix, MAGIC, MAGIC_SIZE) == 0) {
+        stream.skipRawData(MAGIC_SIZE);
+
+        quint32 result = 0;
+        for (int shift = 0; shift < 16; shift += 7) {
+            char byte = 0;
+            if (stream.readRawData(&byte, 1) != 1) {
+                return false;
+            }
+
+            result |= static_cast<quint32>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                *version = static_cast<unsigned short>(result);
+                return result <= 0xFFFF;
+            }
+        }
+
+        return false;
+    }
+
+    if (size == LEGACY_MAGIC_SIZE && memcmp(prefix, LEGACY_MAGIC, LEGACY_MAGIC_SIZE) == 0) {
+        stream.skipRawData(LEGACY_MAGIC_SIZE);
+        stream >> *version;
+        return stream.status() == QDataStream::Ok;
+    }
+
+    // packages of the version 0 do not have any prefix.
+    return true;
+}
+
 }
 }
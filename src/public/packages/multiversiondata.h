@@ -10,6 +10,8 @@
 
 #include "abstractdata.h"
 
+#include <QVector>
+
 
 namespace QH {
 namespace PKG {
@@ -63,6 +65,10 @@ struct SerializationBox {
  *  @endcode
  *
  *  @note the default toBytes function of this class will be convert your class using latest version.
+ *
+ *  By default the version of the package written with the old "mver" prefix, so old nodes can read new packages. Version 0 written without any prefix.
+ *  If all nodes of your network support the compact prefix (fixed 4 bytes tag with the varint number of version) enable the HEART_MULTIVERSION_COMPACT_PREFIX cmake option.
+ *  Both prefixes are supported on reading.
  */
 class HEARTSHARED_EXPORT MultiversionData: public AbstractData
 {
@@ -103,8 +109,15 @@ public:
 
 
 private:
+    const SerializationBox* serializer(unsigned short version) const;
+    void writeVersion(QDataStream& stream, unsigned short version) const;
+    bool readVersion(QDataStream& stream, unsigned short* version) const;
+
     DistVersion _packageVersion;
-    QMap<unsigned short /*version*/, SerializationBox> _serializers;
+
+    // sorted flat table of the serializers.
+    QVector<unsigned short> _versions;
+    QVector<SerializationBox> _serializers;
 
 
 };
@@ -0,0 +1,549 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "packedrows.h"
+#include "universaldata.h"
+#include "config.h"
+
+#include <QMap>
+#include <QtAlgorithms>
+#include <QtEndian>
+#include <cstring>
+#include <limits>
+
+#define PACKED_ROWS_VERSION 1
+
+namespace QH {
+namespace PKG {
+
+namespace {
+
+enum ColumnFlags: quint8 {
+    DeltaFlag = 0x1,
+    PresenceFlag = 0x2
+};
+
+void writeVarint(QByteArray& out, quint64 value) {
+    while (value >= 0x80) {
+        out.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+
+    out.append(static_cast<char>(value));
+}
+
+bool readVarint(const char*& pos, const char* end, quint64& value) {
+    value = 0;
+    int shift = 0;
+    while (pos < end && shift < 64) {
+        const quint8 byte = static_cast<quint8>(*pos++);
+        value |= static_cast<quint64>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+
+        shift += 7;
+    }
+
+    return false;
+}
+
+quint64 zigzag(qint64 value) {
+    return (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63);
+}
+
+qint64 unzigzag(quint64 value) {
+    return static_cast<qint64>(value >> 1) ^ -static_cast<qint64>(value & 1);
+}
+
+bool isInteger(int type) {
+    switch (type) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+        return true;
+    default:
+        return false;
+    }
+}
+
+QVariant integerVariant(int type, qint64 value) {
+    switch (type) {
+    case QMetaType::Bool: return QVariant(value != 0);
+    case QMetaType::Int: return QVariant(static_cast<int>(value));
+    case QMetaType::UInt: return QVariant(static_cast<uint>(value));
+    case QMetaType::LongLong: return QVariant(static_cast<qlonglong>(value));
+    case QMetaType::ULongLong: return QVariant(static_cast<qulonglong>(value));
+    case QMetaType::Long: return QVariant::fromValue(static_cast<long>(value));
+    case QMetaType::ULong: return QVariant::fromValue(static_cast<unsigned long>(value));
+    case QMetaType::Short: return QVariant::fromValue(static_cast<short>(value));
+    case QMetaType::UShort: return QVariant::fromValue(static_cast<unsigned short>(value));
+    case QMetaType::Char: return QVariant::fromValue(static_cast<char>(value));
+    case QMetaType::SChar: return QVariant::fromValue(static_cast<signed char>(value));
+    case QMetaType::UChar: return QVariant::fromValue(static_cast<uchar>(value));
+    default: return QVariant(static_cast<qlonglong>(value));
+    }
+}
+
+qint64 integerValue(const QVariant& value) {
+    if (value.userType() == QMetaType::ULongLong || value.userType() == QMetaType::ULong) {
+        return static_cast<qint64>(value.toULongLong());
+    }
+
+    return value.toLongLong();
+}
+
+quint32 presentCount(const QByteArray& presence, quint32 rows) {
+    quint32 result = 0;
+    for (int i = 0; i < presence.size(); ++i) {
+        quint8 byte = static_cast<quint8>(presence[i]);
+        if (i == presence.size() - 1 && rows % 8) {
+            byte &= static_cast<quint8>((1 << (rows % 8)) - 1);
+        }
+
+        result += qPopulationCount(byte);
+    }
+
+    return result;
+}
+
+}
+
+PackedRowView::PackedRowView(const PackedRows *rows, int row):
+    _rows(rows),
+    _row(row) {
+
+}
+
+bool PackedRowView::contains(int field) const {
+    const int column = _rows->columnIndex(field);
+    return column >= 0 && _rows->isPresent(_row, column);
+}
+
+QVariant PackedRowView::value(int field) const {
+    const int column = _rows->columnIndex(field);
+    if (column < 0 || !_rows->isPresent(_row, column)) {
+        return {};
+    }
+
+    return _rows->toVariant(_row, column);
+}
+
+qint64 PackedRowView::toInt(int field) const {
+    const int column = _rows->columnIndex(field);
+    if (column < 0 || !_rows->isPresent(_row, column) ||
+        _rows->_columns[column].kind != PackedRows::ColumnKind::Integer) {
+        return 0;
+    }
+
+    return _rows->cell(_row, column);
+}
+
+double PackedRowView::toDouble(int field) const {
+    const int column = _rows->columnIndex(field);
+    if (column < 0 || !_rows->isPresent(_row, column) ||
+        _rows->_columns[column].kind != PackedRows::ColumnKind::Double) {
+        return 0;
+    }
+
+    const qint64 bits = _rows->cell(_row, column);
+    double result = 0;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+QByteArray PackedRowView::toBytes(int field) const {
+    const int column = _rows->columnIndex(field);
+    if (column < 0 || !_rows->isPresent(_row, column) ||
+        _rows->_columns[column].kind != PackedRows::ColumnKind::Bytes) {
+        return {};
+    }
+
+    const qint64 cell = _rows->cell(_row, column);
+    const auto &blob = _rows->_columns[column].blob;
+    return QByteArray::fromRawData(blob.constData() + (cell >> 32),
+                                   static_cast<int>(cell & 0xFFFFFFFF));
+}
+
+void PackedRowView::fill(UniversalData &data) const {
+    for (int column = 0; column < _rows->_columns.size(); ++column) {
+        if (_rows->isPresent(_row, column)) {
+            data.setValue(_rows->_columns[column].field, _rows->toVariant(_row, column));
+        }
+    }
+}
+
+int PackedRowView::row() const {
+    return _row;
+}
+
+PackedRows::PackedRows() {
+
+}
+
+void PackedRows::write(QDataStream &stream, const QList<const UniversalData *> &rows, bool deltaIntegers) {
+
+    // collect schema of the rows. -1 means that the column contains values with different types.
+    QMap<int, int> types;
+    for (const auto row: rows) {
+        const auto keys = row->keys();
+        for (int key: keys) {
+            const int type = row->value(key).userType();
+            auto it = types.find(key);
+            if (it == types.end()) {
+                types.insert(key, type);
+            } else if (it.value() != type) {
+                it.value() = -1;
+            }
+        }
+    }
+
+    stream << static_cast<quint8>(PACKED_ROWS_VERSION)
+           << static_cast<quint32>(rows.size())
+           << static_cast<quint32>(types.size());
+
+    for (auto it = types.cbegin(); it != types.cend(); ++it) {
+        const int field = it.key();
+        const int type = it.value();
+
+        ColumnKind kind = ColumnKind::Variant;
+        if (isInteger(type)) {
+            kind = ColumnKind::Integer;
+        } else if (type == QMetaType::Double || type == QMetaType::Float) {
+            kind = ColumnKind::Double;
+        } else if (type == QMetaType::QByteArray || type == QMetaType::QString) {
+            kind = ColumnKind::Bytes;
+        }
+
+        QByteArray presence((rows.size() + 7) / 8, 0);
+        bool allPresent = true;
+        QByteArray payload;
+        QByteArray data;
+        QDataStream variantStream(&payload, QIODevice::WriteOnly);
+        variantStream.setVersion(stream.version());
+
+        qint64 prev = 0;
+        for (int i = 0; i < rows.size(); ++i) {
+            const auto &row = rows[i];
+            if (!row->contains(field)) {
+                allPresent = false;
+                continue;
+            }
+
+            const QVariant& value = row->value(field);
+
+            presence[i / 8] = static_cast<char>(presence[i / 8] | (1 << (i % 8)));
+
+            switch (kind) {
+            case ColumnKind::Integer: {
+                const qint64 number = integerValue(value);
+                if (deltaIntegers) {
+                    writeVarint(payload, zigzag(static_cast<qint64>(static_cast<quint64>(number) -
+                                                                    static_cast<quint64>(prev))));
+                    prev = number;
+                } else {
+                    writeVarint(payload, zigzag(number));
+                }
+                break;
+            }
+            case ColumnKind::Double: {
+                const double number = value.toDouble();
+                quint64 bits = 0;
+                memcpy(&bits, &number, sizeof(bits));
+                bits = qToLittleEndian(bits);
+                payload.append(reinterpret_cast<const char*>(&bits), sizeof(bits));
+                break;
+            }
+            case ColumnKind::Bytes: {
+                const QByteArray bytes = (type == QMetaType::QString)? value.toString().toUtf8():
+                                                                       value.toByteArray();
+                writeVarint(payload, static_cast<quint64>(bytes.size()));
+                data.append(bytes);
+                break;
+            }
+            case ColumnKind::Variant:
+                variantStream << value;
+                break;
+            }
+        }
+
+        quint8 flags = 0;
+        if (kind == ColumnKind::Integer && deltaIntegers) {
+            flags |= DeltaFlag;
+        }
+
+        if (!allPresent) {
+            flags |= PresenceFlag;
+        }
+
+        stream << static_cast<qint32>(field)
+               << static_cast<qint32>(type)
+               << static_cast<quint8>(kind)
+               << flags;
+
+        if (!allPresent) {
+            stream << presence;
+        }
+
+        stream << payload;
+
+        if (kind == ColumnKind::Bytes) {
+            stream << data;
+        }
+    }
+}
+
+bool PackedRows::read(QDataStream &stream) {
+    clear();
+
+    quint8 version = 0;
+    quint32 rows = 0;
+    quint32 columns = 0;
+    stream >> version >> rows >> columns;
+
+    // rows without columns do not take any bytes of the stream, so they are not allowed.
+    if (stream.status() != QDataStream::Ok || version != PACKED_ROWS_VERSION ||
+        rows > PACKED_ROWS_MAX ||
+        (rows && !columns)) {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return false;
+    }
+
+    struct RawColumn {
+        quint8 flags = 0;
+        QByteArray presence;
+        QByteArray payload;
+    };
+
+    // read all columns before allocation of the cells, so the broken header can not allocate a lot of memory.
+    QVector<RawColumn> raw;
+    qint64 totalPresent = 0;
+    for (quint32 i = 0; i < columns && stream.status() == QDataStream::Ok; ++i) {
+        qint32 field = 0;
+        qint32 type = 0;
+        quint8 kind = 0;
+        RawColumn rawColumn;
+        stream >> field >> type >> kind >> rawColumn.flags;
+
+        if (kind > static_cast<quint8>(ColumnKind::Variant)) {
+            stream.setStatus(QDataStream::ReadCorruptData);
+            break;
+        }
+
+        Column column;
+        column.field = field;
+        column.type = type;
+        column.kind = static_cast<ColumnKind>(kind);
+
+        if (rawColumn.flags & PresenceFlag) {
+            stream >> rawColumn.presence;
+            if (rawColumn.presence.size() != static_cast<int>((rows + 7) / 8)) {
+                stream.setStatus(QDataStream::ReadCorruptData);
+            }
+        }
+
+        stream >> rawColumn.payload;
+
+        if (column.kind == ColumnKind::Bytes) {
+            stream >> column.blob;
+        }
+
+        // each present value takes at least one byte of the payload and the writer do not creates empty columns.
+        const quint32 present = (rawColumn.flags & PresenceFlag)? presentCount(rawColumn.presence, rows): rows;
+        if ((rows && !present) || static_cast<quint32>(rawColumn.payload.size()) < present) {
+            stream.setStatus(QDataStream::ReadCorruptData);
+        }
+
+        totalPresent += present;
+
+        _columns.push_back(column);
+        raw.push_back(rawColumn);
+    }
+
+    // each row contains at least one value, so count of the rows is limited by the size of the payloads.
+    if (stream.status() == QDataStream::Ok && totalPresent < rows) {
+        stream.setStatus(QDataStream::ReadCorruptData);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        clear();
+        return false;
+    }
+
+    const qint64 cellsCount = static_cast<qint64>(rows) * _columns.size();
+    if (cellsCount > std::numeric_limits<int>::max() / 2) {
+        clear();
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return false;
+    }
+
+    _rows = static_cast<int>(rows);
+    _cells.resize(static_cast<int>(cellsCount + (cellsCount + 63) / 64));
+
+    for (int column = 0; column < _columns.size(); ++column) {
+        const auto &source = raw[column];
+        const auto &target = _columns[column];
+
+        const char* pos = source.payload.constData();
+        const char* end = pos + source.payload.size();
+
+        QDataStream variantStream(source.payload);
+        variantStream.setVersion(stream.version());
+
+        qint64 prev = 0;
+        qint64 offset = 0;
+
+        for (int row = 0; row < _rows; ++row) {
+            if ((source.flags & PresenceFlag) &&
+                !(static_cast<quint8>(source.presence[row / 8]) & (1 << (row % 8)))) {
+                continue;
+            }
+
+            const qint64 index = static_cast<qint64>(row) * _columns.size() + column;
+            _cells[static_cast<int>(cellsCount + index / 64)] |= static_cast<qint64>(1ULL << (index % 64));
+            qint64 &value = _cells[static_cast<int>(index)];
+
+            bool ok = true;
+            switch (target.kind) {
+            case ColumnKind::Integer: {
+                quint64 number = 0;
+                ok = readVarint(pos, end, number);
+                value = unzigzag(number);
+                if (source.flags & DeltaFlag) {
+                    value = static_cast<qint64>(static_cast<quint64>(prev) + static_cast<quint64>(value));
+                    prev = value;
+                }
+                break;
+            }
+            case ColumnKind::Double: {
+                quint64 bits = 0;
+                ok = end - pos >= static_cast<qint64>(sizeof(bits));
+                if (ok) {
+                    memcpy(&bits, pos, sizeof(bits));
+                    pos += sizeof(bits);
+                    value = static_cast<qint64>(qFromLittleEndian(bits));
+                }
+                break;
+            }
+            case ColumnKind::Bytes: {
+                quint64 length = 0;
+                ok = readVarint(pos, end, length) && length <= static_cast<quint64>(target.blob.size() - offset);
+                value = (offset << 32) | static_cast<qint64>(length);
+                offset += static_cast<qint64>(length);
+                break;
+            }
+            case ColumnKind::Variant: {
+                QVariant variant;
+                variantStream >> variant;
+                ok = variantStream.status() == QDataStream::Ok;
+                value = _variants.size();
+                _variants.push_back(variant);
+                break;
+            }
+            }
+
+            if (!ok) {
+                clear();
+                stream.setStatus(QDataStream::ReadCorruptData);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+int PackedRows::size() const {
+    return _rows;
+}
+
+QList<int> PackedRows::fields() const {
+    QList<int> result;
+    result.reserve(_columns.size());
+    for (const auto& column: _columns) {
+        result.push_back(column.field);
+    }
+
+    return result;
+}
+
+PackedRowView PackedRows::at(int row) const {
+    return PackedRowView(this, row);
+}
+
+void PackedRows::clear() {
+    _rows = 0;
+    _columns.clear();
+    _cells.clear();
+    _variants.clear();
+}
+
+int PackedRows::columnIndex(int field) const {
+    for (int i = 0; i < _columns.size(); ++i) {
+        if (_columns[i].field == field) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+bool PackedRows::isPresent(int row, int column) const {
+    if (row < 0 || row >= _rows) {
+        return false;
+    }
+
+    const qint64 cellsCount = static_cast<qint64>(_rows) * _columns.size();
+    const qint64 index = static_cast<qint64>(row) * _columns.size() + column;
+    return _cells[static_cast<int>(cellsCount + index / 64)] & static_cast<qint64>(1ULL << (index % 64));
+}
+
+qint64 PackedRows::cell(int row, int column) const {
+    return _cells[row * _columns.size() + column];
+}
+
+QVariant PackedRows::toVariant(int row, int column) const {
+    const auto &col = _columns[column];
+    const qint64 value = cell(row, column);
+
+    switch (col.kind) {
+    case ColumnKind::Integer:
+        return integerVariant(col.type, value);
+    case ColumnKind::Double: {
+        double number = 0;
+        memcpy(&number, &value, sizeof(number));
+        if (col.type == QMetaType::Float) {
+            return QVariant(static_cast<float>(number));
+        }
+        return QVariant(number);
+    }
+    case ColumnKind::Bytes: {
+        const char* data = col.blob.constData() + (value >> 32);
+        const int length = static_cast<int>(value & 0xFFFFFFFF);
+        if (col.type == QMetaType::QString) {
+            return QVariant(QString::fromUtf8(data, length));
+        }
+        return QVariant(QByteArray(data, length));
+    }
+    case ColumnKind::Variant:
+        return _variants.value(static_cast<int>(value));
+    }
+
+    return {};
+}
+
+}
+}
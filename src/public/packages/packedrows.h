@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef PACKEDROWS_H
+#define PACKEDROWS_H
+
+#include "heart_global.h"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QList>
+#include <QVariant>
+#include <QVector>
+
+namespace QH {
+namespace PKG {
+
+class UniversalData;
+class PackedRows;
+
+/**
+ * @brief The PackedRowView class is lightweight view of the one row of the PackedRows container.
+ * The view do not copy any data, so it is valid only while the source PackedRows object is alive.
+ * @see PackedRows
+ */
+class HEARTSHARED_EXPORT PackedRowView
+{
+public:
+    PackedRowView(const PackedRows* rows, int row);
+
+    /**
+     * @brief contains This method return true if the row contains the @a field.
+     * @param field This is id of the field.
+     * @return true if the row contains the @a field.
+     */
+    bool contains(int field) const;
+
+    /**
+     * @brief value This method return value of the @a field. Works like a UniversalData::value method.
+     * @param field This is id of the field.
+     * @return value of the field or invalid variant if the row do not contains the field.
+     */
+    QVariant value(int field) const;
+
+    /**
+     * @brief toInt This method return value of the integer @a field without converting to QVariant.
+     * @param field This is id of the field.
+     * @return value of the field or 0 if the field is not integer.
+     */
+    qint64 toInt(int field) const;
+
+    /**
+     * @brief toDouble This method return value of the floating point @a field without converting to QVariant.
+     * @param field This is id of the field.
+     * @return value of the field or 0 if the field is not a floating point number.
+     */
+    double toDouble(int field) const;
+
+    /**
+     * @brief toBytes This method return raw bytes of the string or bytes @a field. The result array do not copy data of the container.
+     * @param field This is id of the field.
+     * @return value of the field or empty array if the field is not a bytes or string.
+     */
+    QByteArray toBytes(int field) const;
+
+    /**
+     * @brief fill This method copy all fields of the row into the @a data object.
+     * @param data This is result object.
+     */
+    void fill(UniversalData& data) const;
+
+    /**
+     * @brief row This method return index of the row.
+     * @return index of the row.
+     */
+    int row() const;
+
+private:
+    const PackedRows* _rows = nullptr;
+    int _row = 0;
+};
+
+/**
+ * @brief The PackedRows class is column-wise container of the UniversalData rows with same schema.
+ * Each column saves the type of values only once and all values of the column are written together.
+ * Integer columns are written as zigzag varints with optional delta encoding, floating point columns as raw doubles
+ * and strings or bytes as one blob with lengths. Other types are written as QVariant.
+ *
+ * The decoded container keeps all values in the one array, so decoding of the N rows requires only one allocation for cells and
+ * one allocation for each string column. Use the PackedRowView for access to rows.
+ * @see DataPack::setPacked
+ */
+class HEARTSHARED_EXPORT PackedRows
+{
+public:
+    PackedRows();
+
+    /**
+     * @brief write This method writes the @a rows into the @a stream column-wise.
+     * @param stream This is output stream.
+     * @param rows This is list of rows.
+     * @param deltaIntegers This option enables delta encoding of the integer columns. Use it for sorted ids or timestamps.
+     * @note Each row should contains at least one value, the PackedRows::read method rejects rows without values.
+     */
+    static void write(QDataStream& stream, const QList<const UniversalData*>& rows, bool deltaIntegers);
+
+    /**
+     * @brief read This method reads rows from the @a stream.
+     *  The count of rows is limited by the PACKED_ROWS_MAX and by the count of the received values,
+     *  so the broken header can not allocate a lot of memory.
+     * @param stream This is input stream.
+     * @return true if rows readed successful.
+     */
+    bool read(QDataStream& stream);
+
+    /**
+     * @brief size This method return count of rows.
+     * @return count of rows.
+     */
+    int size() const;
+
+    /**
+     * @brief fields This method return list of fields (columns) of the rows.
+     * @return list of fields.
+     */
+    QList<int> fields() const;
+
+    /**
+     * @brief at This method return view of the row with index @a row.
+     * @param row This is index of the row.
+     * @return view of the row.
+     */
+    PackedRowView at(int row) const;
+
+    /**
+     * @brief clear This method remove all rows.
+     */
+    void clear();
+
+private:
+    enum class ColumnKind: quint8 {
+        Integer,
+        Double,
+        Bytes,
+        Variant
+    };
+
+    struct Column {
+        int field = 0;
+        int type = 0;
+        ColumnKind kind = ColumnKind::Variant;
+        QByteArray blob;
+    };
+
+    int columnIndex(int field) const;
+    bool isPresent(int row, int column) const;
+    qint64 cell(int row, int column) const;
+    QVariant toVariant(int row, int column) const;
+
+    int _rows = 0;
+    QVector<Column> _columns;
+
+    // rows * columns cells and the presence bitmap in the one allocation.
+    QVector<qint64> _cells;
+    QVector<QVariant> _variants;
+
+    friend class PackedRowView;
+};
+
+}
+}
+#endif // PACKEDROWS_H
@@ -68,6 +68,27 @@ PrepareResult SetSingleValue::prepareInsertQuery(QSqlQuery &q, bool replace) con
     return PrepareResult::Success;
 }
 
+PrepareResult SetSingleValue::prepareUpsertQuery(QSqlQuery &q) const {
+    const QString conflict = upsertClause(q, primaryKey(), {_field});
+    if (conflict.isEmpty()) {
+        return prepareInsertQuery(q, true);
+    }
+
+    QString queryString = "INSERT INTO %0 (%1, %2) VALUES (:%1, :%2) %3";
+    queryString = queryString.arg(table(), primaryKey(), _field, conflict);
+
+    if (!q.prepare(queryString)) {
+
+        qCritical() << "Failed to prepare query: " + q.lastError().text();
+        return PrepareResult::Fail;
+    }
+
+    q.bindValue(":" + _primaryKey, _primaryValue);
+    q.bindValue(":" + _field, _value);
+
+    return PrepareResult::Success;
+}
+
 bool SetSingleValue::fromSqlRecord(const QSqlRecord &) {
     return true;
 }
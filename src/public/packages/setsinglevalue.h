@@ -48,6 +48,7 @@ public:
     DBObject *createDBObject() const override;
     PrepareResult prepareUpdateQuery(QSqlQuery &q) const override;
     PrepareResult prepareInsertQuery(QSqlQuery &q, bool replace) const override;
+    PrepareResult prepareUpsertQuery(QSqlQuery &q) const override;
 
     bool fromSqlRecord(const QSqlRecord &q) override;
     bool isCached() const override;
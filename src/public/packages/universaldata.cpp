@@ -7,6 +7,10 @@
 
 #include "universaldata.h"
 
+#include <QtAlgorithms>
+
+static_assert(UNIVERSAL_DATA_DENSE_FIELDS > 0 && UNIVERSAL_DATA_DENSE_FIELDS <= 32,
+              "The present dense fields of the UniversalData are stored in the 32 bit mask.");
 
 namespace QH {
 namespace PKG {
@@ -17,40 +21,117 @@ UniversalData::UniversalData()
 }
 
 void UniversalData::setValue(int key, const QVariant &value) {
-    _data[key] = value;
+    if (isDense(key)) {
+        _dense[key] = value;
+        _present |= 1u << key;
+        return;
+    }
+
+    _sparse[key] = value;
 }
 
 const QVariant &UniversalData::value(int key, const QVariant &defaultVal) const {
+    if (isDense(key)) {
+        if (_present & (1u << key)) {
+            return _dense[key];
+        }
 
-    auto nonConstPtr = const_cast<QHash<int, QVariant>*>(&_data);
-    if (!nonConstPtr)
         return defaultVal;
+    }
 
-    if (nonConstPtr->contains(key)) {
-        return nonConstPtr->operator[](key);
+    auto it = _sparse.constFind(key);
+    if (it != _sparse.constEnd()) {
+        return it.value();
     }
 
     return defaultVal;
 }
 
 QVariant *UniversalData::ref(int key) {
+    if (isDense(key)) {
+        if (_present & (1u << key)) {
+            return &_dense[key];
+        }
 
-    if (_data.contains(key)) {
-        return &_data.operator[](key);
+        return nullptr;
+    }
+
+    auto it = _sparse.find(key);
+    if (it != _sparse.end()) {
+        return &it.value();
     }
 
     return nullptr;
 }
 
+bool UniversalData::contains(int key) const {
+    if (isDense(key)) {
+        return _present & (1u << key);
+    }
+
+    return _sparse.contains(key);
+}
+
+QList<int> UniversalData::keys() const {
+    QList<int> result;
+    result.reserve(qPopulationCount(_present) + _sparse.size());
+
+    for (int key = 0; key < UNIVERSAL_DATA_DENSE_FIELDS; ++key) {
+        if (_present & (1u << key)) {
+            result.push_back(key);
+        }
+    }
+
+    for (auto it = _sparse.cbegin(); it != _sparse.cend(); ++it) {
+        result.push_back(it.key());
+    }
+
+    return result;
+}
+
+bool UniversalData::isDense(int key) {
+    return key >= 0 && key < UNIVERSAL_DATA_DENSE_FIELDS;
+}
+
 QDataStream &UniversalData::fromStream(QDataStream &stream) {
 
-    stream >> _data;
+    for (int key = 0; key < UNIVERSAL_DATA_DENSE_FIELDS; ++key) {
+        _dense[key] = QVariant{};
+    }
+    _present = 0;
+    _sparse.clear();
+
+    // same layout as the QHash<int, QVariant> stream operator, but without creating of the temporary hash.
+    quint32 count = 0;
+    stream >> count;
+
+    for (quint32 i = 0; i < count; ++i) {
+        int key = 0;
+        QVariant value;
+        stream >> key >> value;
+
+        if (stream.status() != QDataStream::Ok) {
+            break;
+        }
+
+        setValue(key, value);
+    }
 
     return stream;
 }
 
 QDataStream &UniversalData::toStream(QDataStream &stream) const {
-    stream << _data;
+    stream << static_cast<quint32>(qPopulationCount(_present) + _sparse.size());
+
+    for (int key = 0; key < UNIVERSAL_DATA_DENSE_FIELDS; ++key) {
+        if (_present & (1u << key)) {
+            stream << key << _dense[key];
+        }
+    }
+
+    for (auto it = _sparse.cbegin(); it != _sparse.cend(); ++it) {
+        stream << it.key() << it.value();
+    }
 
     return stream;
 }
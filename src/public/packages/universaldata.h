@@ -9,6 +9,9 @@
 #define UNIVERSALDATA_H
 
 #include "abstractdata.h"
+#include "config.h"
+
+#include <array>
 
 namespace QH {
 namespace PKG {
@@ -22,7 +25,7 @@ namespace PKG {
  * @code{cpp}
  * class AuthRequest: public QH::PKG::UniversalData
     {
-        QH_PACKAGE(RC::API::V4::AuthRequest)
+        QH_PACKAGE("RC::API::V4::AuthRequest")
 
         enum Filds{
             UserId = 0
@@ -46,6 +49,10 @@ namespace PKG {
     }
  * @endcode
  *
+ * Fields with ids less then UNIVERSAL_DATA_DENSE_FIELDS stored in the inline array with bitmap of present fields,
+ * so small enums of fields (like in example) do not allocate memory for each field. Other fields stored in the hash.
+ * The stream format is same as format of the QHash<int, QVariant>, so the packages are compatible with old versions.
+ *
  */
 class HEARTSHARED_EXPORT UniversalData: public QH::PKG::AbstractData
 {
@@ -61,6 +68,8 @@ public:
 
     /**
      * @brief value this method return value of the key.
+     * @param key This is key of the field.
+     * @param defaultVal This is value that will be returned if this object do not contains the @a key.
      * @return value of the key.
     */
     const QVariant& value(int key, const QVariant& defaultVal = {}) const;
@@ -72,12 +81,29 @@ public:
      */
     QVariant* ref(int key);
 
+    /**
+     * @brief contains This method return true if this object contains the @a key.
+     * @param key This is key of object.
+     * @return true if this object contains the @a key.
+     */
+    bool contains(int key) const;
+
+    /**
+     * @brief keys This method return list of all keys of this object.
+     * @return list of keys.
+     */
+    QList<int> keys() const;
+
 protected:
     QDataStream &fromStream(QDataStream &stream) override final;
     QDataStream &toStream(QDataStream &stream) const override final;
 
 private:
-    QHash<int, QVariant> _data;
+    static bool isDense(int key);
+
+    std::array<QVariant, UNIVERSAL_DATA_DENSE_FIELDS> _dense;
+    quint32 _present = 0;
+    QHash<int, QVariant> _sparse;
 };
 
 }
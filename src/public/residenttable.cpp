@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "residenttable.h"
+
+#include <dbobject.h>
+#include <QSqlField>
+#include <QSqlRecord>
+
+namespace QH {
+
+using namespace PKG;
+
+ResidentTable::ResidentTable(unsigned short command, const QHash<QString, IndexType> &indexes) {
+    _command = command;
+
+    for (auto it = indexes.begin(); it != indexes.end(); ++it) {
+        if (it.value() == IndexType::Hash) {
+            _hashIndexes.insert(it.key(), {});
+        } else {
+            _orderedIndexes.insert(it.key(), {});
+        }
+    }
+}
+
+bool ResidentTable::insert(const QSharedPointer<DBObject> &object) {
+    QByteArray rowKey;
+    Row row;
+    if (!prepareRow(object, rowKey, row)) {
+        return false;
+    }
+
+    if (_loading) {
+        _touched.insert(rowKey);
+    }
+
+    storeRow(rowKey, row);
+
+    return true;
+}
+
+bool ResidentTable::update(const QSharedPointer<DBObject> &object, const QSet<QString> &fields, bool insertIfMissing) {
+    if (fields.isEmpty()) {
+        return insert(object);
+    }
+
+    QByteArray rowKey;
+    Row row;
+    if (!prepareRow(object, rowKey, row)) {
+        return false;
+    }
+
+    auto old = _rows.constFind(rowKey);
+    if (old != _rows.constEnd()) {
+        // other fields are not written by the update query, so they keep old values.
+        Row merged = old.value();
+        for (const auto& field: fields) {
+            auto value = row.values.constFind(field);
+            if (value != row.values.constEnd()) {
+                merged.values.insert(field, value.value());
+            }
+        }
+
+        row = merged;
+    } else if (!(insertIfMissing || _loading)) {
+        // the update query do not changes not existing rows.
+        return true;
+    }
+
+    if (_loading) {
+        _touched.insert(rowKey);
+    }
+
+    storeRow(rowKey, row);
+
+    return true;
+}
+
+bool ResidentTable::load(const QSharedPointer<DBObject> &object) {
+    QByteArray rowKey;
+    Row row;
+    if (!prepareRow(object, rowKey, row)) {
+        return false;
+    }
+
+    if (!_touched.contains(rowKey)) {
+        storeRow(rowKey, row);
+    }
+
+    return true;
+}
+
+void ResidentTable::setLoading(bool loading) {
+    _loading = loading;
+    _touched.clear();
+}
+
+bool ResidentTable::isLoading() const {
+    return _loading;
+}
+
+void ResidentTable::remove(const DBObject &object) {
+    const QByteArray rowKey = key(object.primaryValue());
+
+    if (_loading) {
+        _touched.insert(rowKey);
+    }
+
+    auto row = _rows.find(rowKey);
+    if (row == _rows.end()) {
+        return;
+    }
+
+    removeFromIndexes(rowKey, row.value());
+    _rows.erase(row);
+}
+
+int ResidentTable::remove(const DBPredicate &predicate) {
+    QList<QByteArray> removed;
+    for (auto it = _rows.begin(); it != _rows.end(); ++it) {
+        if (predicate.match(it.value().values)) {
+            removed.push_back(it.key());
+        }
+    }
+
+    for (const auto& rowKey: std::as_const(removed)) {
+        removeFromIndexes(rowKey, _rows.value(rowKey));
+        _rows.remove(rowKey);
+    }
+
+    return removed.size();
+}
+
+QList<QSharedPointer<DBObject>> ResidentTable::select(const DBPredicate &predicate) const {
+    QList<QSharedPointer<DBObject>> result;
+
+    QList<QByteArray> keys;
+    if (!candidates(predicate, keys)) {
+        for (const auto& row: _rows) {
+            if (predicate.match(row.values)) {
+                if (auto object = copy(row)) {
+                    result.push_back(object);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    // candidates of the index are checked by all conditions of the predicate.
+    for (const auto& rowKey: std::as_const(keys)) {
+        auto row = _rows.constFind(rowKey);
+        if (row != _rows.constEnd() && predicate.match(row.value().values)) {
+            if (auto object = copy(row.value())) {
+                result.push_back(object);
+            }
+        }
+    }
+
+    return result;
+}
+
+int ResidentTable::size() const {
+    return _rows.size();
+}
+
+void ResidentTable::clear() {
+    _rows.clear();
+
+    for (auto& index: _hashIndexes) {
+        index.clear();
+    }
+
+    for (auto& index: _orderedIndexes) {
+        index.clear();
+    }
+}
+
+bool ResidentTable::prepareRow(const QSharedPointer<DBObject> &object, QByteArray &rowKey, Row &row) const {
+    if (!object || object->cmd() != _command || object->primaryKey().isEmpty()) {
+        return false;
+    }
+
+    const DBVariantMap map = object->variantMap();
+    const QVariant primaryValue = object->primaryValue();
+    const auto primaryType = map.value(object->primaryKey()).type;
+
+    // the id of the new row is not known until the insert query is finished.
+    if (primaryValue.isNull() ||
+        (bool(primaryType & MemberType::Autoincement) && primaryValue.toLongLong() == 0)) {
+        return false;
+    }
+
+    row.object = object;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        row.values.insert(it.key(), it.value().value);
+    }
+
+    rowKey = key(primaryValue);
+
+    return true;
+}
+
+void ResidentTable::storeRow(const QByteArray &rowKey, const Row &row) {
+    auto old = _rows.find(rowKey);
+    if (old != _rows.end()) {
+        removeFromIndexes(rowKey, old.value());
+        old.value() = row;
+    } else {
+        _rows.insert(rowKey, row);
+    }
+
+    addToIndexes(rowKey, row);
+}
+
+QSharedPointer<DBObject> ResidentTable::copy(const Row &row) {
+    auto result = QSharedPointer<DBObject>(row.object->createDBObject());
+    if (!result) {
+        return nullptr;
+    }
+
+    // the object is created like the object of the select query, so it contains values of the table but not of the prototype.
+    QSqlRecord record;
+    for (auto it = row.values.begin(); it != row.values.end(); ++it) {
+        QSqlField field(it.key());
+        field.setValue(it.value());
+        record.append(field);
+    }
+
+    if (!result->fromSqlRecord(record)) {
+        return nullptr;
+    }
+
+    result->clearDirtyFields();
+    return result;
+}
+
+QByteArray ResidentTable::key(const QVariant &value) {
+    if (value.userType() == QMetaType::QByteArray) {
+        return value.toByteArray();
+    }
+
+    return value.toString().toUtf8();
+}
+
+void ResidentTable::addToIndexes(const QByteArray &rowKey, const Row &row) {
+    for (auto it = _hashIndexes.begin(); it != _hashIndexes.end(); ++it) {
+        it.value().insert(key(row.values.value(it.key())), rowKey);
+    }
+
+    for (auto it = _orderedIndexes.begin(); it != _orderedIndexes.end(); ++it) {
+        const QVariant value = row.values.value(it.key());
+
+        // null values never match to the comparison operators.
+        if (!value.isNull()) {
+            it.value().insert(OrderedKey{value}, rowKey);
+        }
+    }
+}
+
+void ResidentTable::removeFromIndexes(const QByteArray &rowKey, const Row &row) {
+    for (auto it = _hashIndexes.begin(); it != _hashIndexes.end(); ++it) {
+        it.value().remove(key(row.values.value(it.key())), rowKey);
+    }
+
+    for (auto it = _orderedIndexes.begin(); it != _orderedIndexes.end(); ++it) {
+        const QVariant value = row.values.value(it.key());
+        if (!value.isNull()) {
+            it.value().remove(OrderedKey{value}, rowKey);
+        }
+    }
+}
+
+bool ResidentTable::candidates(const DBPredicate &predicate, QList<QByteArray> &result) const {
+
+    switch (predicate.op()) {
+    case DBPredicate::Operator::And: {
+        // use the index that returns the smallest count of rows.
+        bool found = false;
+        for (const auto& operand: predicate.operands()) {
+            QList<QByteArray> keys;
+            if (candidates(operand, keys) && (!found || keys.size() < result.size())) {
+                result = keys;
+                found = true;
+            }
+        }
+
+        return found;
+    }
+
+    case DBPredicate::Operator::Or: {
+        QSet<QByteArray> keys;
+        for (const auto& operand: predicate.operands()) {
+            QList<QByteArray> operandKeys;
+            if (!candidates(operand, operandKeys)) {
+                return false;
+            }
+
+            for (const auto& rowKey: std::as_const(operandKeys)) {
+                keys.insert(rowKey);
+            }
+        }
+
+        result = keys.values();
+        return true;
+    }
+
+    case DBPredicate::Operator::None:
+        return false;
+
+    default:
+        break;
+    }
+
+    if (predicate.value().isNull()) {
+        return false;
+    }
+
+    if (predicate.op() == DBPredicate::Operator::Equal) {
+        auto hashIndex = _hashIndexes.constFind(predicate.field());
+        if (hashIndex != _hashIndexes.constEnd()) {
+            result = hashIndex.value().values(key(predicate.value()));
+            return true;
+        }
+    }
+
+    auto orderedIndex = _orderedIndexes.constFind(predicate.field());
+    if (orderedIndex == _orderedIndexes.constEnd() ||
+        predicate.op() == DBPredicate::Operator::NotEqual) {
+        return false;
+    }
+
+    const auto& index = orderedIndex.value();
+    const OrderedKey value{predicate.value()};
+
+    auto begin = index.constBegin();
+    auto end = index.constEnd();
+
+    switch (predicate.op()) {
+    case DBPredicate::Operator::Equal:
+        begin = index.lowerBound(value);
+        end = index.upperBound(value);
+        break;
+    case DBPredicate::Operator::Less:
+        end = index.lowerBound(value);
+        break;
+    case DBPredicate::Operator::LessOrEqual:
+        end = index.upperBound(value);
+        break;
+    case DBPredicate::Operator::Greater:
+        begin = index.upperBound(value);
+        break;
+    case DBPredicate::Operator::GreaterOrEqual:
+        begin = index.lowerBound(value);
+        break;
+    default:
+        return false;
+    }
+
+    for (auto it = begin; it != end; ++it) {
+        result.push_back(it.value());
+    }
+
+    return true;
+}
+
+}
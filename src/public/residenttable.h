@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef RESIDENTTABLE_H
+#define RESIDENTTABLE_H
+
+#include "heart_global.h"
+
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QSharedPointer>
+#include <QVariantMap>
+#include <dbpredicate.h>
+
+namespace QH {
+
+namespace PKG {
+class DBObject;
+}
+
+/**
+ * @brief The ResidentTable class is in memory copy of all rows of the one database table.
+ *  The table answers to the select requests with the DBPredicate conditions without database.
+ *  Use secondary indexes for fields that often used in conditions:
+ *  * Hash index works with the Equal operator.
+ *  * Ordered index works with the Equal, Less, LessOrEqual, Greater and GreaterOrEqual operators.
+ *
+ * @note This class is not thread safe. The ISqlDB class protects it by the lock.
+ * @see ISqlDB::setResident
+ */
+class HEARTSHARED_EXPORT ResidentTable
+{
+public:
+
+    /**
+     * @brief The IndexType enum contains types of the secondary indexes.
+     */
+    enum class IndexType: int {
+        /// Index for the Equal operator.
+        Hash,
+        /// Index for the comparison operators.
+        Ordered
+    };
+
+    /**
+     * @brief ResidentTable This is main constructor.
+     * @param command This is command of the objects of the table. Objects of other types (for example SetSingleValue) can not be saved into the table.
+     * @param indexes This is secondary indexes of the table (field: type of index).
+     */
+    explicit ResidentTable(unsigned short command, const QHash<QString, IndexType>& indexes = {});
+
+    /**
+     * @brief insert This method inserts the @a object into the table or replaces the row with same primary key.
+     * @param object This is database object.
+     * @return false if the object has other type or do not have the primary value yet (for example new object with autoincrement id).
+     *  In this case the table is not actual anymore.
+     */
+    bool insert(const QSharedPointer<PKG::DBObject>& object);
+
+    /**
+     * @brief update This method writes only the @a fields of the @a object into the row with same primary key, like the update query with changed fields (see DBObject::dirtyFields).
+     * @param object This is saved object.
+     * @param fields This is list of the changed fields. If the list is empty then all fields will be written.
+     * @param insertIfMissing This option inserts the @a object if the table do not contains the row (upsert).
+     * @return false if the object can not be saved into this table.
+     */
+    bool update(const QSharedPointer<PKG::DBObject>& object, const QSet<QString>& fields, bool insertIfMissing);
+
+    /**
+     * @brief load This method inserts the row loaded from the database in background (see ISqlDB::preloadResident).
+     *  Unlike the insert method this method do not replace rows that changed or removed after start of the loading, because the loaded row can be older.
+     * @param object This is loaded object.
+     * @return false if the object can not be saved into this table.
+     */
+    bool load(const QSharedPointer<PKG::DBObject>& object);
+
+    /**
+     * @brief setLoading This method enables or disables the loading state. The table in the loading state tracks changed rows and can not be used for select requests.
+     * @param loading This is new state.
+     */
+    void setLoading(bool loading);
+
+    /**
+     * @brief isLoading This method return true if table is not loaded fully yet.
+     * @return true if table in the loading state.
+     */
+    bool isLoading() const;
+
+    /**
+     * @brief remove This method removes row with the primary value of the @a object.
+     * @param object This is removed object.
+     */
+    void remove(const PKG::DBObject& object);
+
+    /**
+     * @brief remove This method removes all rows that match to the @a predicate.
+     * @param predicate This is condition of the removed rows.
+     * @return count of removed rows.
+     */
+    int remove(const PKG::DBPredicate& predicate);
+
+    /**
+     * @brief select This method return all rows that match to the @a predicate.
+     * @param predicate This is condition of the select.
+     * @return list of new objects, so changes of the returned objects do not change the table.
+     */
+    QList<QSharedPointer<PKG::DBObject>> select(const PKG::DBPredicate& predicate) const;
+
+    /**
+     * @brief size This method return count of rows.
+     * @return count of rows.
+     */
+    int size() const;
+
+    /**
+     * @brief clear This method removes all rows.
+     */
+    void clear();
+
+private:
+
+    /**
+     * @brief The OrderedKey struct is key of the ordered index. Values are compared by the DBPredicate::compare method.
+     */
+    struct OrderedKey {
+        QVariant value;
+        bool operator<(const OrderedKey& other) const {
+            return PKG::DBPredicate::compare(value, other.value) < 0;
+        }
+    };
+
+    struct Row {
+        // prototype of the returned objects.
+        QSharedPointer<PKG::DBObject> object;
+        QVariantMap values;
+    };
+
+    static QByteArray key(const QVariant& value);
+    static QSharedPointer<PKG::DBObject> copy(const Row& row);
+
+    bool prepareRow(const QSharedPointer<PKG::DBObject>& object, QByteArray& rowKey, Row& row) const;
+    void storeRow(const QByteArray& rowKey, const Row& row);
+
+    void addToIndexes(const QByteArray& rowKey, const Row& row);
+    void removeFromIndexes(const QByteArray& rowKey, const Row& row);
+    bool candidates(const PKG::DBPredicate& predicate, QList<QByteArray>& result) const;
+
+    unsigned short _command = 0;
+    bool _loading = false;
+    // rows changed while loading.
+    QSet<QByteArray> _touched;
+    QHash<QByteArray, Row> _rows;
+    QHash<QString, QMultiHash<QByteArray, QByteArray>> _hashIndexes;
+    QHash<QString, QMultiMap<OrderedKey, QByteArray>> _orderedIndexes;
+};
+
+}
+#endif // RESIDENTTABLE_H
@@ -20,56 +20,206 @@
 #include <QSqlRecord>
 #include <QStandardPaths>
 #include <QCoreApplication>
+#include <QSqlDriver>
+#include <QElapsedTimer>
+#include "sqlscript.h"
+#include <algorithm>
+
+#ifdef HEART_SQLITE_BACKUP_API
+#include <sqlite3.h>
+#endif
 
 namespace QH {
 using namespace PKG;
 
-bool SqlDBWriter::exec(QSqlQuery *sq, const QString& sqlFile) const {
-    QFile f(sqlFile);
-    bool result = true;
-    if (f.open(QIODevice::ReadOnly)) {
+// the backup is written into the temporary file, so the old backup is removed only after success.
+static QString backUpTempFile(const QString& file) {
+    return file + ".tmp";
+}
 
-        QString temp, delimiter = ";";
-        QTextStream stream(&f);
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-        stream.setCodec("UTF8");
-#endif
-        int lineNumber = 0;
-        while(!stream.atEnd()) {
-            QString line = stream.readLine();
-            lineNumber++;
-            int linedelimiterIndex = line.lastIndexOf(delimiter, -1, Qt::CaseInsensitive);
-            int delimiterIndex = temp.size() + linedelimiterIndex;
+static bool replaceBackUp(const QString& temp, const QString& file) {
+    if (QFile::exists(file) && !QFile::remove(file)) {
+        qCritical() << "Failed to remove the old backup: " << file;
+        QFile::remove(temp);
+        return false;
+    }
 
-            if (line.contains("--"))
-                continue;
+    if (!QFile::rename(temp, file)) {
+        qCritical() << "Failed to move the backup into: " << file;
+        QFile::remove(temp);
+        return false;
+    }
 
-            temp += line;
+    return true;
+}
 
-            if (linedelimiterIndex > -1) {
-                result = result && sq->exec(temp.left(delimiterIndex));
-                temp = temp.remove(0, delimiterIndex + 1);
+#ifdef HEART_SQLITE_BACKUP_API
 
-                if (!result) {
-                    qCritical() << "Exec database error. File: " << sqlFile << " Line:" << lineNumber << sq->lastError().text();
-                    f.close();
-                    return false;
-                }
+/**
+ * @brief The SqliteBackUp class is state of the online backup of the sqlite database.
+ */
+class SqliteBackUp {
+public:
+    SqliteBackUp(SqlDBWriter* writer, const QString& file):
+        _writer(writer),
+        _file(file) {}
+
+    ~SqliteBackUp() {
+        finish();
+    }
+
+    bool start(const QVariant& handle) {
+        if (!handle.isValid() || qstrcmp(handle.typeName(), "sqlite3*") != 0) {
+            qCritical() << "Failed to backup database: the database driver is not a sqlite.";
+            return false;
+        }
+
+        auto source = *static_cast<sqlite3* const*>(handle.constData());
+        if (!source) {
+            return false;
+        }
+
+        if (sqlite3_open(backUpTempFile(_file).toUtf8().constData(), &_dest) != SQLITE_OK) {
+            qCritical() << "Failed to backup database: " << sqlite3_errmsg(_dest);
+            return false;
+        }
+
+        _backUp = sqlite3_backup_init(_dest, "main", source, "main");
+        if (!_backUp) {
+            qCritical() << "Failed to backup database: " << sqlite3_errmsg(_dest);
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief run This method copies database by steps. If @a wait is false then the next step will be invoked as a new job of the writer, so other queries do not wait for finish of the backup.
+     */
+    static bool run(const QSharedPointer<SqliteBackUp>& state, bool wait) {
+        do {
+            const int rc = sqlite3_backup_step(state->_backUp, DB_BACKUP_STEP_PAGES);
+
+            const int pages = sqlite3_backup_pagecount(state->_backUp);
+            const int progress = (pages)? 100 * (pages - sqlite3_backup_remaining(state->_backUp)) / pages : 100;
+            emit state->_writer->sigBackUpProgress(state->_file, progress);
+
+            if (rc == SQLITE_DONE) {
+                const bool result = state->finish() &&
+                                    replaceBackUp(backUpTempFile(state->_file), state->_file);
+                emit state->_writer->sigBackUpFinished(state->_file, result);
+                return result;
+            }
+
+            if (rc != SQLITE_OK && rc != SQLITE_BUSY && rc != SQLITE_LOCKED) {
+                qCritical() << "Failed to backup database: " << sqlite3_errstr(rc);
+                state->finish();
+                QFile::remove(backUpTempFile(state->_file));
+                emit state->_writer->sigBackUpFinished(state->_file, false);
+                return false;
             }
+        } while (wait);
+
+        // the asyncLauncher invokes job immediately on the own thread, so post the next step into the queue of the writer.
+        return QMetaObject::invokeMethod(state->_writer, [state]() {
+            run(state, false);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    bool finish() {
+        bool result = true;
+        if (_backUp) {
+            result = sqlite3_backup_finish(_backUp) == SQLITE_OK;
+            _backUp = nullptr;
+        }
+
+        if (_dest) {
+            sqlite3_close(_dest);
+            _dest = nullptr;
         }
 
-        f.close();
         return result;
     }
 
-    qCritical() << "sql source file is not open: " << sqlFile;
+    SqlDBWriter* _writer = nullptr;
+    QString _file;
+    sqlite3* _dest = nullptr;
+    sqlite3_backup* _backUp = nullptr;
+};
 
-    return false;
+#endif
+
+bool SqlDBWriter::exec(QSqlQuery *sq, const QString& sqlFile) const {
+    QFile f(sqlFile);
+    if (!f.open(QIODevice::ReadOnly)) {
+        qCritical() << "sql source file is not open: " << sqlFile;
+        return false;
+    }
+
+    const auto statements = SqlScript::parse(QString::fromUtf8(f.readAll()));
+    f.close();
+
+    const bool sqlite = _db && _db->driverName() == "QSQLITE";
+    const bool bulk = sqlite && _config.value(QH_DB_BULK_LOAD, false).toBool();
+
+    const bool canUseTransaction = _db && SqlScript::canRunInTransaction(statements) &&
+                                   _db->driver()->hasFeature(QSqlDriver::Transactions);
+
+    // all statements of the script executed in one transaction, so the sqlite do not sync the file after each statement.
+    // If transaction can not be opened (for example the script executed in the transaction of the database patch) then statements executed in the current transaction.
+    const bool transaction = canUseTransaction && _db->transaction();
+
+    // the synchronization is disabled only for own transaction, the outer transaction should be committed with the configured mode.
+    QVariant synchronous;
+    if (bulk && transaction) {
+        if (sq->exec("PRAGMA synchronous") && sq->next()) {
+            synchronous = sq->value(0);
+        }
+        sq->exec("PRAGMA synchronous = OFF");
+    }
+
+    auto restore = [&]() {
+        if (synchronous.isValid()) {
+            sq->exec(QString("PRAGMA synchronous = %0").arg(synchronous.toInt()));
+        }
+    };
+
+    for (const auto& statement: statements) {
+        if (!sq->exec(statement.text)) {
+            qCritical() << "Exec database error. File: " << sqlFile
+                        << " Line:" << statement.line
+                        << " Statement:" << statement.text
+                        << sq->lastError().text();
+
+            if (transaction) {
+                _db->rollback();
+            }
+
+            restore();
+            return false;
+        }
+    }
+
+    if (transaction && !_db->commit()) {
+        qCritical() << "Exec database error. File: " << sqlFile << " Failed to commit: " << _db->lastError().text();
+        _db->rollback();
+        restore();
+        return false;
+    }
+
+    restore();
+    return true;
 }
 
 bool SqlDBWriter::initDbPrivate(const QVariantMap &params) {
     _config = params;
 
+    _updateStatements.clear();
+
+    _slowQueryNsec = _config.value(QH_DB_SLOW_QUERY_MSEC, DB_SLOW_QUERY_MSEC).toLongLong() * 1000000;
+    _explainSlowQueries = _config.value(QH_DB_EXPLAIN_SLOW_QUERIES, false).toBool();
+
     if (_db)
         delete _db;
 
@@ -107,6 +257,8 @@ bool SqlDBWriter::initDbPrivate(const QVariantMap &params) {
         return false;
     }
 
+    applyConnectionSettings(*_db);
+
     for (const QString& sqlFile : std::as_const(_SQLSources)) {
         QSqlQuery query(*_db);
         if (!exec(&query, sqlFile)) {
@@ -144,13 +296,13 @@ bool SqlDBWriter::doQueryPrivate(const QString &query, const QVariantMap &bindVa
             q.bindValue(it.key(), it.value());
         }
 
-        if (!q.exec()) {
+        if (!execQuery(q)) {
             qCritical() << "execute error : " << q.lastError().text();
 
             return false;
         }
     } else {
-        if (!q.exec(query)) {
+        if (!execQuery(q, query)) {
             qCritical() << "bind values error : " << q.lastError().text();
 
             return false;
@@ -165,6 +317,76 @@ bool SqlDBWriter::doQueryPrivate(const QString &query, const QVariantMap &bindVa
 
 }
 
+bool SqlDBWriter::execQuery(QSqlQuery &q, const QString &query) const {
+    QElapsedTimer timer;
+    timer.start();
+
+    const bool result = (query.isEmpty())? q.exec(): q.exec(query);
+    const qint64 nsec = timer.nsecsElapsed();
+
+    // rows of the select queries are counted while reading of the result.
+    _statistics.record(q.lastQuery(), nsec, (result && !q.isSelect())? q.numRowsAffected(): -1);
+
+    if (result && _slowQueryNsec >= 0 && nsec >= _slowQueryNsec) {
+        printSlowQuery(q, nsec);
+    }
+
+    return result;
+}
+
+void SqlDBWriter::printSlowQuery(const QSqlQuery &q, qint64 nsec) const {
+    qWarning() << "Slow query" << nsec / 1000000.0 << "msec:" << q.lastQuery()
+               << "bound values:" << q.boundValues();
+
+    if (!_explainSlowQueries || !db() || db()->driverName() != "QSQLITE") {
+        return;
+    }
+
+    QSqlQuery explain(*db());
+    bool prepared = explain.prepare("EXPLAIN QUERY PLAN " + q.lastQuery());
+
+    const int count = q.boundValues().size();
+    for (int i = 0; prepared && i < count; ++i) {
+        explain.bindValue(i, q.boundValue(i));
+    }
+
+    if (!prepared || !explain.exec()) {
+        qWarning() << "Failed to explain the slow query: " << explain.lastError().text();
+        return;
+    }
+
+    const int detail = explain.record().indexOf("detail");
+    QStringList plan;
+    while (explain.next()) {
+        plan.push_back(explain.value((detail >= 0)? detail: explain.record().count() - 1).toString());
+    }
+
+    qWarning() << "Query plan:" << plan;
+}
+
+bool SqlDBWriter::isSqliteVersion(int major, int minor) const {
+    if (!db() || db()->driverName() != "QSQLITE") {
+        return false;
+    }
+
+    if (_sqliteVersion.isNull()) {
+        QSqlQuery query(*db());
+        if (query.exec("SELECT sqlite_version()") && query.next()) {
+            _sqliteVersion = QVersionNumber::fromString(query.value(0).toString());
+        }
+    }
+
+    return _sqliteVersion >= QVersionNumber(major, minor);
+}
+
+QList<SqlStatementStats> SqlDBWriter::statistics() const {
+    return _statistics.statistics();
+}
+
+void SqlDBWriter::resetStatistics() {
+    _statistics.reset();
+}
+
 bool SqlDBWriter::doSqlPrivate(const QString &sqlFile) const {
     QSqlQuery query(*_db);
     if (!exec(&query, sqlFile)) {
@@ -242,6 +464,79 @@ QSqlDatabase SqlDBWriter::initSqlDataBasse(const QString& driverName,
                                      QFileInfo(name).fileName());
 }
 
+bool SqlDBWriter::applyConnectionSettings(QSqlDatabase &connection) const {
+    if (connection.driverName() != "QSQLITE") {
+        return true;
+    }
+
+    auto pragmas = performanceProfile(_config.value(QH_DB_PROFILE).toString());
+
+    const auto custom = _config.value(QH_DB_PRAGMAS).toMap();
+    for (auto it = custom.cbegin(); it != custom.cend(); ++it) {
+        pragmas.push_back({it.key(), it.value()});
+    }
+
+    static const QRegularExpression validName("^[A-Za-z_]+$");
+    static const QRegularExpression validValue("^-?[A-Za-z0-9_]+$");
+
+    bool result = true;
+    QSqlQuery query(connection);
+    for (const auto& pragma: std::as_const(pragmas)) {
+        const QString value = pragma.second.toString();
+        if (!validName.match(pragma.first).hasMatch() || !validValue.match(value).hasMatch()) {
+            qWarning() << "Invalid database pragma: " << pragma.first << " = " << value;
+            result = false;
+            continue;
+        }
+
+        if (!query.exec(QString("PRAGMA %0 = %1").arg(pragma.first, value))) {
+            qWarning() << "Failed to set database pragma: " << pragma.first << " = " << value << query.lastError().text();
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+QList<QPair<QString, QVariant>> SqlDBWriter::performanceProfile(const QString &name) {
+    if (name == "durable") {
+        return {
+            {"journal_mode", "DELETE"},
+            {"synchronous", "FULL"},
+            {"busy_timeout", 5000},
+            {"temp_store", "DEFAULT"}
+        };
+    }
+
+    if (name == "balanced") {
+        return {
+            {"journal_mode", "WAL"},
+            {"synchronous", "NORMAL"},
+            {"busy_timeout", 5000},
+            {"temp_store", "MEMORY"},
+            {"cache_size", -16384},         // 16 MB
+            {"mmap_size", 67108864}         // 64 MB
+        };
+    }
+
+    if (name == "throughput") {
+        return {
+            {"journal_mode", "WAL"},
+            {"synchronous", "OFF"},
+            {"busy_timeout", 5000},
+            {"temp_store", "MEMORY"},
+            {"cache_size", -65536},         // 64 MB
+            {"mmap_size", 268435456}        // 256 MB
+        };
+    }
+
+    if (!name.isEmpty()) {
+        qWarning() << "Unknown database performance profile: " << name;
+    }
+
+    return {};
+}
+
 QSqlDatabase *SqlDBWriter::db() {
     return _db;
 }
@@ -311,7 +606,6 @@ bool SqlDBWriter::insertObject(const QSharedPointer<DBObject> &ptr,
                                const QWeakPointer<unsigned int>& autoincrementIdResult) {
 
     if (wait) {
-        auto resultId = QSharedPointer<int>::create();
         Async::Job job = [this, ptr, autoincrementIdResult]() {
             return insertQuery(ptr, autoincrementIdResult);
         };
@@ -334,6 +628,32 @@ bool SqlDBWriter::replaceObject(const QSharedPointer<PKG::DBObject> &ptr, bool w
     return asyncLauncher(job, wait);
 }
 
+bool SqlDBWriter::upsertObject(const QSharedPointer<DBObject> &ptr, bool wait) {
+    Async::Job job = [this, ptr]() {
+        return upsertQuery(ptr);
+    };
+
+    return asyncLauncher(job, wait);
+}
+
+bool SqlDBWriter::insertObjects(const QList<QSharedPointer<DBObject>> &objects,
+                                bool wait,
+                                const QWeakPointer<QList<unsigned int>> &autoincrementIdsResult) {
+    Async::Job job = [this, objects, autoincrementIdsResult]() {
+        return insertQueries(objects, false, autoincrementIdsResult);
+    };
+
+    return asyncLauncher(job, wait);
+}
+
+bool SqlDBWriter::replaceObjects(const QList<QSharedPointer<DBObject>> &objects, bool wait) {
+    Async::Job job = [this, objects]() {
+        return insertQueries(objects, true);
+    };
+
+    return asyncLauncher(job, wait);
+}
+
 void SqlDBWriter::setSQLSources(const QStringList &list) {
     _SQLSources = list;
 }
@@ -345,7 +665,58 @@ QString SqlDBWriter::databaseLocation() const {
     return db()->databaseName();
 }
 
+bool SqlDBWriter::backUp(const QString &file, bool wait) {
+    if (file.isEmpty()) {
+        return false;
+    }
+
+    auto job = [this, file, wait]() {
+        if (!db() || db()->driverName() != "QSQLITE") {
+            emit sigBackUpFinished(file, false);
+            return false;
+        }
+
+        if (!QDir().mkpath(QFileInfo(file).absolutePath())) {
+            emit sigBackUpFinished(file, false);
+            return false;
+        }
+
+        // remove the temporary file of the previous failed backup.
+        const QString temp = backUpTempFile(file);
+        QFile::remove(temp);
+
+#ifdef HEART_SQLITE_BACKUP_API
+        auto state = QSharedPointer<SqliteBackUp>::create(this, file);
+        if (!state->start(db()->driver()->handle())) {
+            state.reset();
+            QFile::remove(temp);
+            emit sigBackUpFinished(file, false);
+            return false;
+        }
+
+        return SqliteBackUp::run(state, wait);
+#else
+        // VACUUM INTO reads a consistent snapshot of the database, so the concurrent transactions can not broke the backup.
+        // The query works on the writer thread, so all other queries wait for the end of the backup.
+        bool result = doQueryPrivate("VACUUM INTO :file", {{":file", temp}}, nullptr);
+        if (result) {
+            result = replaceBackUp(temp, file);
+        } else {
+            QFile::remove(temp);
+        }
+
+        emit sigBackUpProgress(file, 100);
+        emit sigBackUpFinished(file, result);
+        return result;
+#endif
+    };
+
+    return asyncLauncher(job, wait);
+}
+
 SqlDBWriter::~SqlDBWriter() {
+    _updateStatements.clear();
+
     if (_db) {
         _db->close();
 
@@ -370,20 +741,28 @@ bool SqlDBWriter::insertQuery(const QSharedPointer<DBObject> &ptr,
 
     QSqlQuery q(*db());
 
-    auto prepare = [ptr](QSqlQuery&q) {
-        return ptr->prepareInsertQuery(q, false);
+    QSet<QString> written;
+    auto prepare = [ptr, &written](QSqlQuery&q) {
+        return ptr->prepareAndTakeDirtyFields([ptr, &q]() {
+            return ptr->prepareInsertQuery(q, false);
+        }, &written);
     };
 
     auto cb = [&q, autoincrementIdResult]() {
 
-        if (auto&& ptr = autoincrementIdResult.lock()) {
-            *ptr = q.lastInsertId().toInt();
+        if (auto&& id = autoincrementIdResult.lock()) {
+            *id = q.lastInsertId().toInt();
         }
 
         return true;
     };
 
-    return workWithQuery(q, prepare, cb);
+    if (!workWithQuery(q, prepare, cb)) {
+        ptr->restoreDirtyFields(written);
+        return false;
+    }
+
+    return true;
 }
 
 bool SqlDBWriter::replaceQuery(const QSharedPointer<PKG::DBObject> &ptr) const {
@@ -405,6 +784,198 @@ bool SqlDBWriter::replaceQuery(const QSharedPointer<PKG::DBObject> &ptr) const {
     return workWithQuery(q, prepare, cb);
 }
 
+bool SqlDBWriter::upsertQuery(const QSharedPointer<DBObject> &ptr) const {
+    if (!ptr)
+        return false;
+
+    if (!db()) {
+        return false;
+    }
+
+    QSqlQuery q(*db());
+
+    // the ON CONFLICT clause is supported since sqlite 3.24, older versions use the replace query.
+    const bool upsert = db()->driverName() != "QSQLITE" || isSqliteVersion(3, 24);
+
+    QSet<QString> written;
+    auto prepare = [ptr, upsert, &written](QSqlQuery&q) {
+        return ptr->prepareAndTakeDirtyFields([ptr, upsert, &q]() {
+            if (!upsert) {
+                return ptr->prepareInsertQuery(q, true);
+            }
+
+            return ptr->prepareUpsertQuery(q);
+        }, &written);
+    };
+
+    auto cb = []() {
+        return true;
+    };
+
+    if (!workWithQuery(q, prepare, cb)) {
+        ptr->restoreDirtyFields(written);
+        return false;
+    }
+
+    return true;
+}
+
+bool SqlDBWriter::insertQueries(const QList<QSharedPointer<DBObject>> &objects,
+                                bool replace,
+                                const QWeakPointer<QList<unsigned int>> &autoIncrementIDs) const {
+    if (!db()) {
+        return false;
+    }
+
+    if (objects.isEmpty()) {
+        return true;
+    }
+
+    if (!objects.first()) {
+        return false;
+    }
+
+    const QString table = objects.first()->table();
+
+    // all objects have same fields, so the columns are taken from the first object.
+    QStringList columns;
+    const DBVariantMap firstMap = objects.first()->variantMap();
+    for (auto it = firstMap.begin(); it != firstMap.end(); ++it) {
+        if (!static_cast<bool>(it.value().type & MemberType::Insert)) {
+            continue;
+        }
+
+        if (static_cast<bool>(it.value().type & MemberType::Autoincement) && !replace) {
+            continue;
+        }
+
+        columns.push_back(it.key());
+    }
+
+    if (columns.isEmpty()) {
+        qCritical() << "The variantMap method return an empty map. Table: " << table;
+        return false;
+    }
+
+    QList<QVariantList> rows;
+    QList<QSet<QString>> written;
+    rows.reserve(objects.size());
+    written.reserve(objects.size());
+
+    // returns the changed fields of the objects if the objects are not saved.
+    auto restore = [&]() {
+        for (int i = 0; i < written.size(); ++i) {
+            objects[i]->restoreDirtyFields(written[i]);
+        }
+    };
+
+    for (const auto& object: objects) {
+        if (!object || object->table() != table) {
+            qCritical() << "The insertObjects method supports only objects of the same type. Table: " << table;
+            restore();
+            return false;
+        }
+
+        // the changed fields are taken together with values, like the single insert query do it.
+        QVariantList row;
+        QSet<QString> taken;
+        const auto prepared = object->prepareAndTakeDirtyFields([&object, &columns, &row]() {
+            const DBVariantMap map = object->variantMap();
+            row.reserve(columns.size());
+            for (const auto& column: std::as_const(columns)) {
+                auto value = map.find(column);
+                if (value == map.end()) {
+                    qCritical() << "The object do not contains the field " << column << object->toString();
+                    return PrepareResult::Fail;
+                }
+
+                row.push_back(value->value);
+            }
+
+            return PrepareResult::Success;
+        }, &taken);
+
+        if (prepared != PrepareResult::Success) {
+            restore();
+            return false;
+        }
+
+        rows.push_back(row);
+        written.push_back(taken);
+    }
+
+    auto ids = autoIncrementIDs.lock();
+    const bool needIds = ids && !replace;
+    QSqlQuery q(*_db);
+
+    if (needIds) {
+        ids->clear();
+    }
+
+    // the order of the rows returned by the RETURNING clause is not specified,
+    // so the objects are inserted one by one and the id of each object is read by the lastInsertId method.
+    const int maxRows = (needIds)? 1 : std::max(1, static_cast<int>(DB_BULK_MAX_PARAMETERS / columns.size()));
+
+    const QString rowTemplate = "(" + QString("?, ").repeated(columns.size() - 1) + "?)";
+
+    auto statement = [&](int count) {
+        QStringList values;
+        values.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            values.push_back(rowTemplate);
+        }
+
+        return QString("%0 INTO %1 (%2) VALUES %3").
+               arg(replace? "REPLACE" : "INSERT", table, columns.join(", "), values.join(", "));
+    };
+
+    const bool transaction = _db->transaction();
+    auto fail = [&](const QString& error) {
+        qCritical() << "Bulk insert error. Table: " << table << error;
+        if (transaction) {
+            _db->rollback();
+        }
+
+        restore();
+        return false;
+    };
+
+    int preparedRows = 0;
+    for (int begin = 0; begin < rows.size(); begin += maxRows) {
+        const int count = std::min(maxRows, static_cast<int>(rows.size()) - begin);
+
+        // all full chunks use the same prepared statement.
+        if (count != preparedRows) {
+            if (!q.prepare(statement(count))) {
+                return fail(q.lastError().text());
+            }
+
+            preparedRows = count;
+        }
+
+        int index = 0;
+        for (int row = begin; row < begin + count; ++row) {
+            for (const auto& value: std::as_const(rows[row])) {
+                q.bindValue(index++, value);
+            }
+        }
+
+        if (!execQuery(q)) {
+            return fail(q.lastError().text());
+        }
+
+        if (needIds) {
+            ids->push_back(q.lastInsertId().toUInt());
+        }
+    }
+
+    if (transaction && !_db->commit()) {
+        return fail(_db->lastError().text());
+    }
+
+    return true;
+}
+
 bool SqlDBWriter::doQuery(const QString &query, const QVariantMap &bindValues,
                           bool wait, QSqlQuery* result) const {
 
@@ -427,6 +998,88 @@ bool SqlDBWriter::doSql(const QString &sqlFile, bool wait) const {
 
 }
 
+QFuture<QList<QSharedPointer<DBObject>>>
+SqlDBWriter::getAllObjectsAsync(const QSharedPointer<DBObject> &templateObject) {
+    if (!templateObject) {
+        return Promise<QList<QSharedPointer<DBObject>>>().future();
+    }
+
+    return asyncFuture<QList<QSharedPointer<DBObject>>>([this, templateObject](QList<QSharedPointer<DBObject>>& result) {
+        return selectQuery(*templateObject, result);
+    });
+}
+
+QFuture<QSharedPointer<DBObject>>
+SqlDBWriter::getObjectAsync(const QSharedPointer<DBObject> &templateObject) {
+    if (!templateObject) {
+        return Futures::ready(QSharedPointer<DBObject>{});
+    }
+
+    return asyncFuture<QSharedPointer<DBObject>>([this, templateObject](QSharedPointer<DBObject>& result) {
+        QList<QSharedPointer<DBObject>> list;
+        if (selectQuery(*templateObject, list) && list.size()) {
+            result = list.first();
+        }
+
+        // object not exists is not error for the getObject method.
+        return true;
+    });
+}
+
+QFuture<bool> SqlDBWriter::updateObjectAsync(const QSharedPointer<DBObject> &saveObject) {
+    return asyncFuture([this, saveObject]() {
+        return updateQuery(saveObject);
+    });
+}
+
+QFuture<bool> SqlDBWriter::replaceObjectAsync(const QSharedPointer<DBObject> &saveObject) {
+    return asyncFuture([this, saveObject]() {
+        return replaceQuery(saveObject);
+    });
+}
+
+QFuture<bool> SqlDBWriter::insertObjectAsync(const QSharedPointer<DBObject> &saveObject,
+                                             const QWeakPointer<unsigned int> &autoincrementIdResult) {
+    return asyncFuture([this, saveObject, autoincrementIdResult]() {
+        return insertQuery(saveObject, autoincrementIdResult);
+    });
+}
+
+QFuture<bool> SqlDBWriter::deleteObjectAsync(const QSharedPointer<DBObject> &obj) {
+    return asyncFuture([this, obj]() {
+        return deleteQuery(obj);
+    });
+}
+
+QFuture<QList<QSqlRecord>> SqlDBWriter::doQueryAsync(const QString &query, const QVariantMap &bindValues) const {
+    return asyncFuture<QList<QSqlRecord>>([this, query, bindValues](QList<QSqlRecord>& result) {
+        QSqlQuery q;
+        if (!doQueryPrivate(query, bindValues, &q)) {
+            return false;
+        }
+
+        // the QSqlQuery can not be used out of the working thread, so all records are copied here.
+        while (q.next()) {
+            result.push_back(q.record());
+        }
+
+        _statistics.addRows(q.lastQuery(), result.size());
+
+        return true;
+    });
+}
+
+QFuture<bool> SqlDBWriter::asyncFuture(const Job &job) const {
+    auto promise = QSharedPointer<Promise<bool>>::create();
+    auto future = promise->future();
+
+    QMetaObject::invokeMethod(const_cast<SqlDBWriter*>(this), [promise, job]() {
+        promise->setResult(job());
+    }, Qt::QueuedConnection);
+
+    return future;
+}
+
 bool SqlDBWriter::selectQuery(const DBObject& requestObject,
                               QList<QSharedPointer<QH::PKG::DBObject>> &result) {
 
@@ -439,7 +1092,7 @@ bool SqlDBWriter::selectQuery(const DBObject& requestObject,
         return requestObject.prepareSelectQuery(q);
     };
 
-    auto cb = [&q, &requestObject, &result]() -> bool {
+    auto cb = [this, &q, &requestObject, &result]() -> bool {
 
         if (requestObject.isBundle()) {
             auto newObject = QSharedPointer<QH::PKG::DBObject>(requestObject.createDBObject());
@@ -447,7 +1100,9 @@ bool SqlDBWriter::selectQuery(const DBObject& requestObject,
             if (!newObject)
                 return false;
 
+            int rows = 0;
             while (q.next()) {
+                ++rows;
                 if (!newObject->fromSqlRecord(q.record())) {
                     qCritical() << "Select query finished successful but, "
                                    "the fromSqlRecord method return false." << newObject->toString();
@@ -455,9 +1110,12 @@ bool SqlDBWriter::selectQuery(const DBObject& requestObject,
                 }
             }
 
+            newObject->clearDirtyFields();
             result.push_back(newObject);
+            _statistics.addRows(q.lastQuery(), rows);
 
         } else {
+            const int begin = result.size();
             while (q.next()) {
                 auto newObject = QSharedPointer<QH::PKG::DBObject>(requestObject.createDBObject());
 
@@ -468,9 +1126,13 @@ bool SqlDBWriter::selectQuery(const DBObject& requestObject,
                     qCritical() << "Init sql object error.";
                     return false;
                 }
+
+                // setters invoked in the fromSqlRecord method mark fields as changed.
+                newObject->clearDirtyFields();
                 result.push_back(newObject);
             }
 
+            _statistics.addRows(q.lastQuery(), result.size() - begin);
             return true;
         }
 
@@ -502,15 +1164,44 @@ bool SqlDBWriter::updateQuery(const QSharedPointer<DBObject> &ptr) const {
     if (!ptr)
         return false;
 
-    QSqlQuery q(*db());
+    if (!db()) {
+        return false;
+    }
 
-    auto prepare = [ptr](QSqlQuery&q) {
-        return ptr->prepareUpdateQuery(q);
+    // objects that change the same fields of the same table use the same statement, so it is prepared only once.
+    QStringList fields = ptr->dirtyFields().values();
+    fields.sort();
+    const QString key = ptr->table() + ":" + fields.join(",");
+
+    auto statement = _updateStatements.find(key);
+    if (statement == _updateStatements.end()) {
+        if (_updateStatements.size() >= DB_UPDATE_STATEMENTS_CACHE) {
+            _updateStatements.clear();
+        }
+
+        statement = _updateStatements.insert(key, QSqlQuery(*db()));
+    }
+
+    QSqlQuery& q = statement.value();
+
+    // fields changed while the query is in the queue or executed stay dirty and will be written by the next update.
+    QSet<QString> written;
+    auto prepare = [ptr, &written](QSqlQuery&q) {
+        return ptr->prepareAndTakeDirtyFields([ptr, &q]() {
+            return ptr->prepareUpdateQuery(q);
+        }, &written);
     };
 
-    auto cb = [](){return true;};
+    auto cb = []() {
+        return true;
+    };
 
-    return workWithQuery(q, prepare, cb);
+    if (!workWithQuery(q, prepare, cb)) {
+        ptr->restoreDirtyFields(written);
+        return false;
+    }
+
+    return true;
 }
 
 bool SqlDBWriter::workWithQuery(QSqlQuery &q,
@@ -529,7 +1220,7 @@ bool SqlDBWriter::workWithQuery(QSqlQuery &q,
     switch (prepareFunc(q)) {
     case PrepareResult::Success: {
 
-        if (!q.exec()) {
+        if (!execQuery(q)) {
             printError(q);
             return false;
         }
@@ -537,7 +1228,7 @@ bool SqlDBWriter::workWithQuery(QSqlQuery &q,
 #ifdef HEART_PRINT_SQL_QUERIES
         qDebug() << QString("Query executed successfull into %0\n"
                             "query: %1").
-                    arg(_db->databaseName(), q.executedQuery();
+                    arg(_db->databaseName(), q.executedQuery());
 #endif
 
         return cb();
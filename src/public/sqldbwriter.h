@@ -12,10 +12,14 @@
 #include <QSqlDatabase>
 #include <QDir>
 #include <QSqlQuery>
+#include <QHash>
+#include <QVersionNumber>
 #include "async.h"
 #include "heart_global.h"
 #include "config.h"
 #include "iobjectprovider.h"
+#include "futures.h"
+#include "sqlstatistics.h"
 #include <QVariant>
 #include <QCoreApplication>
 #include <dbobject.h>
@@ -70,11 +74,55 @@ public:
     bool insertObject(const QSharedPointer<PKG::DBObject> &ptr, bool wait = false,
                       const QWeakPointer<unsigned int>& autoincrementIdResult = {}) override;
     bool replaceObject(const QSharedPointer<PKG::DBObject> &ptr, bool wait = false) override;
+    bool upsertObject(const QSharedPointer<PKG::DBObject> &ptr, bool wait = false) override;
+    bool insertObjects(const QList<QSharedPointer<PKG::DBObject>>& objects, bool wait = false,
+                       const QWeakPointer<QList<unsigned int>>& autoincrementIdsResult = {}) override;
+    bool replaceObjects(const QList<QSharedPointer<PKG::DBObject>>& objects, bool wait = false) override;
 
     void setSQLSources(const QStringList &list) override;
     bool doQuery(const QString& query, const QVariantMap& bindValues = {}, bool wait = false, QSqlQuery *result = nullptr) const override;
     bool doSql(const QString &sqlFile, bool wait) const override;
 
+    QFuture<QList<QSharedPointer<PKG::DBObject>>>
+    getAllObjectsAsync(const QSharedPointer<PKG::DBObject>& templateObject) override;
+    QFuture<QSharedPointer<PKG::DBObject>>
+    getObjectAsync(const QSharedPointer<PKG::DBObject>& templateObject) override;
+    QFuture<bool> updateObjectAsync(const QSharedPointer<PKG::DBObject>& saveObject) override;
+    QFuture<bool> replaceObjectAsync(const QSharedPointer<PKG::DBObject>& saveObject) override;
+    QFuture<bool> insertObjectAsync(const QSharedPointer<PKG::DBObject>& saveObject,
+                                    const QWeakPointer<unsigned int>& autoincrementIdResult = {}) override;
+    QFuture<bool> deleteObjectAsync(const QSharedPointer<PKG::DBObject>& obj) override;
+    QFuture<QList<QSqlRecord>> doQueryAsync(const QString& query, const QVariantMap& bindValues = {}) const override;
+
+    /**
+     * @brief asyncFuture This method puts the @a job into the queue of the working thread and return future of the job result.
+     *  Unlike the asyncLauncher method this method never blocks the current thread.
+     *  Use it for composing of the several queries into one job of the working thread.
+     * @param job This is function that fill the result and return true if finished successful. If the job failed then the future will be canceled.
+     * @return future of the job result.
+     */
+    template<class T>
+    QFuture<T> asyncFuture(const std::function<bool(T&)>& job) const {
+        auto promise = QSharedPointer<Promise<T>>::create();
+        auto future = promise->future();
+
+        QMetaObject::invokeMethod(const_cast<SqlDBWriter*>(this), [promise, job]() {
+            T result{};
+            if (job(result)) {
+                promise->setResult(result);
+            }
+        }, Qt::QueuedConnection);
+
+        return future;
+    }
+
+    /**
+     * @brief asyncFuture This is overload for jobs that returns only boolean status. The status is result of the future.
+     * @param job This is function of the work.
+     * @return future of the job result.
+     */
+    QFuture<bool> asyncFuture(const Async::Job& job) const;
+
     /**
      * @brief databaseLocation This method return location of database.
      * If it is sqlite then return path to db file else return database name.
@@ -82,6 +130,53 @@ public:
      */
     QString databaseLocation() const;
 
+    /**
+     * @brief backUp This method makes online backup of the sqlite database into the @a file. The backup works on the thread of this object and do not stops other readers.
+     *  If the library built with the HEART_SQLITE_BACKUP_API option then the backup uses the sqlite online backup api and copies database by steps (see DB_BACKUP_STEP_PAGES),
+     *  between steps the writer thread executes other queries. Else the backup uses the "VACUUM INTO" query (sqlite 3.27 or later).
+     *  The backup is written into the temporary file "<file>.tmp", that replaces the old backup only after success.
+     * @warning Without the HEART_SQLITE_BACKUP_API option the backup blocks the writer thread, so all queries of this writer wait until the whole database is copied.
+     *  Use the HEART_SQLITE_BACKUP_API option for big databases.
+     * @param file This is path to the result file. If the file already exists then it will be overwritten after successful backup.
+     * @param wait This option disable steps, and wait for finish of the backup.
+     * @return true if backup started successful (finished if the @a wait is true).
+     * @note This method works only with the QSQLITE driver.
+     * @see SqlDBWriter::sigBackUpProgress
+     * @see SqlDBWriter::sigBackUpFinished
+     */
+    bool backUp(const QString& file, bool wait = false);
+
+    /**
+     * @brief performanceProfile This method return list of the sqlite pragmas of the performance profile with @a name.
+     *
+     * Available profiles:
+     * - durable - default rollback journal with full synchronization, the database survives power loss (default).
+     * - balanced - WAL journal with normal synchronization, bigger cache and memory mapping. Transactions can be lost only after power loss.
+     * - throughput - WAL journal without synchronization, big cache and memory mapping. Use it for caches and data that can be restored.
+     *
+     * @note The WAL journal is saved in the database file, so the balanced and throughput profiles convert existing databases to the WAL mode.
+     *  Old versions of sqlite and read only file systems can not open such databases.
+     *
+     * @param name This is name of the profile.
+     * @return list of pragmas (name and value) in the order of applying. If profile not found return empty list.
+     * @see QH_DB_PROFILE
+     */
+    static QList<QPair<QString, QVariant>> performanceProfile(const QString& name);
+
+    /**
+     * @brief statistics This method return execution statistics of the all sql statements of this writer sorted by the total execution time.
+     *  Statistics are collected always, use it for finding of the queries that need indexes or changes of the objects.
+     *  Queries that executed longer then QH_DB_SLOW_QUERY_MSEC are printed into log with bound values.
+     * @return list of the statements statistics.
+     * @see SqlStatistics
+     */
+    QList<SqlStatementStats> statistics() const;
+
+    /**
+     * @brief resetStatistics This method removes all collected statistics of the sql statements.
+     */
+    void resetStatistics();
+
     virtual ~SqlDBWriter() override;
 
     /**
@@ -125,6 +220,44 @@ public:
      * @note This method generate query for replace objects in the database.
      */
     virtual bool replaceQuery(const QSharedPointer<QH::PKG::DBObject>& insertObject) const;
+
+    /**
+     * @brief upsertQuery This method prepare the upsert object query.
+     * @param insertObject This is strong pointer of object for generate the upsert query.
+     * @return true if query generated successful.
+     * @see DBObject::prepareUpsertQuery
+     */
+    virtual bool upsertQuery(const QSharedPointer<QH::PKG::DBObject>& insertObject) const;
+
+    /**
+     * @brief insertQueries This method inserts or replaces the list of same type @a objects in one transaction.
+     *  Objects are written by the multi-row statements, each statement contains no more then DB_BULK_MAX_PARAMETERS bound values.
+     * @param objects This is list of objects.
+     * @param replace This option generates the replace query instead of insert.
+     * @param autoIncrementIDs Week pointer to result list of ids of the new records (insert only).
+     *  If ids are requested then the objects are inserted one by one in the same transaction, because the order of the rows returned by the RETURNING clause is not specified.
+     * @return true if all objects saved successful.
+     * @note The changed fields of the objects are cleared like after the single insert query, and are returned back if the transaction failed.
+     */
+    virtual bool insertQueries(const QList<QSharedPointer<QH::PKG::DBObject>>& objects,
+                               bool replace,
+                               const QWeakPointer<QList<unsigned int>>& autoIncrementIDs = {}) const;
+
+signals:
+    /**
+     * @brief sigBackUpProgress This signal emitted after each step of the backup.
+     * @param file This is path to file of backup.
+     * @param progress This is progress of backup in percents.
+     */
+    void sigBackUpProgress(const QString& file, int progress);
+
+    /**
+     * @brief sigBackUpFinished This signal emitted when backup finished.
+     * @param file This is path to file of backup.
+     * @param success This is result of backup.
+     */
+    void sigBackUpFinished(const QString& file, bool success);
+
 protected slots:
 
 
@@ -175,6 +308,11 @@ protected:
      * - DBHost - This is host address of a remote database. Or (QH_DB_HOST)
      * - DBPort - port of a remote database. or (QH_DB_PORT)
      * - DBBackUpPath - path of database backups (sqlite only). Or (QH_DB_BACKUP_PATH)
+     * - DBBulkLoad - disables synchronous mode of sqlite while sql files are executed (sqlite only). Or (QH_DB_BULK_LOAD)
+     * - DBProfile - name of the performance profile of sqlite database (durable, balanced or throughput), see the SqlDBWriter::performanceProfile method. Or (QH_DB_PROFILE)
+     * - DBPragmas - map of the custom sqlite pragmas that will be applied after profile, for example {"cache_size": -32000}. Or (QH_DB_PRAGMAS)
+     * - DBSlowQueryMsec - queries executed longer then this time (in milliseconds) are printed into log, use -1 for disable it (default DB_SLOW_QUERY_MSEC). Or (QH_DB_SLOW_QUERY_MSEC)
+     * - DBExplainSlowQueries - prints the query plan of the slow queries (sqlite only). Or (QH_DB_EXPLAIN_SLOW_QUERIES)
 
      */
     virtual QVariantMap defaultInitPararm() const;
@@ -203,8 +341,17 @@ protected:
      */
     const QSqlDatabase* db() const;
 
+    /**
+     * @brief applyConnectionSettings This method applies the performance profile and custom pragmas (see QH_DB_PROFILE and QH_DB_PRAGMAS) to the @a connection.
+     *  Invoke this method for each new connection to the database.
+     * @param connection This is opened connection to the database.
+     * @return true if all settings applied successful.
+     */
+    virtual bool applyConnectionSettings(QSqlDatabase& connection) const;
+
 private:
 
+
     /**
      * @brief workWithQuery - this base function for all prepareQuery functions.
      * steps work : call prepareFunc, call exec , call cb.
@@ -238,11 +385,37 @@ private:
 
     bool doSqlPrivate(const QString &sqlFile) const;
 
+    /**
+     * @brief execQuery This method executes the @a q and saves the execution time into the statistics.
+     * @param q This is prepared query.
+     * @param query This is text of not prepared query. If it is empty then the prepared query will be executed.
+     * @return true if query executed successful.
+     */
+    bool execQuery(QSqlQuery &q, const QString& query = {}) const;
+    void printSlowQuery(const QSqlQuery &q, qint64 nsec) const;
+
+    /**
+     * @brief isSqliteVersion This method checks that the database is sqlite with version @a major.@a minor or newer.
+     * @param major This is major version of the sqlite.
+     * @param minor This is minor version of the sqlite.
+     * @return true if the database is sqlite and version is not less then required.
+     */
+    bool isSqliteVersion(int major, int minor) const;
+
     bool initSuccessful = false;
     QVariantMap _config;
     QStringList _SQLSources;
 
-    QSqlDatabase *_db = nullptr;    
+    QSqlDatabase *_db = nullptr;
+
+    // prepared update statements, key is table and list of the changed fields.
+    mutable QHash<QString, QSqlQuery> _updateStatements;
+
+    mutable SqlStatistics _statistics;
+    // version of the sqlite library, read on first use.
+    mutable QVersionNumber _sqliteVersion;
+    qint64 _slowQueryNsec = DB_SLOW_QUERY_MSEC * 1000000ll;
+    bool _explainSlowQueries = false;
 };
 
 }
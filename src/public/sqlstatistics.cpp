@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#include "sqlstatistics.h"
+#include "config.h"
+
+#include <QRegularExpression>
+#include <algorithm>
+#include <cmath>
+
+namespace QH {
+
+SqlStatistics::SqlStatistics() {
+
+}
+
+void SqlStatistics::record(const QString &query, qint64 nsec, int rows) {
+    QMutexLocker locker(&_mutex);
+    Entry& item = entry(query);
+
+    item.count++;
+    item.totalNsec += nsec;
+    item.maxNsec = std::max(item.maxNsec, nsec);
+    item.buckets[bucket(nsec)]++;
+
+    if (rows > 0) {
+        item.rows += rows;
+    }
+}
+
+void SqlStatistics::addRows(const QString &query, int rows) {
+    if (rows <= 0) {
+        return;
+    }
+
+    QMutexLocker locker(&_mutex);
+    entry(query).rows += rows;
+}
+
+QList<SqlStatementStats> SqlStatistics::statistics() const {
+    QList<SqlStatementStats> result;
+
+    {
+        QMutexLocker locker(&_mutex);
+        result.reserve(_entries.size());
+
+        for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+            const Entry& item = it.value();
+            if (!item.count) {
+                continue;
+            }
+
+            SqlStatementStats stats;
+            stats.statement = it.key();
+            stats.count = item.count;
+            stats.totalMsec = item.totalNsec / 1000000.0;
+            stats.avgMsec = stats.totalMsec / item.count;
+            stats.maxMsec = item.maxNsec / 1000000.0;
+            stats.rows = item.rows;
+
+            const quint64 p99Count = (item.count * 99 + 99) / 100;
+            quint64 count = 0;
+            for (int i = 0; i < BucketsCount; ++i) {
+                count += item.buckets[i];
+                if (count >= p99Count) {
+                    stats.p99Msec = std::min(std::pow(2.0, i / 4.0) / 1000.0, stats.maxMsec);
+                    break;
+                }
+            }
+
+            result.push_back(stats);
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const SqlStatementStats& left, const SqlStatementStats& right) {
+        return left.totalMsec > right.totalMsec;
+    });
+
+    return result;
+}
+
+void SqlStatistics::reset() {
+    QMutexLocker locker(&_mutex);
+    _entries.clear();
+    _normalized.clear();
+}
+
+QString SqlStatistics::normalize(const QString &query) {
+    QString result;
+    result.reserve(query.size());
+
+    auto isIdentifier = [](QChar symbol) {
+        return symbol.isLetterOrNumber() || symbol == '_' || symbol == ':' || symbol == '@' || symbol == '$';
+    };
+
+    for (int i = 0; i < query.size(); ++i) {
+        const QChar symbol = query[i];
+
+        if (symbol.isSpace()) {
+            while (i + 1 < query.size() && query[i + 1].isSpace()) {
+                ++i;
+            }
+
+            if (!result.isEmpty()) {
+                result += ' ';
+            }
+
+            continue;
+        }
+
+        // string literal, the '' sequence is escaped quote.
+        if (symbol == '\'') {
+            ++i;
+            while (i < query.size()) {
+                if (query[i] == '\'') {
+                    if (i + 1 < query.size() && query[i + 1] == '\'') {
+                        ++i;
+                    } else {
+                        break;
+                    }
+                }
+
+                ++i;
+            }
+
+            result += '?';
+            continue;
+        }
+
+        // numbers that are not part of the identifiers and placeholders (for example table1 or :value1).
+        if (symbol.isDigit() && (result.isEmpty() || !isIdentifier(result.back()))) {
+            while (i + 1 < query.size() && (query[i + 1].isLetterOrNumber() || query[i + 1] == '.')) {
+                ++i;
+            }
+
+            result += '?';
+            continue;
+        }
+
+        result += symbol;
+    }
+
+    if (result.endsWith(' ')) {
+        result.chop(1);
+    }
+
+    // multi-row inserts with different count of rows are the same statement.
+    static const QRegularExpression rows(R"((\([^()]*\))(?:, ?\1)+)");
+    result.replace(rows, "\\1, ...");
+
+    return result;
+}
+
+SqlStatistics::Entry &SqlStatistics::entry(const QString &query) {
+    auto cached = _normalized.constFind(query);
+    QString statement;
+    if (cached != _normalized.constEnd()) {
+        statement = cached.value();
+    } else {
+        // queries with inlined values are not repeated, so the cache is cleared time to time.
+        if (_normalized.size() >= DB_SQL_STATISTICS_SIZE) {
+            _normalized.clear();
+        }
+
+        statement = normalize(query);
+        _normalized.insert(query, statement);
+    }
+
+    auto item = _entries.find(statement);
+    if (item != _entries.end()) {
+        return item.value();
+    }
+
+    if (_entries.size() >= DB_SQL_STATISTICS_SIZE) {
+        return _entries["other statements"];
+    }
+
+    return _entries[statement];
+}
+
+int SqlStatistics::bucket(qint64 nsec) {
+    const double usec = nsec / 1000.0;
+    if (usec <= 1) {
+        return 0;
+    }
+
+    return std::min(BucketsCount - 1, static_cast<int>(std::ceil(std::log2(usec) * 4)));
+}
+
+}
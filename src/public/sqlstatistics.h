@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2025-2025 QuasarApp.
+ * Distributed under the lgplv3 software license, see the accompanying
+ * Everyone is permitted to copy and distribute verbatim copies
+ * of this license document, but changing it is not allowed.
+*/
+
+#ifndef SQLSTATISTICS_H
+#define SQLSTATISTICS_H
+
+#include "heart_global.h"
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <array>
+
+namespace QH {
+
+/**
+ * @brief The SqlStatementStats struct is statistics of the one sql statement.
+ * @see SqlStatistics
+ */
+struct HEARTSHARED_EXPORT SqlStatementStats {
+    /// normalized text of the statement (literals replaced by the "?" symbol).
+    QString statement;
+    /// count of executions.
+    quint64 count = 0;
+    /// total execution time in milliseconds.
+    double totalMsec = 0;
+    /// average execution time in milliseconds.
+    double avgMsec = 0;
+    /// 99 percentile of the execution time in milliseconds (approximate, the error is less then 20%).
+    double p99Msec = 0;
+    /// maximum execution time in milliseconds.
+    double maxMsec = 0;
+    /// count of the returned (select) or changed (insert, update, delete) rows.
+    quint64 rows = 0;
+};
+
+/**
+ * @brief The SqlStatistics class collects the execution time of the all sql statements of the writer.
+ *  Statements are grouped by the normalized text, so queries that differ only by literals or by count of rows of the multi-row insert are counted together.
+ *  The latency is saved into the histogram with fixed size, so recording costs a few operations and does not allocate memory for known statements.
+ *
+ * @note This class is thread safe.
+ * @see SqlDBWriter::statistics
+ */
+class HEARTSHARED_EXPORT SqlStatistics
+{
+public:
+    SqlStatistics();
+
+    /**
+     * @brief record This method adds the execution of the @a query.
+     * @param query This is text of the executed query.
+     * @param nsec This is execution time in nanoseconds.
+     * @param rows This is count of the changed rows. Use -1 if count is unknown (for example select query), see the addRows method.
+     */
+    void record(const QString& query, qint64 nsec, int rows = -1);
+
+    /**
+     * @brief addRows This method adds the @a rows to the statistics of the @a query. Use it for select queries after reading of the result.
+     * @param query This is text of the executed query.
+     * @param rows This is count of the returned rows.
+     */
+    void addRows(const QString& query, int rows);
+
+    /**
+     * @brief statistics This method return statistics of the all statements sorted by the total execution time.
+     * @return list of statistics.
+     */
+    QList<SqlStatementStats> statistics() const;
+
+    /**
+     * @brief reset This method removes all collected statistics.
+     */
+    void reset();
+
+    /**
+     * @brief normalize This method replaces all literals of the @a query by the "?" symbol, collapses whitespaces and repeated rows of the VALUES clause.
+     * @param query This is text of the query.
+     * @return normalized query.
+     */
+    static QString normalize(const QString& query);
+
+private:
+    // bucket i contains values up to 2^(i / 4) microseconds.
+    static constexpr int BucketsCount = 128;
+
+    struct Entry {
+        quint64 count = 0;
+        qint64 totalNsec = 0;
+        qint64 maxNsec = 0;
+        quint64 rows = 0;
+        std::array<quint32, BucketsCount> buckets{};
+    };
+
+    Entry& entry(const QString& query);
+    static int bucket(qint64 nsec);
+
+    mutable QMutex _mutex;
+    QHash<QString, Entry> _entries;
+    // cache of the normalized texts of the executed queries.
+    QHash<QString, QString> _normalized;
+};
+
+}
+#endif // SQLSTATISTICS_H